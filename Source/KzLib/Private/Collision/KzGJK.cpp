@@ -3,321 +3,875 @@
 #include "Collision/KzGJK.h"
 #include "Collision/KzHitResult.h"
 #include "Math/Geometry/KzShapeInstance.h"
+#include "Math/Geometry/KzShapeValue.h"
+#include "Math/Geometry/KzShapeWorldCache.h"
+#include "Math/Geometry/Shapes/CommonShapes.h"
 
 namespace Kz::GJK
 {
+	using Internal::FSupportVertex;
+	using Internal::FSimplex;
+
+	static FSupportVertex SupportVertex(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB, const FVector& Dir)
+	{
+		const FVector DirLocalA = qA.UnrotateVector(Dir);
+		const FVector DirLocalB = qB.UnrotateVector(-Dir);
+
+		const FVector sA = pA + qA.RotateVector(A.GetSupportPoint(DirLocalA));
+		const FVector sB = pB + qB.RotateVector(B.GetSupportPoint(DirLocalB));
+
+		return FSupportVertex{ sA - sB, sA, Dir };
+	}
+
+	static FVector Support(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB, const FVector& Dir)
+	{
+		return SupportVertex(A, pA, qA, B, pB, qB, Dir).W;
+	}
+
 	/**
-	 * Simplex for GJK.
-	 * NOTE: This does NOT use the classic GJK convention where the newest point
-	 * is stored at index 0. Here, points are kept in insertion order and the
-	 * newest support point is always Points[NumPoints - 1]. All update functions
-	 * are written to follow this ordering.
+	 * Generic GJK raycast (conservative advancement), for shapes without an analytic one.
+	 * SupportWorld(Dir) returns the farthest point of the shape along a world space direction, in world space.
 	 */
-	struct FSimplex
+	template <typename TSupport>
+	static bool RaycastSupport(FKzHitResult& OutHit, const FVector& RayOrigin, const FVector& RayDir, float MaxDistance, const FKzShapeInstance& Shape, const FVector& ShapePos, const FQuat& ShapeRot, TSupport&& SupportWorld)
 	{
-		/** Adds a new Minkowski support point to the simplex. */
-		void Add(const FVector& P)
+		OutHit.Reset(1.0f, false);
+		OutHit.TraceStart = RayOrigin;
+		OutHit.TraceEnd = RayOrigin + RayDir * MaxDistance;
+
+		// Start penetrating?
+		if (Shape.IntersectsPoint(ShapePos, ShapeRot, RayOrigin))
+		{
+			OutHit.bBlockingHit = true;
+			OutHit.bStartPenetrating = true;
+			OutHit.Location = RayOrigin;
+			OutHit.Normal = -RayDir;
+			OutHit.Time = 0.0f;
+			OutHit.Distance = 0.0f;
+			return true;
+		}
+
+		float t = 0.0f;
+		FVector Current = RayOrigin;
+
+		// Initial direction towards the shape
+		FVector Dir = ShapePos - Current;
+		if (Dir.IsNearlyZero())
 		{
-			check(NumPoints < 4);
-			Points[NumPoints++] = P;
+			Dir = -RayDir;
 		}
 
-		/** Dispatch to the appropriate simplex evolution function. */
-		bool Next(FVector& Direction)
+		FSimplex Simplex;
+
+		while (t <= MaxDistance)
 		{
-			switch (NumPoints)
+			// Minkowski support: shape - point(Current)
+			FVector SupportPoint = SupportWorld(-Dir) - Current;
+
+			float Dot = FVector::DotProduct(SupportPoint, Dir);
+			if (Dot < 0.0f)
+			{
+				return false; // miss
+			}
+
+			Simplex.Add(SupportPoint);
+
+			// GJK simplex evolution
+			if (Simplex.Next(Dir))
+			{
+				OutHit.bBlockingHit = true;
+				OutHit.bStartPenetrating = false;
+				OutHit.Time = t / MaxDistance;
+				OutHit.Distance = t;
+				OutHit.Location = Current;
+				OutHit.Normal = Dir.GetSafeNormal();
+				return true;
+			}
+
+			// Conservative advancement step
+			float Step = Dot / FVector::DotProduct(Dir, RayDir);
+			if (Step <= UE_KINDA_SMALL_NUMBER)
 			{
-				case 1: Direction = -Points[0]; return false;
-				case 2: return Line(Direction);
-				case 3: return Triangle(Direction);
-				case 4: return Tetrahedron(Direction);
+				return false;
 			}
 
-			check(false);
+			t += Step;
+			Current = RayOrigin + RayDir * t;
+		}
+
+		return false;
+	}
+
+	bool Raycast(FKzHitResult& OutHit, const FVector& RayOrigin, const FVector& RayDir, float MaxDistance, const FKzShapeInstance& Shape, const FVector& ShapePos, const FQuat& ShapeRot)
+	{
+		// First check if the shape implements a raycast function (should be way faster than GJK raycast).
+		if (Shape.ImplementsRaycast())
+		{
+			return Shape.Raycast(OutHit, ShapePos, ShapeRot, RayOrigin, RayDir, MaxDistance);
+		}
+
+		// Fallback to generic GJK raycast
+		return RaycastSupport(OutHit, RayOrigin, RayDir, MaxDistance, Shape, ShapePos, ShapeRot, [&](const FVector& Dir)
+		{
+			return ShapePos + ShapeRot.RotateVector(Shape.GetSupportPoint(ShapeRot.UnrotateVector(Dir)));
+		});
+	}
+
+	bool Raycast(FKzHitResult& OutHit, const FVector& RayOrigin, const FVector& RayDir, float MaxDistance, const FKzShapeWorldCache& Shape)
+	{
+		if (!Shape.RayIntersectsBounds(RayOrigin, RayDir, MaxDistance))
+		{
+			OutHit.Reset(1.0f, false);
+			OutHit.TraceStart = RayOrigin;
+			OutHit.TraceEnd = RayOrigin + RayDir * MaxDistance;
 			return false;
 		}
 
-	private:
-		/** Handles the 1D simplex (line segment).
-		 *  Returns false and updates direction to keep searching.
-		 */
-		bool Line(FVector& Direction)
+		if (Shape.Shape.ImplementsRaycast())
 		{
-			// a = newest point, b = previous point
-			const FVector& a = Points[1];
-			const FVector& b = Points[0];
+			return Shape.Shape.Raycast(OutHit, Shape.Position, Shape.Rotation, RayOrigin, RayDir, MaxDistance);
+		}
+
+		return RaycastSupport(OutHit, RayOrigin, RayDir, MaxDistance, Shape.Shape, Shape.Position, Shape.Rotation, [&](const FVector& Dir)
+		{
+			return Shape.GetSupportPoint(Dir);
+		});
+	}
 
-			const FVector ab = b - a;
-			const FVector ao = -a;
+	bool Raycast(FKzHitResult& OutHit, const FVector& RayOrigin, const FVector& RayDir, float MaxDistance, const FKzShapeValue& Shape, const FVector& ShapePos, const FQuat& ShapeRot)
+	{
+		// Every built-in shape implements an analytic raycast.
+		return Shape.Visit([&](const auto& Concrete)
+		{
+			return Concrete.Raycast(OutHit, ShapePos, ShapeRot, RayOrigin, RayDir, MaxDistance);
+		});
+	}
 
-			// If the origin lies beyond A in direction AB
-			if (FVector::DotProduct(ab, ao) > 0.0f)
+	/**
+	 * Generic boolean ray test: GJK between the shape and the ray segment, for shapes without an analytic test.
+	 * Long and infinite rays are cut past the far side of the shape bounds, which keeps the segment well conditioned.
+	 */
+	template <typename TSupport>
+	static bool RaycastTestSupport(const FVector& RayOrigin, const FVector& RayDir, float MaxDistance, const FBox& ShapeBounds, TSupport&& SupportWorld)
+	{
+		const double FarSide = FVector::Dist(RayOrigin, ShapeBounds.GetCenter()) + ShapeBounds.GetExtent().Size();
+		const double Length = MaxDistance > 0.0f ? FMath::Min<double>(MaxDistance, FarSide) : FarSide;
+		const FVector RayEnd = RayOrigin + RayDir * Length;
+
+		return Internal::Intersect([&](const FVector& Dir)
+		{
+			// Farthest point of the segment along -Dir.
+			return SupportWorld(Dir) - (FVector::DotProduct(Dir, RayDir) < 0.0 ? RayEnd : RayOrigin);
+		}, 20);
+	}
+
+	bool RaycastTest(const FVector& RayOrigin, const FVector& RayDir, float MaxDistance, const FKzShapeInstance& Shape, const FVector& ShapePos, const FQuat& ShapeRot)
+	{
+		if (Shape.ImplementsRaycast())
+		{
+			return Shape.RaycastTest(ShapePos, ShapeRot, RayOrigin, RayDir, MaxDistance);
+		}
+
+		if (!Shape.IsValid())
+		{
+			return false;
+		}
+
+		return RaycastTestSupport(RayOrigin, RayDir, MaxDistance, Shape.GetBoundingBox(ShapePos, ShapeRot), [&](const FVector& Dir)
+		{
+			return ShapePos + ShapeRot.RotateVector(Shape.GetSupportPoint(ShapeRot.UnrotateVector(Dir)));
+		});
+	}
+
+	bool RaycastTest(const FVector& RayOrigin, const FVector& RayDir, float MaxDistance, const FKzShapeWorldCache& Shape)
+	{
+		if (!Shape.RayIntersectsBounds(RayOrigin, RayDir, MaxDistance))
+		{
+			return false;
+		}
+
+		if (Shape.Shape.ImplementsRaycast())
+		{
+			return Shape.Shape.RaycastTest(Shape.Position, Shape.Rotation, RayOrigin, RayDir, MaxDistance);
+		}
+
+		return RaycastTestSupport(RayOrigin, RayDir, MaxDistance, Shape.Bounds, [&](const FVector& Dir)
+		{
+			return Shape.GetSupportPoint(Dir);
+		});
+	}
+
+	bool RaycastTest(const FVector& RayOrigin, const FVector& RayDir, float MaxDistance, const FKzShapeValue& Shape, const FVector& ShapePos, const FQuat& ShapeRot)
+	{
+		return Shape.Visit([&](const auto& Concrete)
+		{
+			return Concrete.RaycastTest(ShapePos, ShapeRot, RayOrigin, RayDir, MaxDistance);
+		});
+	}
+
+	/** Calls Func with the concrete type of the shape. Returns false for shape types without a compile-time path. */
+	template <typename TFunc>
+	static bool VisitConcreteShape(const FKzShapeInstance& Shape, TFunc&& Func)
+	{
+		const UScriptStruct* Type = Shape.GetScriptStruct();
+
+		if (Type == FKzSphere::StaticStruct())
+		{
+			Func(Shape.As<FKzSphere>());
+			return true;
+		}
+		if (Type == FKzBox::StaticStruct())
+		{
+			Func(Shape.As<FKzBox>());
+			return true;
+		}
+		if (Type == FKzCapsule::StaticStruct())
+		{
+			Func(Shape.As<FKzCapsule>());
+			return true;
+		}
+		if (Type == FKzCylinder::StaticStruct())
+		{
+			Func(Shape.As<FKzCylinder>());
+			return true;
+		}
+
+		return false;
+	}
+
+	/** Runs the devirtualized GJK for built-in shape pairs. Returns false if the pair must go through the generic path. */
+	static bool TryConcrete(bool& bOutIntersect, const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB, int32 MaxIterations)
+	{
+		bool bDispatched = false;
+
+		VisitConcreteShape(A, [&](const auto& ConcreteA)
+		{
+			bDispatched = VisitConcreteShape(B, [&](const auto& ConcreteB)
 			{
-				// New direction is perpendicular to AB towards the origin
-				Direction = FVector::CrossProduct(FVector::CrossProduct(ab, ao), ab);
+				bOutIntersect = Intersect(ConcreteA, pA, qA, ConcreteB, pB, qB, MaxIterations);
+			});
+		});
+
+		return bDispatched;
+	}
+
+	bool Intersect(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB, int32 MaxIterations)
+	{
+		// Built-in shape pairs run the devirtualized GJK.
+		bool bIntersect = false;
+		if (TryConcrete(bIntersect, A, pA, qA, B, pB, qB, MaxIterations))
+		{
+			return bIntersect;
+		}
+
+		// Early exit: Check whether ShapeA origin is inside ShapeB and viceversa.
+		if (A.IntersectsPoint(pA, qA, pB) || B.IntersectsPoint(pB, qB, pA))
+		{
+			return true;
+		}
+
+		return Internal::Intersect([&](const FVector& Dir) { return Support(A, pA, qA, B, pB, qB, Dir); }, MaxIterations);
+	}
+
+	bool Intersect(const FKzShapeValue& A, const FVector& pA, const FQuat& qA, const FKzShapeValue& B, const FVector& pB, const FQuat& qB, int32 MaxIterations)
+	{
+		return A.Visit([&](const auto& ConcreteA)
+		{
+			return B.Visit([&](const auto& ConcreteB)
+			{
+				return Intersect(ConcreteA, pA, qA, ConcreteB, pB, qB, MaxIterations);
+			});
+		});
+	}
+
+	bool Intersect(const FKzShapeWorldCache& A, const FKzShapeWorldCache& B, int32 MaxIterations)
+	{
+		if (!A.IntersectsBounds(B))
+		{
+			return false;
+		}
+
+		bool bIntersect = false;
+		if (TryConcrete(bIntersect, A.Shape, A.Position, A.Rotation, B.Shape, B.Position, B.Rotation, MaxIterations))
+		{
+			return bIntersect;
+		}
+
+		if (A.Shape.IntersectsPoint(A.Position, A.Rotation, B.Position) || B.Shape.IntersectsPoint(B.Position, B.Rotation, A.Position))
+		{
+			return true;
+		}
+
+		return Internal::Intersect([&](const FVector& Dir) { return A.GetSupportPoint(Dir) - B.GetSupportPoint(-Dir); }, MaxIterations);
+	}
+
+	/** Stores the simplex search directions in the cache, in the local frame of shape A. */
+	static void StoreSimplex(FSimplexCache& Cache, const FSimplex& Simplex, const FQuat& qA)
+	{
+		Cache.NumDirections = Simplex.Num();
+		for (int32 i = 0; i < Simplex.Num(); ++i)
+		{
+			Cache.Directions[i] = qA.UnrotateVector(Simplex[i].Dir);
+		}
+	}
+
+	/** Warm started GJK. Support(Dir) returns the FSupportVertex of A - B along a world space direction. */
+	template <typename TSupport>
+	static bool IntersectCached(const FQuat& qA, FSimplexCache& Cache, int32 MaxIterations, TSupport&& Support)
+	{
+		FVector Dir = qA.RotateVector(Cache.SeparatingAxis);
+
+		// Last call was separated: its axis usually still separates the shapes, which costs a single support evaluation.
+		FSupportVertex Vertex;
+		if (!Dir.IsNearlyZero())
+		{
+			Vertex = Support(Dir);
+			if (FVector::DotProduct(Vertex.W, Dir) < UE_KINDA_SMALL_NUMBER * Dir.Size())
+			{
+				return false;
+			}
+		}
+
+		// Rebuild the last simplex from its search directions, so it lands on the same features of both shapes.
+		FSimplex Simplex;
+		for (int32 i = 0; i < Cache.NumDirections; ++i)
+		{
+			Simplex.Add(Support(qA.RotateVector(Cache.Directions[i])));
+		}
+
+		if (Simplex.Num() == 0)
+		{
+			Simplex.Add(Dir.IsNearlyZero() ? Support(FVector::OneVector) : Vertex);
+		}
+
+		Cache.SeparatingAxis = FVector::ZeroVector;
+
+		// GJK driven by the distance sub-algorithm, which (unlike Next()) accepts any starting simplex.
+		FVector Closest;
+		for (int32 i = 0; i < MaxIterations; ++i)
+		{
+			// The origin lies inside or on the simplex: the shapes touch or overlap.
+			if (!Simplex.SolveClosestPoint(Closest) || Closest.IsNearlyZero(UE_KINDA_SMALL_NUMBER))
+			{
+				StoreSimplex(Cache, Simplex, qA);
+				return true;
 			}
-			else
+
+			Dir = -Closest;
+			Vertex = Support(Dir);
+
+			if (FVector::DotProduct(Vertex.W, Dir) < UE_KINDA_SMALL_NUMBER * Dir.Size())
 			{
-				// Drop B, keep only A
-				Points[0] = a;
-				NumPoints = 1;
-				Direction = ao;
+				StoreSimplex(Cache, Simplex, qA);
+				Cache.SeparatingAxis = qA.UnrotateVector(Dir);
+				return false; // No intersection
 			}
 
+			Simplex.Add(Vertex);
+		}
+
+		StoreSimplex(Cache, Simplex, qA);
+		return false;
+	}
+
+	bool Intersect(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB, FSimplexCache& Cache, int32 MaxIterations)
+	{
+		return IntersectCached(qA, Cache, MaxIterations, [&](const FVector& Dir) { return SupportVertex(A, pA, qA, B, pB, qB, Dir); });
+	}
+
+	bool Intersect(const FKzShapeWorldCache& A, const FKzShapeWorldCache& B, FSimplexCache& Cache, int32 MaxIterations)
+	{
+		if (!A.IntersectsBounds(B))
+		{
+			// Keep the warm start data: the pair may come back in range later.
 			return false;
 		}
 
-		/** Handles the 2D simplex (triangle). */
-		bool Triangle(FVector& Direction)
+		return IntersectCached(A.Rotation, Cache, MaxIterations, [&](const FVector& Dir)
 		{
-			// a = newest, then b, then c
-			const FVector& a = Points[2];
-			const FVector& b = Points[1];
-			const FVector& c = Points[0];
+			const FVector sA = A.GetSupportPoint(Dir);
+			return FSupportVertex{ sA - B.GetSupportPoint(-Dir), sA, Dir };
+		});
+	}
 
-			const FVector ab = b - a;
-			const FVector ac = c - a;
-			const FVector ao = -a;
+	namespace EPA
+	{
+		/** Polytope buffer sizes. EPA stops refining once either buffer is full. */
+		static constexpr int32 MaxVertices = 128;
+		static constexpr int32 MaxFaces = 256;
+		static constexpr int32 MaxHorizonEdges = 128;
 
-			const FVector abc = FVector::CrossProduct(ab, ac);
+		struct FFace
+		{
+			int32 Indices[3];
+			FVector Normal;
+			double Distance;
+		};
 
-			// Check if origin is outside AC
-			if (FVector::DotProduct(FVector::CrossProduct(abc, ac), ao) > 0.0f)
+		struct FEdge
+		{
+			int32 Indices[2];
+		};
+
+		/** Polytope expanded by EPA. Stored on the stack, so a query never allocates. */
+		struct FPolytope
+		{
+			/** Adds a face, wound so its normal points away from the polytope interior. Returns false if the buffer is full or the face is degenerate. */
+			bool AddFace(int32 I0, int32 I1, int32 I2)
 			{
-				if (FVector::DotProduct(ac, ao) > 0.0f)
+				if (NumFaces == MaxFaces)
 				{
-					// Reduce to line A-C
-					Points[0] = a;
-					Points[1] = c;
-					NumPoints = 2;
+					return false;
+				}
 
-					const FVector acDir = c - a;
-					Direction = FVector::CrossProduct(FVector::CrossProduct(acDir, ao), acDir);
+				const FVector& W0 = Vertices[I0].W;
+				FVector Normal = FVector::CrossProduct(Vertices[I1].W - W0, Vertices[I2].W - W0);
+
+				const double Length = Normal.Size();
+				if (Length < UE_DOUBLE_SMALL_NUMBER)
+				{
+					return false;
 				}
-				else
+				Normal /= Length;
+
+				// The interior point stays inside while the polytope grows, so it orients faces
+				// even when the origin lies on one of them.
+				if (FVector::DotProduct(Normal, W0 - Interior) < 0.0)
 				{
-					// Reduce to line A-B
-					Points[0] = a;
-					Points[1] = b;
-					NumPoints = 2;
-					return Line(Direction);
+					Swap(I1, I2);
+					Normal = -Normal;
 				}
+
+				Faces[NumFaces++] = FFace{ { I0, I1, I2 }, Normal, FVector::DotProduct(Normal, W0) };
+				return true;
 			}
-			else
+
+			int32 FindClosestFace() const
 			{
-				// Check if origin is outside AB
-				if (FVector::DotProduct(FVector::CrossProduct(ab, abc), ao) > 0.0f)
+				int32 Closest = 0;
+				for (int32 i = 1; i < NumFaces; ++i)
 				{
-					// Reduce to line A-B
-					Points[0] = a;
-					Points[1] = b;
-					NumPoints = 2;
-					return Line(Direction);
-				}
-				else
-				{
-					// Origin lies above or below the triangle
-					if (FVector::DotProduct(abc, ao) > 0.0f)
+					if (Faces[i].Distance < Faces[Closest].Distance)
 					{
-						// Above ABC
-						Direction = abc;
-					}
-					else
-					{
-						// Below ABC, flip winding
-						Points[0] = a;
-						Points[1] = c;
-						Points[2] = b;
-						Direction = -abc;
+						Closest = i;
 					}
 				}
+				return Closest;
 			}
 
-			return false;
-		}
+			FSupportVertex Vertices[MaxVertices];
+			FFace Faces[MaxFaces];
+			FVector Interior = FVector::ZeroVector;
+			int32 NumVertices = 0;
+			int32 NumFaces = 0;
+		};
 
-		/** Handles the 3D simplex (tetrahedron). */
-		bool Tetrahedron(FVector& Direction)
+		/**
+		 * Adds an edge of a removed face to the horizon.
+		 * Edges shared by two removed faces show up once in each winding and cancel out.
+		 */
+		static bool AddHorizonEdge(FEdge* Edges, int32& NumEdges, int32 I0, int32 I1)
 		{
-			// a = newest, then b, c, d
-			const FVector& a = Points[3];
-			const FVector& b = Points[2];
-			const FVector& c = Points[1];
-			const FVector& d = Points[0];
+			for (int32 i = 0; i < NumEdges; ++i)
+			{
+				if (Edges[i].Indices[0] == I1 && Edges[i].Indices[1] == I0)
+				{
+					Edges[i] = Edges[--NumEdges];
+					return true;
+				}
+			}
 
-			const FVector ao = -a;
+			if (NumEdges == MaxHorizonEdges)
+			{
+				return false;
+			}
 
-			const FVector ab = b - a;
-			const FVector ac = c - a;
-			const FVector ad = d - a;
+			Edges[NumEdges++] = FEdge{ { I0, I1 } };
+			return true;
+		}
 
-			const FVector abc = FVector::CrossProduct(ab, ac);
-			const FVector acd = FVector::CrossProduct(ac, ad);
-			const FVector adb = FVector::CrossProduct(ad, ab);
+		/**
+		 * Grows the GJK simplex into a tetrahedron when GJK stopped early because the origin lies on it.
+		 * Returns false if the Minkowski difference is flat.
+		 */
+		template <typename TSupportFunc>
+		static bool CompleteTetrahedron(FPolytope& Polytope, TSupportFunc&& SupportFunc)
+		{
+			FSupportVertex* Vertices = Polytope.Vertices;
 
-			// Check face ABC
-			if (FVector::DotProduct(abc, ao) > 0.0f)
+			auto TryAdd = [&](const FVector& Dir, auto&& IsValid)
 			{
-				Points[0] = a;
-				Points[1] = b;
-				Points[2] = c;
-				NumPoints = 3;
-				return Triangle(Direction);
+				const FSupportVertex Vertex = SupportFunc(Dir);
+				if (IsValid(Vertex.W))
+				{
+					Vertices[Polytope.NumVertices++] = Vertex;
+					return true;
+				}
+				return false;
+			};
+
+			if (Polytope.NumVertices == 1)
+			{
+				const FVector Axes[] = { FVector::XAxisVector, FVector::YAxisVector, FVector::ZAxisVector };
+				for (const FVector& Axis : Axes)
+				{
+					auto IsValid = [&](const FVector& W) { return !W.Equals(Vertices[0].W, UE_KINDA_SMALL_NUMBER); };
+					if (TryAdd(Axis, IsValid) || TryAdd(-Axis, IsValid))
+					{
+						break;
+					}
+				}
 			}
 
-			// Check face ACD
-			if (FVector::DotProduct(acd, ao) > 0.0f)
+			if (Polytope.NumVertices == 2)
 			{
-				Points[0] = a;
-				Points[1] = c;
-				Points[2] = d;
-				NumPoints = 3;
-				return Triangle(Direction);
+				const FVector Line = (Vertices[1].W - Vertices[0].W).GetSafeNormal();
+
+				FVector Perp1, Perp2;
+				Line.FindBestAxisVectors(Perp1, Perp2);
+
+				auto IsValid = [&](const FVector& W) { return FVector::CrossProduct(W - Vertices[0].W, Line).SizeSquared() > FMath::Square(UE_KINDA_SMALL_NUMBER); };
+				if (!TryAdd(Perp1, IsValid) && !TryAdd(-Perp1, IsValid) && !TryAdd(Perp2, IsValid))
+				{
+					TryAdd(-Perp2, IsValid);
+				}
 			}
 
-			// Check face ADB
-			if (FVector::DotProduct(adb, ao) > 0.0f)
+			if (Polytope.NumVertices == 3)
 			{
-				Points[0] = a;
-				Points[1] = d;
-				Points[2] = b;
-				NumPoints = 3;
-				return Triangle(Direction);
+				const FVector Normal = FVector::CrossProduct(Vertices[1].W - Vertices[0].W, Vertices[2].W - Vertices[0].W).GetSafeNormal();
+
+				auto IsValid = [&](const FVector& W) { return FMath::Abs(FVector::DotProduct(W - Vertices[0].W, Normal)) > UE_KINDA_SMALL_NUMBER; };
+				if (!TryAdd(Normal, IsValid))
+				{
+					TryAdd(-Normal, IsValid);
+				}
 			}
 
-			// Origin is inside the tetrahedron
-			return true;
+			return Polytope.NumVertices == 4;
 		}
 
-		FVector Points[4];
-		int32 NumPoints = 0;
-	};
+		/** Barycentric coordinates of P (lying on the triangle plane) with respect to triangle ABC. */
+		static FVector Barycentric(const FVector& P, const FVector& A, const FVector& B, const FVector& C)
+		{
+			const FVector AB = B - A;
+			const FVector AC = C - A;
+			const FVector AP = P - A;
+
+			const double D00 = FVector::DotProduct(AB, AB);
+			const double D01 = FVector::DotProduct(AB, AC);
+			const double D11 = FVector::DotProduct(AC, AC);
+			const double D20 = FVector::DotProduct(AP, AB);
+			const double D21 = FVector::DotProduct(AP, AC);
+
+			const double Denom = D00 * D11 - D01 * D01;
+			if (Denom < UE_DOUBLE_SMALL_NUMBER)
+			{
+				return FVector(1.0, 0.0, 0.0);
+			}
 
-	static FVector Support(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB, const FVector& Dir)
+			const double V = (D11 * D20 - D01 * D21) / Denom;
+			const double W = (D00 * D21 - D01 * D20) / Denom;
+			return FVector(1.0 - V - W, V, W);
+		}
+	}
+
+	bool Penetration(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB, FVector& OutNormal, float& OutDepth, FVector& OutContactA, FVector& OutContactB, int32 MaxIterations)
 	{
-		const FVector DirLocalA = qA.UnrotateVector(Dir);
-		const FVector DirLocalB = qB.UnrotateVector(-Dir);
+		auto Support = [&](const FVector& Dir) { return SupportVertex(A, pA, qA, B, pB, qB, Dir); };
 
-		const FVector sA = pA + qA.RotateVector(A.GetSupportPoint(DirLocalA));
-		const FVector sB = pB + qB.RotateVector(B.GetSupportPoint(DirLocalB));
+		// GJK, keeping the final simplex to seed EPA.
+		// Unlike Intersect() there is no point containment early-out, since EPA needs the simplex.
 
-		return sA - sB;
-	}
+		FVector Dir = FVector::OneVector;
 
-	bool Raycast(FKzHitResult& OutHit, const FVector& RayOrigin, const FVector& RayDir, float MaxDistance, const FKzShapeInstance& Shape, const FVector& ShapePos, const FQuat& ShapeRot)
-	{
-		// First check if the shape implements a raycast function (should be way faster than GJK raycast).
-		if (Shape.ImplementsRaycast())
+		FSupportVertex Vertex = Support(Dir);
+
+		FSimplex Simplex;
+		Simplex.Add(Vertex);
+
+		Dir = -Vertex.W;
+
+		bool bContainsOrigin = false;
+		for (int32 i = 0; i < MaxIterations; ++i)
 		{
-			return Shape.Raycast(OutHit, ShapePos, ShapeRot, RayOrigin, RayDir, MaxDistance);
+			// The origin lies on the simplex: the shapes are touching or the simplex is degenerate.
+			if (Dir.IsNearlyZero(UE_KINDA_SMALL_NUMBER))
+			{
+				bContainsOrigin = true;
+				break;
+			}
+
+			Vertex = Support(Dir);
+
+			if (FVector::DotProduct(Vertex.W, Dir) < UE_KINDA_SMALL_NUMBER * Dir.Size())
+			{
+				return false; // No intersection
+			}
+
+			Simplex.Add(Vertex);
+
+			if (Simplex.Next(Dir))
+			{
+				bContainsOrigin = true;
+				break;
+			}
 		}
 
-		// Fallback to generic GJK raycast
+		if (!bContainsOrigin)
+		{
+			return false;
+		}
 
-		OutHit.Reset(1.0f, false);
-		OutHit.TraceStart = RayOrigin;
-		OutHit.TraceEnd = RayOrigin + RayDir * MaxDistance;
+		// EPA: expand the polytope towards the face of the Minkowski difference closest to the origin.
 
-		// Start penetrating?
-		if (Shape.IntersectsPoint(ShapePos, ShapeRot, RayOrigin))
+		EPA::FPolytope Polytope;
+		for (int32 i = 0; i < Simplex.Num(); ++i)
 		{
-			OutHit.bBlockingHit = true;
-			OutHit.bStartPenetrating = true;
-			OutHit.Location = RayOrigin;
-			OutHit.Normal = -RayDir;
-			OutHit.Time = 0.0f;
-			OutHit.Distance = 0.0f;
-			return true;
+			Polytope.Vertices[Polytope.NumVertices++] = Simplex[i];
 		}
 
-		float t = 0.0f;
-		FVector Current = RayOrigin;
+		if (!EPA::CompleteTetrahedron(Polytope, Support))
+		{
+			return false;
+		}
 
-		// Initial direction towards the shape
-		FVector Dir = ShapePos - Current;
-		if (Dir.IsNearlyZero())
+		const FSupportVertex* Vertices = Polytope.Vertices;
+		Polytope.Interior = (Vertices[0].W + Vertices[1].W + Vertices[2].W + Vertices[3].W) * 0.25;
+
+		if (!Polytope.AddFace(0, 1, 2) || !Polytope.AddFace(0, 3, 1) || !Polytope.AddFace(0, 2, 3) || !Polytope.AddFace(1, 3, 2))
 		{
-			Dir = -RayDir;
+			return false;
 		}
 
-		FSimplex Simplex;
+		// Copied, since expanding the polytope invalidates face references.
+		EPA::FFace Closest = Polytope.Faces[Polytope.FindClosestFace()];
 
-		while (t <= MaxDistance)
+		for (int32 Iteration = 0; Iteration < MaxIterations; ++Iteration)
 		{
-			// Minkowski support: shape - point(Current)
-			FVector LocalDir = ShapeRot.UnrotateVector(-Dir);
-			FVector SupportS = ShapePos + ShapeRot.RotateVector(Shape.GetSupportPoint(LocalDir));
-			FVector SupportPoint = SupportS - Current;
+			Closest = Polytope.Faces[Polytope.FindClosestFace()];
 
-			float Dot = FVector::DotProduct(SupportPoint, Dir);
-			if (Dot < 0.0f)
+			Vertex = Support(Closest.Normal);
+
+			// Converged: the closest face lies on the boundary of the Minkowski difference.
+			if (FVector::DotProduct(Vertex.W, Closest.Normal) - Closest.Distance < UE_KINDA_SMALL_NUMBER || Polytope.NumVertices == EPA::MaxVertices)
 			{
-				return false; // miss
+				break;
 			}
 
-			Simplex.Add(SupportPoint);
+			const int32 NewIndex = Polytope.NumVertices++;
+			Polytope.Vertices[NewIndex] = Vertex;
 
-			// GJK simplex evolution
-			if (Simplex.Next(Dir))
+			// Remove every face the new vertex can see. The boundary of the removed region is the horizon.
+			EPA::FEdge Horizon[EPA::MaxHorizonEdges];
+			int32 NumHorizonEdges = 0;
+			bool bValid = true;
+
+			for (int32 FaceIndex = 0; FaceIndex < Polytope.NumFaces && bValid;)
 			{
-				OutHit.bBlockingHit = true;
-				OutHit.bStartPenetrating = false;
-				OutHit.Time = t / MaxDistance;
-				OutHit.Distance = t;
-				OutHit.Location = Current;
-				OutHit.Normal = Dir.GetSafeNormal();
-				return true;
+				const EPA::FFace& Face = Polytope.Faces[FaceIndex];
+				if (FVector::DotProduct(Face.Normal, Vertex.W - Vertices[Face.Indices[0]].W) > 0.0)
+				{
+					bValid = EPA::AddHorizonEdge(Horizon, NumHorizonEdges, Face.Indices[0], Face.Indices[1])
+						&& EPA::AddHorizonEdge(Horizon, NumHorizonEdges, Face.Indices[1], Face.Indices[2])
+						&& EPA::AddHorizonEdge(Horizon, NumHorizonEdges, Face.Indices[2], Face.Indices[0]);
+
+					Polytope.Faces[FaceIndex] = Polytope.Faces[--Polytope.NumFaces];
+				}
+				else
+				{
+					++FaceIndex;
+				}
 			}
 
-			// Conservative advancement step
-			float Step = Dot / FVector::DotProduct(Dir, RayDir);
-			if (Step <= UE_KINDA_SMALL_NUMBER)
+			// Stitch the horizon to the new vertex.
+			for (int32 EdgeIndex = 0; EdgeIndex < NumHorizonEdges && bValid; ++EdgeIndex)
 			{
-				return false;
+				bValid = Polytope.AddFace(Horizon[EdgeIndex].Indices[0], Horizon[EdgeIndex].Indices[1], NewIndex);
 			}
 
-			t += Step;
-			Current = RayOrigin + RayDir * t;
+			// Out of buffer space or numerically degenerate: keep the best face found so far.
+			if (!bValid)
+			{
+				break;
+			}
 		}
 
-		return false;
+		OutNormal = Closest.Normal;
+		OutDepth = (float)FMath::Max(Closest.Distance, 0.0);
+
+		// The closest point of the Minkowski difference to the origin maps back to the deepest points of both shapes.
+		const FVector ClosestPoint = Closest.Normal * Closest.Distance;
+		const FSupportVertex& V0 = Vertices[Closest.Indices[0]];
+		const FSupportVertex& V1 = Vertices[Closest.Indices[1]];
+		const FSupportVertex& V2 = Vertices[Closest.Indices[2]];
+
+		const FVector Weights = EPA::Barycentric(ClosestPoint, V0.W, V1.W, V2.W);
+		OutContactA = V0.A * Weights.X + V1.A * Weights.Y + V2.A * Weights.Z;
+		OutContactB = OutContactA - ClosestPoint;
+
+		return true;
 	}
 
-	bool Intersect(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB, int32 MaxIterations)
+	bool Distance(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB, float& OutDistance, FVector& OutPointA, FVector& OutPointB, FVector& OutNormal, float MaxDistance, int32 MaxIterations)
 	{
-		// Early exit: Check whether ShapeA origin is inside ShapeB and viceversa.
-		if (A.IntersectsPoint(pA, qA, pB) || B.IntersectsPoint(pB, qB, pA))
+		// Relative precision of the result. Curved shapes converge slowly, so this is kept modest.
+		constexpr double RelativeTolerance = 1.e-6;
+
+		FVector Dir = pB - pA;
+		if (Dir.IsNearlyZero())
 		{
+			Dir = FVector::OneVector;
+		}
+
+		FSimplex Simplex;
+		Simplex.Add(SupportVertex(A, pA, qA, B, pB, qB, Dir));
+
+		// Closest point of the Minkowski difference to the origin found so far.
+		FVector V;
+		Simplex.SolveClosestPoint(V);
+
+		bool bOverlap = false;
+		for (int32 i = 0; i < MaxIterations; ++i)
+		{
+			const double DistSq = V.SizeSquared();
+			if (DistSq <= FMath::Square(UE_KINDA_SMALL_NUMBER))
+			{
+				bOverlap = true;
+				break;
+			}
+
+			const FSupportVertex Vertex = SupportVertex(A, pA, qA, B, pB, qB, -V);
+			const double VdotW = FVector::DotProduct(V, Vertex.W);
+
+			// VdotW / |V| is a lower bound of the distance: far enough pairs are rejected without converging.
+			if (VdotW > 0.0 && FMath::Square(VdotW) > FMath::Square((double)MaxDistance) * DistSq)
+			{
+				return false;
+			}
+
+			// No progress towards the origin: V is the closest point.
+			if (DistSq - VdotW <= RelativeTolerance * DistSq)
+			{
+				break;
+			}
+
+			Simplex.Add(Vertex);
+
+			if (!Simplex.SolveClosestPoint(V))
+			{
+				bOverlap = true;
+				break;
+			}
+		}
+
+		OutPointA = Simplex.GetClosestPointOnA();
+
+		if (bOverlap)
+		{
+			// A point inside both shapes.
+			OutPointB = OutPointA;
+			OutNormal = FVector::ZeroVector;
+			OutDistance = 0.0f;
 			return true;
 		}
 
-		// This direction could be random.
-		FVector Dir = FVector::OneVector;
+		const double Dist = V.Size();
+		if (Dist > MaxDistance)
+		{
+			return false;
+		}
 
-		FVector SupportPoint = Support(A, pA, qA, B, pB, qB, Dir);
+		OutPointB = OutPointA - V;
+		OutNormal = -V / Dist;
+		OutDistance = (float)Dist;
+		return true;
+	}
 
-		FSimplex Simplex;
-		Simplex.Add(SupportPoint);
+	/** Radius of a sphere centered at the shape position that encloses the shape. */
+	static double BoundingRadius(const FKzShapeInstance& Shape)
+	{
+		const FBox Bounds = Shape.GetBoundingBox(FVector::ZeroVector, FQuat::Identity);
+		return FVector::Max(Bounds.Min.GetAbs(), Bounds.Max.GetAbs()).Size();
+	}
+
+	bool TimeOfImpact(const FKzShapeInstance& A, const FTransform& StartA, const FTransform& EndA, const FKzShapeInstance& B, const FTransform& StartB, const FTransform& EndB, float& OutTOI, FVector& OutNormal, float Tolerance, int32 MaxIterations)
+	{
+		const FVector pA0 = StartA.GetLocation();
+		const FVector pB0 = StartB.GetLocation();
+		const FQuat qA0 = StartA.GetRotation();
+		const FQuat qA1 = EndA.GetRotation();
+		const FQuat qB0 = StartB.GetRotation();
+		const FQuat qB1 = EndB.GetRotation();
 
-		Dir = -SupportPoint;
+		const FVector MotionA = EndA.GetLocation() - pA0;
+		const FVector MotionB = EndB.GetLocation() - pB0;
 
-		for (int32 i = MaxIterations; --i;)
+		// Over the whole motion no point of a shape travels farther than its rotation angle times its bounding radius, on top of the translation.
+		const double AngularBound = qA0.AngularDistance(qA1) * BoundingRadius(A) + qB0.AngularDistance(qB1) * BoundingRadius(B);
+
+		double t = 0.0;
+		FVector Normal = (pB0 - pA0).GetSafeNormal();
+
+		for (int32 i = 0; i < MaxIterations; ++i)
 		{
-			SupportPoint = Support(A, pA, qA, B, pB, qB, Dir);
+			const FVector pA = pA0 + MotionA * t;
+			const FVector pB = pB0 + MotionB * t;
+			const FQuat qA = FQuat::Slerp(qA0, qA1, t);
+			const FQuat qB = FQuat::Slerp(qB0, qB1, t);
+
+			float Dist = UE_BIG_NUMBER;
+			FVector PointA, PointB, StepNormal = FVector::ZeroVector;
+			if (!Distance(A, pA, qA, B, pB, qB, Dist, PointA, PointB, StepNormal))
+			{
+				// Rejected as out of range, the outputs are not set: no contact can be reported from this step.
+				return false;
+			}
 
-			if (FVector::DotProduct(SupportPoint, Dir) < UE_KINDA_SMALL_NUMBER)
+			if (Dist <= 0.0f && i == 0)
 			{
-				return false; // No intersection
+				// Overlapping from the start: report the separation direction.
+				float Depth;
+				FVector ContactA, ContactB;
+				if (Penetration(A, pA, qA, B, pB, qB, StepNormal, Depth, ContactA, ContactB))
+				{
+					Normal = StepNormal;
+				}
+
+				OutTOI = 0.0f;
+				OutNormal = Normal;
+				return true;
 			}
 
-			Simplex.Add(SupportPoint);
+			// Touching shapes have no separating direction, keep the one from the previous step.
+			if (Dist > 0.0f)
+			{
+				Normal = StepNormal;
+			}
 
-			if (Simplex.Next(Dir))
+			if (Dist <= Tolerance)
 			{
+				OutTOI = (float)t;
+				OutNormal = Normal;
 				return true;
 			}
+
+			// Upper bound of the rate at which the distance shrinks.
+			const double ClosingSpeed = FVector::DotProduct(MotionA - MotionB, Normal) + AngularBound;
+			if (ClosingSpeed <= UE_SMALL_NUMBER)
+			{
+				return false;
+			}
+
+			// Aim slightly short of contact, so the next step lands within the tolerance instead of exactly touching.
+			t += (Dist - 0.5 * Tolerance) / ClosingSpeed;
+			if (t > 1.0)
+			{
+				return false;
+			}
 		}
 
+		// Out of iterations without getting within the tolerance: the shapes were never seen touching.
 		return false;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,585 @@
+// Copyright 2026 kirzo
+
+#include "Collision/KzOverlap.h"
+#include "Collision/KzGJK.h"
+#include "Math/Geometry/KzGeometry.h"
+#include "Math/Geometry/KzShapeInstance.h"
+#include "Math/Geometry/KzShapeValue.h"
+#include "Math/Geometry/KzShapeWorldCache.h"
+#include "Math/Geometry/Shapes/CommonShapes.h"
+#include "Async/ParallelFor.h"
+
+namespace Kz::Overlap
+{
+	/** Squared distance between a point and the segment AB. */
+	static double PointSegmentDistSquared(const FVector& Point, const FVector& A, const FVector& B)
+	{
+		const FVector AB = B - A;
+		const double LenSq = AB.SizeSquared();
+		const double t = LenSq > UE_DOUBLE_SMALL_NUMBER ? FMath::Clamp(FVector::DotProduct(Point - A, AB) / LenSq, 0.0, 1.0) : 0.0;
+		return FVector::DistSquared(Point, A + AB * t);
+	}
+
+	/** Squared distance between the segments P1Q1 and P2Q2. */
+	static double SegmentSegmentDistSquared(const FVector& P1, const FVector& Q1, const FVector& P2, const FVector& Q2)
+	{
+		const FVector D1 = Q1 - P1;
+		const FVector D2 = Q2 - P2;
+		const FVector R = P1 - P2;
+
+		const double a = FVector::DotProduct(D1, D1);
+		const double e = FVector::DotProduct(D2, D2);
+		const double f = FVector::DotProduct(D2, R);
+
+		double s = 0.0;
+		double t = 0.0;
+
+		if (a <= UE_DOUBLE_SMALL_NUMBER && e <= UE_DOUBLE_SMALL_NUMBER)
+		{
+			// Both segments are points
+			return R.SizeSquared();
+		}
+
+		if (a <= UE_DOUBLE_SMALL_NUMBER)
+		{
+			// First segment is a point
+			t = FMath::Clamp(f / e, 0.0, 1.0);
+		}
+		else
+		{
+			const double c = FVector::DotProduct(D1, R);
+			if (e <= UE_DOUBLE_SMALL_NUMBER)
+			{
+				// Second segment is a point
+				s = FMath::Clamp(-c / a, 0.0, 1.0);
+			}
+			else
+			{
+				const double b = FVector::DotProduct(D1, D2);
+				const double Denom = a * e - b * b;
+
+				// Parallel segments pick an arbitrary s
+				s = Denom > UE_DOUBLE_SMALL_NUMBER ? FMath::Clamp((b * f - c * e) / Denom, 0.0, 1.0) : 0.0;
+				t = (b * s + f) / e;
+
+				if (t < 0.0)
+				{
+					t = 0.0;
+					s = FMath::Clamp(-c / a, 0.0, 1.0);
+				}
+				else if (t > 1.0)
+				{
+					t = 1.0;
+					s = FMath::Clamp((b - c) / a, 0.0, 1.0);
+				}
+			}
+		}
+
+		return FVector::DistSquared(P1 + D1 * s, P2 + D2 * t);
+	}
+
+	/** Half of the capsule spine, from its center to one of the hemisphere centers. */
+	static FVector CapsuleHalfSegment(const FQuat& Rotation, float Radius, float HalfHeight)
+	{
+		return Rotation.GetAxisZ() * FMath::Max(0.0f, HalfHeight - Radius);
+	}
+
+	bool SphereSphere(const FVector& CenterA, float RadiusA, const FVector& CenterB, float RadiusB)
+	{
+		return FVector::DistSquared(CenterA, CenterB) <= FMath::Square(RadiusA + RadiusB);
+	}
+
+	bool SphereCapsule(const FVector& SphereCenter, float SphereRadius, const FVector& CapsuleCenter, const FQuat& CapsuleRotation, float CapsuleRadius, float CapsuleHalfHeight)
+	{
+		const FVector HalfSegment = CapsuleHalfSegment(CapsuleRotation, CapsuleRadius, CapsuleHalfHeight);
+		return PointSegmentDistSquared(SphereCenter, CapsuleCenter - HalfSegment, CapsuleCenter + HalfSegment) <= FMath::Square(SphereRadius + CapsuleRadius);
+	}
+
+	bool CapsuleCapsule(const FVector& CenterA, const FQuat& RotationA, float RadiusA, float HalfHeightA, const FVector& CenterB, const FQuat& RotationB, float RadiusB, float HalfHeightB)
+	{
+		const FVector HalfSegmentA = CapsuleHalfSegment(RotationA, RadiusA, HalfHeightA);
+		const FVector HalfSegmentB = CapsuleHalfSegment(RotationB, RadiusB, HalfHeightB);
+		return SegmentSegmentDistSquared(CenterA - HalfSegmentA, CenterA + HalfSegmentA, CenterB - HalfSegmentB, CenterB + HalfSegmentB) <= FMath::Square(RadiusA + RadiusB);
+	}
+
+	bool SphereBox(const FVector& SphereCenter, float SphereRadius, const FVector& BoxCenter, const FQuat& BoxRotation, const FVector& BoxHalfSize)
+	{
+		const FVector Closest = Kz::Geom::ClosestPointOnBox(BoxCenter, BoxRotation, BoxHalfSize, SphereCenter);
+		return FVector::DistSquared(Closest, SphereCenter) <= FMath::Square(SphereRadius);
+	}
+
+	bool BoxBox(const FVector& CenterA, const FQuat& RotationA, const FVector& HalfSizeA, const FVector& CenterB, const FQuat& RotationB, const FVector& HalfSizeB)
+	{
+		const FVector AxesA[3] = { RotationA.GetAxisX(), RotationA.GetAxisY(), RotationA.GetAxisZ() };
+		const FVector AxesB[3] = { RotationB.GetAxisX(), RotationB.GetAxisY(), RotationB.GetAxisZ() };
+		const double a[3] = { HalfSizeA.X, HalfSizeA.Y, HalfSizeA.Z };
+		const double b[3] = { HalfSizeB.X, HalfSizeB.Y, HalfSizeB.Z };
+
+		// Rotation of B expressed in A's frame. The epsilon keeps near-parallel edge pairs from producing a null cross product axis.
+		double R[3][3];
+		double AbsR[3][3];
+		for (int32 i = 0; i < 3; ++i)
+		{
+			for (int32 j = 0; j < 3; ++j)
+			{
+				R[i][j] = FVector::DotProduct(AxesA[i], AxesB[j]);
+				AbsR[i][j] = FMath::Abs(R[i][j]) + UE_KINDA_SMALL_NUMBER;
+			}
+		}
+
+		// Translation expressed in A's frame
+		const FVector D = CenterB - CenterA;
+		const double T[3] = { FVector::DotProduct(D, AxesA[0]), FVector::DotProduct(D, AxesA[1]), FVector::DotProduct(D, AxesA[2]) };
+
+		// Axes of A
+		for (int32 i = 0; i < 3; ++i)
+		{
+			const double rb = b[0] * AbsR[i][0] + b[1] * AbsR[i][1] + b[2] * AbsR[i][2];
+			if (FMath::Abs(T[i]) > a[i] + rb)
+			{
+				return false;
+			}
+		}
+
+		// Axes of B
+		for (int32 j = 0; j < 3; ++j)
+		{
+			const double ra = a[0] * AbsR[0][j] + a[1] * AbsR[1][j] + a[2] * AbsR[2][j];
+			if (FMath::Abs(T[0] * R[0][j] + T[1] * R[1][j] + T[2] * R[2][j]) > ra + b[j])
+			{
+				return false;
+			}
+		}
+
+		// Cross products of the axes of A and B
+		for (int32 i = 0; i < 3; ++i)
+		{
+			const int32 i1 = (i + 1) % 3;
+			const int32 i2 = (i + 2) % 3;
+
+			for (int32 j = 0; j < 3; ++j)
+			{
+				const int32 j1 = (j + 1) % 3;
+				const int32 j2 = (j + 2) % 3;
+
+				const double ra = a[i1] * AbsR[i2][j] + a[i2] * AbsR[i1][j];
+				const double rb = b[j1] * AbsR[i][j2] + b[j2] * AbsR[i][j1];
+				if (FMath::Abs(T[i2] * R[i1][j] - T[i1] * R[i2][j]) > ra + rb)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// === Shape pair dispatch ===
+
+	static bool SphereSphereShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		return SphereSphere(pA, A.As<FKzSphere>().Radius, pB, B.As<FKzSphere>().Radius);
+	}
+
+	static bool SphereCapsuleShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		const FKzCapsule& Capsule = B.As<FKzCapsule>();
+		return SphereCapsule(pA, A.As<FKzSphere>().Radius, pB, qB, Capsule.Radius, Capsule.HalfHeight);
+	}
+
+	static bool CapsuleCapsuleShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		const FKzCapsule& CapsuleA = A.As<FKzCapsule>();
+		const FKzCapsule& CapsuleB = B.As<FKzCapsule>();
+		return CapsuleCapsule(pA, qA, CapsuleA.Radius, CapsuleA.HalfHeight, pB, qB, CapsuleB.Radius, CapsuleB.HalfHeight);
+	}
+
+	static bool SphereBoxShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		return SphereBox(pA, A.As<FKzSphere>().Radius, pB, qB, B.As<FKzBox>().HalfSize);
+	}
+
+	static bool BoxBoxShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		return BoxBox(pA, qA, A.As<FKzBox>().HalfSize, pB, qB, B.As<FKzBox>().HalfSize);
+	}
+
+	static bool MeshShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		return A.As<FKzTriangleMesh>().IntersectsShape(B, pB, qB, pA, qA);
+	}
+
+	static bool HeightfieldShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		return A.As<FKzHeightfield>().IntersectsShape(B, pB, qB, pA, qA);
+	}
+
+	/** Walks the triangles of A under the bounds of B and tests each of them against the triangles of B. */
+	template <typename TSurfaceA, typename TSurfaceB>
+	static bool SurfaceSurfaceShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		const TSurfaceA& SurfaceA = A.As<TSurfaceA>();
+		const TSurfaceB& SurfaceB = B.As<TSurfaceB>();
+
+		// Bounds of B relative to A.
+		const FBox LocalBounds = SurfaceB.GetBoundingBox(qA.UnrotateVector(pB - pA), qA.Inverse() * qB);
+
+		bool bIntersects = false;
+		SurfaceA.ForEachTriangle(LocalBounds, [&](const FVector& V0, const FVector& V1, const FVector& V2)
+		{
+			bIntersects = SurfaceB.IntersectsTriangle(pA + qA.RotateVector(V0), pA + qA.RotateVector(V1), pA + qA.RotateVector(V2), pB, qB);
+			return !bIntersects;
+		});
+
+		return bIntersects;
+	}
+
+	static bool CompoundShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		return A.As<FKzCompoundShape>().IntersectsShape(B, pB, qB, pA, qA);
+	}
+
+	struct FOverlapEntry
+	{
+		FOverlapFunc Func;
+
+		/** True if the entry was registered for the reversed pair, so the shapes must be swapped. */
+		bool bSwapped;
+	};
+
+	using FOverlapKey = TPair<const UScriptStruct*, const UScriptStruct*>;
+
+	static void AddOverlap(TMap<FOverlapKey, FOverlapEntry>& Table, const UScriptStruct* TypeA, const UScriptStruct* TypeB, FOverlapFunc Func)
+	{
+		Table.Add(FOverlapKey(TypeA, TypeB), FOverlapEntry{ Func, false });
+		if (TypeA != TypeB)
+		{
+			Table.Add(FOverlapKey(TypeB, TypeA), FOverlapEntry{ Func, true });
+		}
+	}
+
+	/** Dispatch matrix, keyed on the concrete shape types of both shapes. */
+	static TMap<FOverlapKey, FOverlapEntry>& GetOverlapTable()
+	{
+		static TMap<FOverlapKey, FOverlapEntry> Table = []()
+		{
+			TMap<FOverlapKey, FOverlapEntry> BuiltIn;
+			AddOverlap(BuiltIn, FKzSphere::StaticStruct(), FKzSphere::StaticStruct(), &SphereSphereShapes);
+			AddOverlap(BuiltIn, FKzSphere::StaticStruct(), FKzCapsule::StaticStruct(), &SphereCapsuleShapes);
+			AddOverlap(BuiltIn, FKzCapsule::StaticStruct(), FKzCapsule::StaticStruct(), &CapsuleCapsuleShapes);
+			AddOverlap(BuiltIn, FKzSphere::StaticStruct(), FKzBox::StaticStruct(), &SphereBoxShapes);
+			AddOverlap(BuiltIn, FKzBox::StaticStruct(), FKzBox::StaticStruct(), &BoxBoxShapes);
+			AddOverlap(BuiltIn, FKzTriangleMesh::StaticStruct(), FKzSphere::StaticStruct(), &MeshShapes);
+			AddOverlap(BuiltIn, FKzTriangleMesh::StaticStruct(), FKzBox::StaticStruct(), &MeshShapes);
+			AddOverlap(BuiltIn, FKzTriangleMesh::StaticStruct(), FKzCapsule::StaticStruct(), &MeshShapes);
+			AddOverlap(BuiltIn, FKzTriangleMesh::StaticStruct(), FKzCylinder::StaticStruct(), &MeshShapes);
+			AddOverlap(BuiltIn, FKzTriangleMesh::StaticStruct(), FKzConvex::StaticStruct(), &MeshShapes);
+			AddOverlap(BuiltIn, FKzHeightfield::StaticStruct(), FKzSphere::StaticStruct(), &HeightfieldShapes);
+			AddOverlap(BuiltIn, FKzHeightfield::StaticStruct(), FKzBox::StaticStruct(), &HeightfieldShapes);
+			AddOverlap(BuiltIn, FKzHeightfield::StaticStruct(), FKzCapsule::StaticStruct(), &HeightfieldShapes);
+			AddOverlap(BuiltIn, FKzHeightfield::StaticStruct(), FKzCylinder::StaticStruct(), &HeightfieldShapes);
+			AddOverlap(BuiltIn, FKzHeightfield::StaticStruct(), FKzConvex::StaticStruct(), &HeightfieldShapes);
+			AddOverlap(BuiltIn, FKzTriangleMesh::StaticStruct(), FKzTriangleMesh::StaticStruct(), &SurfaceSurfaceShapes<FKzTriangleMesh, FKzTriangleMesh>);
+			AddOverlap(BuiltIn, FKzTriangleMesh::StaticStruct(), FKzHeightfield::StaticStruct(), &SurfaceSurfaceShapes<FKzTriangleMesh, FKzHeightfield>);
+			AddOverlap(BuiltIn, FKzHeightfield::StaticStruct(), FKzHeightfield::StaticStruct(), &SurfaceSurfaceShapes<FKzHeightfield, FKzHeightfield>);
+
+			// Compounds defer every child to the table, so they pair with any shape, including other compounds.
+			for (const UScriptStruct* Type : { FKzSphere::StaticStruct(), FKzBox::StaticStruct(), FKzCapsule::StaticStruct(), FKzCylinder::StaticStruct(),
+				FKzConvex::StaticStruct(), FKzTriangleMesh::StaticStruct(), FKzHeightfield::StaticStruct(), FKzCompoundShape::StaticStruct() })
+			{
+				AddOverlap(BuiltIn, FKzCompoundShape::StaticStruct(), Type, &CompoundShapes);
+			}
+			return BuiltIn;
+		}();
+		return Table;
+	}
+
+	void RegisterOverlap(const UScriptStruct* TypeA, const UScriptStruct* TypeB, FOverlapFunc Func)
+	{
+		check(TypeA && TypeB && Func);
+		AddOverlap(GetOverlapTable(), TypeA, TypeB, Func);
+	}
+
+	bool HasOverlap(const UScriptStruct* TypeA, const UScriptStruct* TypeB)
+	{
+		return GetOverlapTable().Contains(FOverlapKey(TypeA, TypeB));
+	}
+
+	/** Runs the analytic test of the pair if there is one. Returns false if the pair must go through GJK. */
+	static bool TryAnalytic(bool& bOutIntersect, const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		const FOverlapEntry* Entry = GetOverlapTable().Find(FOverlapKey(A.GetScriptStruct(), B.GetScriptStruct()));
+		if (!Entry)
+		{
+			return false;
+		}
+
+		bOutIntersect = Entry->bSwapped ? Entry->Func(B, pB, qB, A, pA, qA) : Entry->Func(A, pA, qA, B, pB, qB);
+		return true;
+	}
+
+	bool Intersect(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		bool bIntersect;
+		if (TryAnalytic(bIntersect, A, pA, qA, B, pB, qB))
+		{
+			return bIntersect;
+		}
+
+		return Kz::GJK::Intersect(A, pA, qA, B, pB, qB);
+	}
+
+	bool Intersect(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB, Kz::GJK::FSimplexCache& Cache)
+	{
+		bool bIntersect;
+		if (TryAnalytic(bIntersect, A, pA, qA, B, pB, qB))
+		{
+			return bIntersect;
+		}
+
+		return Kz::GJK::Intersect(A, pA, qA, B, pB, qB, Cache);
+	}
+
+	bool Intersect(const FKzShapeWorldCache& A, const FKzShapeWorldCache& B)
+	{
+		if (!A.IntersectsBounds(B))
+		{
+			return false;
+		}
+
+		bool bIntersect;
+		if (TryAnalytic(bIntersect, A.Shape, A.Position, A.Rotation, B.Shape, B.Position, B.Rotation))
+		{
+			return bIntersect;
+		}
+
+		return Kz::GJK::Intersect(A, B);
+	}
+
+	bool Intersect(const FKzShapeWorldCache& A, const FKzShapeWorldCache& B, Kz::GJK::FSimplexCache& Cache)
+	{
+		if (!A.IntersectsBounds(B))
+		{
+			return false;
+		}
+
+		bool bIntersect;
+		if (TryAnalytic(bIntersect, A.Shape, A.Position, A.Rotation, B.Shape, B.Position, B.Rotation))
+		{
+			return bIntersect;
+		}
+
+		return Kz::GJK::Intersect(A, B, Cache);
+	}
+
+	bool Intersect(const FKzShapeValue& A, const FVector& pA, const FQuat& qA, const FKzShapeValue& B, const FVector& pB, const FQuat& qB)
+	{
+		using EType = EKzShapeValueType;
+
+		switch (A.GetType())
+		{
+		case EType::Sphere:
+			switch (B.GetType())
+			{
+			case EType::Sphere:  return SphereSphere(pA, A.GetRadius(), pB, B.GetRadius());
+			case EType::Capsule: return SphereCapsule(pA, A.GetRadius(), pB, qB, B.GetRadius(), B.GetHalfHeight());
+			case EType::Box:     return SphereBox(pA, A.GetRadius(), pB, qB, B.GetHalfSize());
+			default: break;
+			}
+			break;
+
+		case EType::Capsule:
+			switch (B.GetType())
+			{
+			case EType::Sphere:  return SphereCapsule(pB, B.GetRadius(), pA, qA, A.GetRadius(), A.GetHalfHeight());
+			case EType::Capsule: return CapsuleCapsule(pA, qA, A.GetRadius(), A.GetHalfHeight(), pB, qB, B.GetRadius(), B.GetHalfHeight());
+			default: break;
+			}
+			break;
+
+		case EType::Box:
+			switch (B.GetType())
+			{
+			case EType::Sphere: return SphereBox(pB, B.GetRadius(), pA, qA, A.GetHalfSize());
+			case EType::Box:    return BoxBox(pA, qA, A.GetHalfSize(), pB, qB, B.GetHalfSize());
+			default: break;
+			}
+			break;
+
+		default:
+			break;
+		}
+
+		return Kz::GJK::Intersect(A, pA, qA, B, pB, qB);
+	}
+
+	bool Intersect(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeValue& B, const FVector& pB, const FQuat& qB)
+	{
+		FKzShapeValue ValueA;
+		if (FKzShapeValue::TryFrom(A, ValueA))
+		{
+			return Intersect(ValueA, pA, qA, B, pB, qB);
+		}
+
+		// Shapes the value cannot hold need the pair table (eg. meshes and compounds).
+		return Intersect(A, pA, qA, B.ToInstance(), pB, qB);
+	}
+
+	// === Batched pairs ===
+
+	/** Number of pairs processed by each batch task. A multiple of 32, so tasks never write to the same word of the result bitset. */
+	static constexpr int32 BatchChunkSize = 256;
+
+	template <typename ShapeTypeA, typename ShapeTypeB>
+	static bool GJKShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		return Kz::GJK::Intersect(A.As<ShapeTypeA>(), pA, qA, B.As<ShapeTypeB>(), pB, qB);
+	}
+
+	static bool GJKGenericShapes(const FKzShapeInstance& A, const FVector& pA, const FQuat& qA, const FKzShapeInstance& B, const FVector& pB, const FQuat& qB)
+	{
+		return Kz::GJK::Intersect(A, pA, qA, B, pB, qB);
+	}
+
+	template <typename ShapeTypeA>
+	static FOverlapFunc FindGJKKernel(const UScriptStruct* TypeB)
+	{
+		if (TypeB == FKzSphere::StaticStruct()) return &GJKShapes<ShapeTypeA, FKzSphere>;
+		if (TypeB == FKzBox::StaticStruct()) return &GJKShapes<ShapeTypeA, FKzBox>;
+		if (TypeB == FKzCapsule::StaticStruct()) return &GJKShapes<ShapeTypeA, FKzCapsule>;
+		if (TypeB == FKzCylinder::StaticStruct()) return &GJKShapes<ShapeTypeA, FKzCylinder>;
+		return &GJKGenericShapes;
+	}
+
+	/** Returns the kernel a shape type pair goes through: its analytic test, or GJK devirtualized for the built-in shapes. */
+	static FOverlapEntry FindKernel(const UScriptStruct* TypeA, const UScriptStruct* TypeB)
+	{
+		if (const FOverlapEntry* Entry = GetOverlapTable().Find(FOverlapKey(TypeA, TypeB)))
+		{
+			return *Entry;
+		}
+
+		if (TypeA == FKzSphere::StaticStruct()) return FOverlapEntry{ FindGJKKernel<FKzSphere>(TypeB), false };
+		if (TypeA == FKzBox::StaticStruct()) return FOverlapEntry{ FindGJKKernel<FKzBox>(TypeB), false };
+		if (TypeA == FKzCapsule::StaticStruct()) return FOverlapEntry{ FindGJKKernel<FKzCapsule>(TypeB), false };
+		if (TypeA == FKzCylinder::StaticStruct()) return FOverlapEntry{ FindGJKKernel<FKzCylinder>(TypeB), false };
+		return FOverlapEntry{ &GJKGenericShapes, false };
+	}
+
+	int32 IntersectBatch(TBitArray<>& OutResults,
+						 TConstArrayView<const FKzShapeInstance*> ShapesA, TConstArrayView<FVector> PositionsA, TConstArrayView<FQuat> RotationsA,
+						 TConstArrayView<const FKzShapeInstance*> ShapesB, TConstArrayView<FVector> PositionsB, TConstArrayView<FQuat> RotationsB)
+	{
+		const int32 NumPairs = ShapesA.Num();
+		check(PositionsA.Num() == NumPairs && RotationsA.Num() == NumPairs);
+		check(ShapesB.Num() == NumPairs && PositionsB.Num() == NumPairs && RotationsB.Num() == NumPairs);
+
+		OutResults.Init(false, NumPairs);
+
+		struct FGroup
+		{
+			const UScriptStruct* TypeA;
+			const UScriptStruct* TypeB;
+			FOverlapEntry Kernel;
+		};
+
+		// Resolve the type combination of every pair, and the kernel of every combination once.
+		// There are only a handful of combinations, so a linear search is enough. Pairs with a missing shape never overlap.
+		TArray<FGroup, TInlineAllocator<16>> Groups;
+		TArray<int32> PairGroups;
+		PairGroups.SetNumUninitialized(NumPairs);
+
+		int32 LastGroup = INDEX_NONE;
+		for (int32 i = 0; i < NumPairs; ++i)
+		{
+			if (!ShapesA[i] || !ShapesA[i]->IsValid() || !ShapesB[i] || !ShapesB[i]->IsValid())
+			{
+				PairGroups[i] = INDEX_NONE;
+				continue;
+			}
+
+			const UScriptStruct* TypeA = ShapesA[i]->GetScriptStruct();
+			const UScriptStruct* TypeB = ShapesB[i]->GetScriptStruct();
+			if (LastGroup == INDEX_NONE || Groups[LastGroup].TypeA != TypeA || Groups[LastGroup].TypeB != TypeB)
+			{
+				LastGroup = Groups.IndexOfByPredicate([&](const FGroup& Group) { return Group.TypeA == TypeA && Group.TypeB == TypeB; });
+				if (LastGroup == INDEX_NONE)
+				{
+					LastGroup = Groups.Add(FGroup{ TypeA, TypeB, FindKernel(TypeA, TypeB) });
+				}
+			}
+
+			PairGroups[i] = LastGroup;
+		}
+
+		const int32 NumGroups = Groups.Num();
+		const int32 NumChunks = FMath::DivideAndRoundUp(NumPairs, BatchChunkSize);
+
+		TArray<int32> ChunkOverlaps;
+		ChunkOverlaps.SetNumZeroed(NumChunks);
+
+		// Chunks keep the pairs in memory order; inside a chunk the pairs are bucketed by group (counting sort),
+		// so consecutive calls go through the same kernel.
+		ParallelFor(NumChunks, [&](int32 ChunkIndex)
+		{
+			const int32 First = ChunkIndex * BatchChunkSize;
+			const int32 Last = FMath::Min(First + BatchChunkSize, NumPairs);
+
+			TArray<int32, TInlineAllocator<16>> GroupStarts;
+			GroupStarts.SetNumZeroed(NumGroups + 1);
+			for (int32 i = First; i < Last; ++i)
+			{
+				if (PairGroups[i] != INDEX_NONE)
+				{
+					++GroupStarts[PairGroups[i] + 1];
+				}
+			}
+
+			for (int32 g = 0; g < NumGroups; ++g)
+			{
+				GroupStarts[g + 1] += GroupStarts[g];
+			}
+
+			int32 Order[BatchChunkSize];
+			{
+				TArray<int32, TInlineAllocator<16>> Cursors(GroupStarts.GetData(), NumGroups);
+				for (int32 i = First; i < Last; ++i)
+				{
+					if (PairGroups[i] != INDEX_NONE)
+					{
+						Order[Cursors[PairGroups[i]]++] = i;
+					}
+				}
+			}
+
+			int32 NumChunkOverlaps = 0;
+			for (int32 g = 0; g < NumGroups; ++g)
+			{
+				const FOverlapEntry Kernel = Groups[g].Kernel;
+				for (int32 k = GroupStarts[g]; k < GroupStarts[g + 1]; ++k)
+				{
+					const int32 i = Order[k];
+					const bool bOverlap = Kernel.bSwapped
+						? Kernel.Func(*ShapesB[i], PositionsB[i], RotationsB[i], *ShapesA[i], PositionsA[i], RotationsA[i])
+						: Kernel.Func(*ShapesA[i], PositionsA[i], RotationsA[i], *ShapesB[i], PositionsB[i], RotationsB[i]);
+
+					if (bOverlap)
+					{
+						OutResults[i] = true;
+						++NumChunkOverlaps;
+					}
+				}
+			}
+
+			ChunkOverlaps[ChunkIndex] = NumChunkOverlaps;
+		});
+
+		int32 NumOverlaps = 0;
+		for (const int32 Count : ChunkOverlaps)
+		{
+			NumOverlaps += Count;
+		}
+
+		return NumOverlaps;
+	}
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Collision/KzRaycast.h"
 #include "Collision/KzHitResult.h"
+#include "Math/VectorRegister.h"
 
 namespace Kz::Raycast
 {
@@ -381,4 +382,533 @@ namespace Kz::Raycast
 
 		return true;
 	}
+
+	bool Sphere(const FVector& Center, float Radius, const FVector& RayStart, const FVector& RayDir, float MaxDistance)
+	{
+		const FVector m = RayStart - Center;
+		const double c = m.SizeSquared() - FMath::Square(Radius);
+		if (c <= 0.0)
+		{
+			return true; // Starts inside.
+		}
+
+		const double b = FVector::DotProduct(m, RayDir);
+		if (b > 0.0)
+		{
+			return false; // Outside and pointing away.
+		}
+
+		const double Disc = b * b - c;
+		if (Disc < 0.0)
+		{
+			return false;
+		}
+
+		return MaxDistance <= 0.0f || -b - FMath::Sqrt(Disc) <= MaxDistance;
+	}
+
+	bool Box(const FVector& Center, const FQuat& Rotation, const FVector& Extents, const FVector& RayStart, const FVector& RayDir, float MaxDistance)
+	{
+		const FVector O = Rotation.UnrotateVector(RayStart - Center);
+		const FVector D = Rotation.UnrotateVector(RayDir);
+
+		double tmin = 0.0;
+		double tmax = MaxDistance > 0.0f ? MaxDistance : UE_BIG_NUMBER;
+
+		for (int32 i = 0; i < 3; ++i)
+		{
+			if (FMath::Abs(D[i]) < 1e-6)
+			{
+				if (O[i] < -Extents[i] || O[i] > Extents[i])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const double InvD = 1.0 / D[i];
+			double t1 = (-Extents[i] - O[i]) * InvD;
+			double t2 = (Extents[i] - O[i]) * InvD;
+			if (t1 > t2) Swap(t1, t2);
+
+			tmin = FMath::Max(tmin, t1);
+			tmax = FMath::Min(tmax, t2);
+			if (tmin > tmax)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool Capsule(const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight, const FVector& RayStart, const FVector& RayDir, float MaxDistance)
+	{
+		// The ray touches the capsule if it passes within Radius of the capsule segment.
+		const FVector Axis = Rotation.RotateVector(FVector(0.0, 0.0, FMath::Max(0.0f, HalfHeight - Radius)));
+		const FVector A = Center - Axis;
+		const FVector AB = Axis * 2.0;
+		const double Length = MaxDistance > 0.0f ? MaxDistance : UE_BIG_NUMBER;
+
+		// Closest points between the capsule segment A + s * AB and the ray RayStart + t * RayDir, t in [0, Length].
+		const FVector R = A - RayStart;
+		const double a = AB.SizeSquared();
+		const double b = FVector::DotProduct(AB, RayDir);
+		const double c = FVector::DotProduct(AB, R);
+		const double f = FVector::DotProduct(RayDir, R);
+		const double Denom = a - b * b;
+
+		double s = (a > UE_DOUBLE_SMALL_NUMBER && Denom > UE_DOUBLE_SMALL_NUMBER) ? FMath::Clamp((b * f - c) / Denom, 0.0, 1.0) : 0.0;
+		double t = FMath::Clamp(b * s + f, 0.0, Length);
+		if (a > UE_DOUBLE_SMALL_NUMBER)
+		{
+			s = FMath::Clamp((b * t - c) / a, 0.0, 1.0);
+		}
+
+		return FVector::DistSquared(A + AB * s, RayStart + RayDir * t) <= FMath::Square(Radius);
+	}
+
+	bool Cylinder(const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight, const FVector& RayStart, const FVector& RayDir, float MaxDistance)
+	{
+		const FVector O = Rotation.UnrotateVector(RayStart - Center);
+		const FVector D = Rotation.UnrotateVector(RayDir);
+
+		double tmin = 0.0;
+		double tmax = MaxDistance > 0.0f ? MaxDistance : UE_BIG_NUMBER;
+
+		// Slab between the caps.
+		if (FMath::Abs(D.Z) < 1e-6)
+		{
+			if (O.Z < -HalfHeight || O.Z > HalfHeight)
+			{
+				return false;
+			}
+		}
+		else
+		{
+			double t1 = (-HalfHeight - O.Z) / D.Z;
+			double t2 = (HalfHeight - O.Z) / D.Z;
+			if (t1 > t2) Swap(t1, t2);
+
+			tmin = FMath::Max(tmin, t1);
+			tmax = FMath::Min(tmax, t2);
+			if (tmin > tmax)
+			{
+				return false;
+			}
+		}
+
+		// Infinite cylinder around the local Z axis.
+		const double a = D.X * D.X + D.Y * D.Y;
+		const double b = O.X * D.X + O.Y * D.Y;
+		const double c = O.X * O.X + O.Y * O.Y - FMath::Square(Radius);
+		if (a < 1e-12)
+		{
+			return c <= 0.0;
+		}
+
+		const double Disc = b * b - a * c;
+		if (Disc < 0.0)
+		{
+			return false;
+		}
+
+		const double SqrtDisc = FMath::Sqrt(Disc);
+		return FMath::Max(tmin, (-b - SqrtDisc) / a) <= FMath::Min(tmax, (-b + SqrtDisc) / a);
+	}
+
+	namespace
+	{
+		constexpr int32 LaneCount = 4;
+
+		/** Four vectors in SoA form, one register per component. */
+		struct FLaneVector
+		{
+			VectorRegister4Float X;
+			VectorRegister4Float Y;
+			VectorRegister4Float Z;
+		};
+
+		FORCEINLINE FLaneVector Broadcast(const FVector& V)
+		{
+			return { VectorSetFloat1((float)V.X), VectorSetFloat1((float)V.Y), VectorSetFloat1((float)V.Z) };
+		}
+
+		FORCEINLINE FLaneVector Add(const FLaneVector& A, const FLaneVector& B)
+		{
+			return { VectorAdd(A.X, B.X), VectorAdd(A.Y, B.Y), VectorAdd(A.Z, B.Z) };
+		}
+
+		FORCEINLINE FLaneVector Sub(const FLaneVector& A, const FLaneVector& B)
+		{
+			return { VectorSubtract(A.X, B.X), VectorSubtract(A.Y, B.Y), VectorSubtract(A.Z, B.Z) };
+		}
+
+		FORCEINLINE FLaneVector Scale(const FLaneVector& A, const VectorRegister4Float& S)
+		{
+			return { VectorMultiply(A.X, S), VectorMultiply(A.Y, S), VectorMultiply(A.Z, S) };
+		}
+
+		FORCEINLINE VectorRegister4Float Dot(const FLaneVector& A, const FLaneVector& B)
+		{
+			return VectorMultiplyAdd(A.X, B.X, VectorMultiplyAdd(A.Y, B.Y, VectorMultiply(A.Z, B.Z)));
+		}
+
+		FORCEINLINE FLaneVector Cross(const FLaneVector& A, const FLaneVector& B)
+		{
+			return {
+				VectorSubtract(VectorMultiply(A.Y, B.Z), VectorMultiply(A.Z, B.Y)),
+				VectorSubtract(VectorMultiply(A.Z, B.X), VectorMultiply(A.X, B.Z)),
+				VectorSubtract(VectorMultiply(A.X, B.Y), VectorMultiply(A.Y, B.X)) };
+		}
+
+		/** Rotates V by the quaternion (Q, W), same formula as FQuat::RotateVector. Pass -Q to unrotate. */
+		FORCEINLINE FLaneVector Rotate(const FLaneVector& V, const FLaneVector& Q, const VectorRegister4Float& W)
+		{
+			const FLaneVector T = Scale(Cross(Q, V), VectorSetFloat1(2.0f));
+			return Add(Add(V, Scale(T, W)), Cross(Q, T));
+		}
+
+		/** Loads 4 consecutive floats, zero-padding the lanes past the end of the array. */
+		FORCEINLINE VectorRegister4Float LoadLanes(const float* Data, int32 First, int32 NumValid)
+		{
+			if (NumValid >= LaneCount)
+			{
+				return VectorLoad(Data + First);
+			}
+
+			alignas(16) float Tail[LaneCount] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			for (int32 Lane = 0; Lane < NumValid; ++Lane)
+			{
+				Tail[Lane] = Data[First + Lane];
+			}
+			return VectorLoadAligned(Tail);
+		}
+
+		FORCEINLINE FLaneVector LoadLanes(const float* X, const float* Y, const float* Z, int32 First, int32 NumValid)
+		{
+			return { LoadLanes(X, First, NumValid), LoadLanes(Y, First, NumValid), LoadLanes(Z, First, NumValid) };
+		}
+
+		/** Lane-wise reciprocal that maps axis-parallel directions to a huge finite value, so slab tests never produce NaNs. */
+		FORCEINLINE VectorRegister4Float SafeInv(const VectorRegister4Float& Value)
+		{
+			const VectorRegister4Float Huge = VectorSelect(VectorCompareLT(Value, VectorZeroFloat()), VectorSetFloat1(-1e30f), VectorSetFloat1(1e30f));
+			return VectorSelect(VectorCompareLT(VectorAbs(Value), VectorSetFloat1(UE_SMALL_NUMBER)), Huge, VectorDivide(VectorOneFloat(), Value));
+		}
+
+		/**
+		 * Slab test of a ray against 4 boxes of half size Extent centered at the origin.
+		 * @return Entry distance of every lane, 0 for boxes containing the ray start, FLT_MAX for misses.
+		 */
+		FORCEINLINE VectorRegister4Float SlabTest(const FLaneVector& Origin, const FLaneVector& InvDir, const FLaneVector& Extent)
+		{
+			const VectorRegister4Float Zero = VectorZeroFloat();
+
+			VectorRegister4Float T1 = VectorMultiply(VectorSubtract(VectorNegate(Extent.X), Origin.X), InvDir.X);
+			VectorRegister4Float T2 = VectorMultiply(VectorSubtract(Extent.X, Origin.X), InvDir.X);
+			VectorRegister4Float TNear = VectorMin(T1, T2);
+			VectorRegister4Float TFar = VectorMax(T1, T2);
+
+			T1 = VectorMultiply(VectorSubtract(VectorNegate(Extent.Y), Origin.Y), InvDir.Y);
+			T2 = VectorMultiply(VectorSubtract(Extent.Y, Origin.Y), InvDir.Y);
+			TNear = VectorMax(TNear, VectorMin(T1, T2));
+			TFar = VectorMin(TFar, VectorMax(T1, T2));
+
+			T1 = VectorMultiply(VectorSubtract(VectorNegate(Extent.Z), Origin.Z), InvDir.Z);
+			T2 = VectorMultiply(VectorSubtract(Extent.Z, Origin.Z), InvDir.Z);
+			TNear = VectorMax(TNear, VectorMin(T1, T2));
+			TFar = VectorMin(TFar, VectorMax(T1, T2));
+
+			const VectorRegister4Float Hit = VectorBitwiseAnd(VectorCompareLE(TNear, TFar), VectorCompareGE(TFar, Zero));
+			return VectorSelect(Hit, VectorMax(TNear, Zero), VectorSetFloat1(FLT_MAX));
+		}
+
+		/**
+		 * Entry distance of a ray against 4 spheres, given the ray start relative to their centers.
+		 * Spheres containing the ray start are hit at 0, misses return FLT_MAX.
+		 */
+		FORCEINLINE VectorRegister4Float SphereTest(const FLaneVector& RelStart, const FLaneVector& Dir, const VectorRegister4Float& RadiusSq)
+		{
+			const VectorRegister4Float Zero = VectorZeroFloat();
+
+			const VectorRegister4Float B = Dot(RelStart, Dir);
+			const VectorRegister4Float C = VectorSubtract(Dot(RelStart, RelStart), RadiusSq);
+			const VectorRegister4Float Disc = VectorSubtract(VectorMultiply(B, B), C);
+			const VectorRegister4Float SqrtDisc = VectorSqrt(VectorMax(Disc, Zero));
+
+			// Spheres behind the ray have both roots negative.
+			const VectorRegister4Float T1 = VectorNegate(VectorAdd(B, SqrtDisc));
+			const VectorRegister4Float T2 = VectorSubtract(SqrtDisc, B);
+			const VectorRegister4Float Hit = VectorBitwiseAnd(VectorCompareGE(Disc, Zero), VectorCompareGE(T2, Zero));
+			return VectorSelect(Hit, VectorMax(T1, Zero), VectorSetFloat1(FLT_MAX));
+		}
+
+		/**
+		 * Runs Kernel(First, NumValid) over blocks of 4 primitives. The kernel returns the hit distance of every lane.
+		 * @return Index of the closest hit within MaxDistance (lowest index on ties), or INDEX_NONE.
+		 */
+		template <typename TKernel>
+		int32 FindClosest(int32 Num, float MaxDistance, float& OutDistance, TKernel&& Kernel)
+		{
+			int32 BestIndex = INDEX_NONE;
+			OutDistance = MaxDistance;
+
+			for (int32 First = 0; First < Num; First += LaneCount)
+			{
+				const int32 NumValid = FMath::Min(LaneCount, Num - First);
+				const VectorRegister4Float T = Kernel(First, NumValid);
+
+				// Ignore the padding lanes of the last block.
+				uint32 LaneMask = (uint32)VectorMaskBits(VectorCompareLE(T, VectorSetFloat1(OutDistance))) & ((1u << NumValid) - 1);
+				if (LaneMask == 0)
+				{
+					continue;
+				}
+
+				alignas(16) float Distances[LaneCount];
+				VectorStoreAligned(T, Distances);
+
+				while (LaneMask)
+				{
+					const int32 Lane = FMath::CountTrailingZeros(LaneMask);
+					LaneMask &= LaneMask - 1;
+
+					if (BestIndex == INDEX_NONE || Distances[Lane] < OutDistance)
+					{
+						BestIndex = First + Lane;
+						OutDistance = Distances[Lane];
+					}
+				}
+			}
+
+			return BestIndex;
+		}
+
+		void InitBatchHit(FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float MaxDistance)
+		{
+			OutHit.Reset(1.f, false);
+			OutHit.TraceStart = RayStart;
+			OutHit.TraceEnd = RayStart + RayDir * MaxDistance;
+		}
+
+		/** Fills the hit of the winning primitive. Rays starting inside it report the normal facing the ray. */
+		void FillBatchHit(FKzHitResult& OutHit, const FVector& RayDir, float MaxDistance, float Distance, const FVector& Location, const FVector& Normal)
+		{
+			OutHit.bBlockingHit = true;
+			OutHit.bStartPenetrating = Distance <= 0.0f;
+			OutHit.Time = Distance / MaxDistance;
+			OutHit.Distance = Distance;
+			OutHit.Location = Location;
+			OutHit.Normal = OutHit.bStartPenetrating ? -RayDir : Normal;
+		}
+
+		/** Returns the normal of the box face closest to a point given in the box frame. */
+		FVector BoxFaceNormal(const FVector& LocalPoint, const FVector& Extents)
+		{
+			int32 Axis = 0;
+			float BestRatio = -1.0f;
+			for (int32 i = 0; i < 3; ++i)
+			{
+				const float Ratio = FMath::Abs(LocalPoint[i]) / FMath::Max(Extents[i], UE_SMALL_NUMBER);
+				if (Ratio > BestRatio)
+				{
+					BestRatio = Ratio;
+					Axis = i;
+				}
+			}
+
+			FVector Normal(0, 0, 0);
+			Normal[Axis] = LocalPoint[Axis] < 0.0f ? -1.0f : 1.0f;
+			return Normal;
+		}
+	}
+
+	int32 SphereBatch(FKzHitResult& OutHit, const FSphereSoA& Spheres, const FVector& RayStart, const FVector& RayDir, float MaxDistance)
+	{
+		if (MaxDistance <= 0.0f)
+		{
+			MaxDistance = UE_BIG_NUMBER;
+		}
+
+		InitBatchHit(OutHit, RayStart, RayDir, MaxDistance);
+		check(RayDir.IsNormalized());
+
+		const FLaneVector O = Broadcast(RayStart);
+		const FLaneVector D = Broadcast(RayDir);
+
+		float Distance;
+		const int32 Index = FindClosest(Spheres.Num, MaxDistance, Distance, [&](int32 First, int32 NumValid)
+		{
+			const FLaneVector C = LoadLanes(Spheres.CenterX, Spheres.CenterY, Spheres.CenterZ, First, NumValid);
+			const VectorRegister4Float R = LoadLanes(Spheres.Radius, First, NumValid);
+			return SphereTest(Sub(O, C), D, VectorMultiply(R, R));
+		});
+
+		if (Index != INDEX_NONE)
+		{
+			const FVector Center(Spheres.CenterX[Index], Spheres.CenterY[Index], Spheres.CenterZ[Index]);
+			const FVector Location = RayStart + RayDir * Distance;
+			FillBatchHit(OutHit, RayDir, MaxDistance, Distance, Location, (Location - Center).GetSafeNormal());
+		}
+
+		return Index;
+	}
+
+	int32 BoxBatch(FKzHitResult& OutHit, const FBoxSoA& Boxes, const FVector& RayStart, const FVector& RayDir, float MaxDistance)
+	{
+		if (MaxDistance <= 0.0f)
+		{
+			MaxDistance = UE_BIG_NUMBER;
+		}
+
+		InitBatchHit(OutHit, RayStart, RayDir, MaxDistance);
+
+		const FLaneVector O = Broadcast(RayStart);
+		const FLaneVector D = Broadcast(RayDir);
+		const FLaneVector InvD = { SafeInv(D.X), SafeInv(D.Y), SafeInv(D.Z) };
+
+		float Distance;
+		const int32 Index = FindClosest(Boxes.Num, MaxDistance, Distance, [&](int32 First, int32 NumValid)
+		{
+			const FLaneVector C = LoadLanes(Boxes.CenterX, Boxes.CenterY, Boxes.CenterZ, First, NumValid);
+			const FLaneVector E = LoadLanes(Boxes.ExtentX, Boxes.ExtentY, Boxes.ExtentZ, First, NumValid);
+			return SlabTest(Sub(O, C), InvD, E);
+		});
+
+		if (Index != INDEX_NONE)
+		{
+			const FVector Center(Boxes.CenterX[Index], Boxes.CenterY[Index], Boxes.CenterZ[Index]);
+			const FVector Extents(Boxes.ExtentX[Index], Boxes.ExtentY[Index], Boxes.ExtentZ[Index]);
+			const FVector Location = RayStart + RayDir * Distance;
+			FillBatchHit(OutHit, RayDir, MaxDistance, Distance, Location, BoxFaceNormal(Location - Center, Extents));
+		}
+
+		return Index;
+	}
+
+	int32 BoxBatch(FKzHitResult& OutHit, const FOrientedBoxSoA& Boxes, const FVector& RayStart, const FVector& RayDir, float MaxDistance)
+	{
+		if (MaxDistance <= 0.0f)
+		{
+			MaxDistance = UE_BIG_NUMBER;
+		}
+
+		InitBatchHit(OutHit, RayStart, RayDir, MaxDistance);
+
+		const FLaneVector O = Broadcast(RayStart);
+		const FLaneVector D = Broadcast(RayDir);
+
+		float Distance;
+		const int32 Index = FindClosest(Boxes.Num, MaxDistance, Distance, [&](int32 First, int32 NumValid)
+		{
+			const FLaneVector C = LoadLanes(Boxes.CenterX, Boxes.CenterY, Boxes.CenterZ, First, NumValid);
+			const FLaneVector E = LoadLanes(Boxes.ExtentX, Boxes.ExtentY, Boxes.ExtentZ, First, NumValid);
+
+			// Transform the ray to the local frame of every box.
+			const FLaneVector InvQ = { VectorNegate(LoadLanes(Boxes.RotationX, First, NumValid)), VectorNegate(LoadLanes(Boxes.RotationY, First, NumValid)), VectorNegate(LoadLanes(Boxes.RotationZ, First, NumValid)) };
+			const VectorRegister4Float W = LoadLanes(Boxes.RotationW, First, NumValid);
+			const FLaneVector LocalO = Rotate(Sub(O, C), InvQ, W);
+			const FLaneVector LocalD = Rotate(D, InvQ, W);
+
+			return SlabTest(LocalO, { SafeInv(LocalD.X), SafeInv(LocalD.Y), SafeInv(LocalD.Z) }, E);
+		});
+
+		if (Index != INDEX_NONE)
+		{
+			const FVector Center(Boxes.CenterX[Index], Boxes.CenterY[Index], Boxes.CenterZ[Index]);
+			const FQuat Rotation(Boxes.RotationX[Index], Boxes.RotationY[Index], Boxes.RotationZ[Index], Boxes.RotationW[Index]);
+			const FVector Extents(Boxes.ExtentX[Index], Boxes.ExtentY[Index], Boxes.ExtentZ[Index]);
+			const FVector Location = RayStart + RayDir * Distance;
+			const FVector LocalNormal = BoxFaceNormal(Rotation.UnrotateVector(Location - Center), Extents);
+			FillBatchHit(OutHit, RayDir, MaxDistance, Distance, Location, Rotation.RotateVector(LocalNormal));
+		}
+
+		return Index;
+	}
+
+	int32 CapsuleBatch(FKzHitResult& OutHit, const FCapsuleSoA& Capsules, const FVector& RayStart, const FVector& RayDir, float MaxDistance)
+	{
+		if (MaxDistance <= 0.0f)
+		{
+			MaxDistance = UE_BIG_NUMBER;
+		}
+
+		InitBatchHit(OutHit, RayStart, RayDir, MaxDistance);
+		check(RayDir.IsNormalized());
+
+		const FLaneVector O = Broadcast(RayStart);
+		const FLaneVector D = Broadcast(RayDir);
+
+		float Distance;
+		const int32 Index = FindClosest(Capsules.Num, MaxDistance, Distance, [&](int32 First, int32 NumValid)
+		{
+			const VectorRegister4Float Zero = VectorZeroFloat();
+			const VectorRegister4Float One = VectorOneFloat();
+			const VectorRegister4Float Two = VectorSetFloat1(2.0f);
+			const VectorRegister4Float Miss = VectorSetFloat1(FLT_MAX);
+
+			const FLaneVector C = LoadLanes(Capsules.CenterX, Capsules.CenterY, Capsules.CenterZ, First, NumValid);
+			const VectorRegister4Float QX = LoadLanes(Capsules.RotationX, First, NumValid);
+			const VectorRegister4Float QY = LoadLanes(Capsules.RotationY, First, NumValid);
+			const VectorRegister4Float QZ = LoadLanes(Capsules.RotationZ, First, NumValid);
+			const VectorRegister4Float QW = LoadLanes(Capsules.RotationW, First, NumValid);
+			const VectorRegister4Float R = LoadLanes(Capsules.Radius, First, NumValid);
+			const VectorRegister4Float RadiusSq = VectorMultiply(R, R);
+
+			// Local Z axis, ie. the quaternion applied to (0, 0, 1).
+			const FLaneVector Axis = {
+				VectorMultiply(Two, VectorMultiplyAdd(QX, QZ, VectorMultiply(QW, QY))),
+				VectorMultiply(Two, VectorSubtract(VectorMultiply(QY, QZ), VectorMultiply(QW, QX))),
+				VectorSubtract(One, VectorMultiply(Two, VectorMultiplyAdd(QX, QX, VectorMultiply(QY, QY)))) };
+
+			// Segment from the bottom hemisphere center (A) to the top one.
+			const VectorRegister4Float CylinderHalf = VectorMax(VectorSubtract(LoadLanes(Capsules.HalfHeight, First, NumValid), R), Zero);
+			const FLaneVector AB = Scale(Axis, VectorMultiply(Two, CylinderHalf));
+			const FLaneVector AO = Sub(Sub(O, C), Scale(Axis, VectorNegate(CylinderHalf)));
+
+			const VectorRegister4Float ABAB = Dot(AB, AB);
+			const VectorRegister4Float ABD = Dot(AB, D);
+			const VectorRegister4Float ABAO = Dot(AB, AO);
+
+			// Rays starting inside the capsule are hit at 0.
+			const VectorRegister4Float S = VectorMin(VectorMax(VectorDivide(ABAO, VectorMax(ABAB, VectorSetFloat1(UE_SMALL_NUMBER))), Zero), One);
+			const FLaneVector ToAxis = Sub(AO, Scale(AB, S));
+			const VectorRegister4Float Inside = VectorCompareLE(Dot(ToAxis, ToAxis), RadiusSq);
+
+			// Cylinder body, restricted to the segment. Rays parallel to the axis (A == 0) only hit the caps.
+			const VectorRegister4Float A = VectorSubtract(ABAB, VectorMultiply(ABD, ABD));
+			const VectorRegister4Float B = VectorSubtract(VectorMultiply(ABAB, Dot(D, AO)), VectorMultiply(ABAO, ABD));
+			const VectorRegister4Float Cc = VectorSubtract(VectorSubtract(VectorMultiply(ABAB, Dot(AO, AO)), VectorMultiply(ABAO, ABAO)), VectorMultiply(RadiusSq, ABAB));
+			const VectorRegister4Float H = VectorSubtract(VectorMultiply(B, B), VectorMultiply(A, Cc));
+			const VectorRegister4Float BodyT = VectorDivide(VectorNegate(VectorAdd(B, VectorSqrt(VectorMax(H, Zero)))), VectorMax(A, VectorSetFloat1(UE_SMALL_NUMBER)));
+			const VectorRegister4Float Y = VectorMultiplyAdd(BodyT, ABD, ABAO);
+
+			VectorRegister4Float BodyHit = VectorBitwiseAnd(VectorCompareGT(A, VectorSetFloat1(UE_SMALL_NUMBER)), VectorCompareGE(H, Zero));
+			BodyHit = VectorBitwiseAnd(BodyHit, VectorBitwiseAnd(VectorCompareGE(Y, Zero), VectorCompareLE(Y, ABAB)));
+			BodyHit = VectorBitwiseAnd(BodyHit, VectorCompareGE(BodyT, Zero));
+
+			// Hemispheres.
+			const VectorRegister4Float CapA = SphereTest(AO, D, RadiusSq);
+			const VectorRegister4Float CapB = SphereTest(Sub(AO, AB), D, RadiusSq);
+
+			const VectorRegister4Float T = VectorMin(VectorSelect(BodyHit, BodyT, Miss), VectorMin(CapA, CapB));
+			return VectorSelect(Inside, Zero, T);
+		});
+
+		if (Index != INDEX_NONE)
+		{
+			const FVector Center(Capsules.CenterX[Index], Capsules.CenterY[Index], Capsules.CenterZ[Index]);
+			const FQuat Rotation(Capsules.RotationX[Index], Capsules.RotationY[Index], Capsules.RotationZ[Index], Capsules.RotationW[Index]);
+			const float CylinderHalf = FMath::Max(Capsules.HalfHeight[Index] - Capsules.Radius[Index], 0.0f);
+			const FVector Location = RayStart + RayDir * Distance;
+
+			// Normal = from closest point on the segment to the hit point
+			const FVector LocalPoint = Rotation.UnrotateVector(Location - Center);
+			const FVector Closest = Center + Rotation.RotateVector(FVector(0, 0, FMath::Clamp(LocalPoint.Z, -CylinderHalf, CylinderHalf)));
+			FillBatchHit(OutHit, RayDir, MaxDistance, Distance, Location, (Location - Closest).GetSafeNormal());
+		}
+
+		return Index;
+	}
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Components/KzSensorComponent.h"
 #include "Core/KzRegistrySubsystem.h"
 #include "Collision/KzGJK.h"
+#include "Collision/KzOverlap.h"
 #include "GameFramework/Actor.h"
 #include "Engine/World.h"
 
@@ -104,6 +105,11 @@ void UKzSensorComponent::PerformScan()
 
 	TArray<FKzOverlapResult> NewOverlaps;
 
+	// Only shapes tested in this scan keep their warm start data
+	++ScanStamp;
+
+	const FKzShapeWorldCache& SensorCache = GetWorldCache();
+
 	// 2. Iterate and Check GJK Intersection
 	for (const FKzSensorCandidate& Candidate : Candidates)
 	{
@@ -111,8 +117,12 @@ void UKzSensorComponent::PerformScan()
 
 		if (!TargetShape || TargetShape == this) continue;
 
-		// Perform GJK with Scale applied to the shapes
-		bool bIntersect = Kz::GJK::Intersect(Shape * GetComponentScale(), GetComponentLocation(), GetComponentQuat(), TargetShape->Shape * TargetShape->GetComponentScale(), TargetShape->GetComponentLocation(), TargetShape->GetComponentQuat());
+		// Seed GJK from the previous scan of this shape, since the pair barely moved since then
+		FSimplexCacheEntry& SimplexEntry = SimplexCaches.FindOrAdd(TargetShape);
+		SimplexEntry.ScanStamp = ScanStamp;
+
+		// Test the cached world space shapes, which already have the scale applied
+		bool bIntersect = Kz::Overlap::Intersect(SensorCache, TargetShape->GetWorldCache(), SimplexEntry.Cache);
 
 		if (bIntersect)
 		{
@@ -138,6 +148,15 @@ void UKzSensorComponent::PerformScan()
 		}
 	}
 
+	// Drop the warm start data of shapes that are no longer candidates
+	for (auto It = SimplexCaches.CreateIterator(); It; ++It)
+	{
+		if (It.Value().ScanStamp != ScanStamp)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
 	// 3. Process Begin Overlaps
 	for (const FKzOverlapResult& NewResult : NewOverlaps)
 	{
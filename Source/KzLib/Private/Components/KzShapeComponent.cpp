@@ -30,9 +30,51 @@ void UKzShapeComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyCh
 	{
 		MarkRenderStateDirty();
 	}
+
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UKzShapeComponent, Shape))
+	{
+		// Edited hull points invalidate the derived hull data.
+		if (FKzConvex* Convex = Shape.TryAs<FKzConvex>())
+		{
+			Convex->Build();
+			MarkRenderStateDirty();
+		}
+		else if (FKzCompoundShape* Compound = Shape.TryAs<FKzCompoundShape>())
+		{
+			Compound->Build();
+			MarkRenderStateDirty();
+		}
+
+		UpdateWorldCache();
+	}
+}
+
+void UKzShapeComponent::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// Undo restores Shape in place, without going through SetShape().
+	UpdateWorldCache();
+	MarkRenderStateDirty();
 }
 #endif
 
+void UKzShapeComponent::SetShape(const FKzShapeInstance& InShape)
+{
+	Shape = InShape;
+	UpdateWorldCache();
+	UpdateBounds();
+	MarkRenderStateDirty();
+}
+
+void UKzShapeComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// The transform may already be up to date, in which case registering does not go through OnUpdateTransform().
+	UpdateWorldCache();
+}
+
 FPrimitiveSceneProxy* UKzShapeComponent::CreateSceneProxy()
 {
 	class FKzShapeSceneProxy  final : public FPrimitiveSceneProxy
@@ -48,7 +90,7 @@ FPrimitiveSceneProxy* UKzShapeComponent::CreateSceneProxy()
 		FKzShapeSceneProxy (const UKzShapeComponent* InComponent)
 			: FPrimitiveSceneProxy(InComponent)
 			, bDrawOnlyIfSelected(InComponent->bDrawOnlyIfSelected)
-			, Shape(InComponent->Shape)
+			, Shape(InComponent->GetShape())
 			, ShapeColor(InComponent->ShapeColor)
 			, LineThickness(InComponent->LineThickness)
 			, bDrawSolid(InComponent->bDrawSolid)
@@ -129,7 +171,7 @@ bool UKzShapeComponent::IsZeroExtent() const
 
 FCollisionShape UKzShapeComponent::GetCollisionShape(float Inflation) const
 {
-	return (Shape * GetComponentScale()).ToCollisionShape(Inflation);
+	return GetWorldCache().Shape.ToCollisionShape(Inflation);
 }
 
 FBoxSphereBounds UKzShapeComponent::CalcBounds(const FTransform& LocalToWorld) const
@@ -144,6 +186,22 @@ void UKzShapeComponent::CalcBoundingCylinder(float& CylinderRadius, float& Cylin
 	CylinderHalfHeight = BoundsHalfsize.Z;
 }
 
+void UKzShapeComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+	// Moves keep the scaled shape, scale changes need a new copy.
+	const FTransform& Transform = GetComponentTransform();
+	if (WorldCache.GetScale() != Transform.GetScale3D())
+	{
+		UpdateWorldCache();
+	}
+	else
+	{
+		WorldCache.UpdateTransform(Transform.GetLocation(), Transform.GetRotation());
+	}
+}
+
 void UKzShapeComponent::UpdateBodySetup()
 {
 }
\ No newline at end of file
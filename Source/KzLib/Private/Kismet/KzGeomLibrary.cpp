@@ -246,6 +246,11 @@ bool UKzGeomLibrary::CylinderIntersectsPoint(const FVector Center, float Radius,
 	return Kz::Geom::CylinderIntersectsPoint(Center, Rotation.Quaternion(), Radius, HalfHeight, Point);
 }
 
+FKzShapeInstance UKzGeomLibrary::MakeConvex(const TArray<FVector>& Points)
+{
+	return FKzShapeInstance::Make<FKzConvex>(Points);
+}
+
 TArray<FVector> UKzGeomLibrary::GetFibonacciSpherePoints(int32 NumSamples, float Radius, const FTransform& Transform)
 {
 	TArray<FVector> Points;
@@ -0,0 +1,10 @@
+// Copyright 2026 kirzo
+
+#include "Math/Geometry/KzShape.h"
+#include "Collision/KzHitResult.h"
+
+bool FKzShape::RaycastTest(const FVector& Position, const FQuat& Orientation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+{
+	FKzHitResult Scratch;
+	return Raycast(Scratch, Position, Orientation, RayStart, RayDir, MaxDistance);
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+// Copyright 2026 kirzo
+
+#include "Math/Geometry/KzShapeValue.h"
+
+bool FKzShapeValue::TryFrom(const FKzShapeInstance& Shape, FKzShapeValue& OutValue)
+{
+	const UScriptStruct* Struct = Shape.GetScriptStruct();
+
+	if (Struct == FKzSphere::StaticStruct())
+	{
+		OutValue = FKzShapeValue(Shape.As<FKzSphere>());
+		return true;
+	}
+	if (Struct == FKzBox::StaticStruct())
+	{
+		OutValue = FKzShapeValue(Shape.As<FKzBox>());
+		return true;
+	}
+	if (Struct == FKzCapsule::StaticStruct())
+	{
+		OutValue = FKzShapeValue(Shape.As<FKzCapsule>());
+		return true;
+	}
+	if (Struct == FKzCylinder::StaticStruct())
+	{
+		OutValue = FKzShapeValue(Shape.As<FKzCylinder>());
+		return true;
+	}
+
+	return false;
+}
+
+FKzShapeInstance FKzShapeValue::ToInstance() const
+{
+	return Visit([](const auto& Shape) { return FKzShapeInstance::Make(Shape); });
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+// Copyright 2026 kirzo
+
+#include "Math/Geometry/KzShapeWorldCache.h"
+
+void FKzShapeWorldCache::Update(const FKzShapeInstance& InShape, const FTransform& Transform)
+{
+	Scale = Transform.GetScale3D();
+
+	Shape = InShape;
+	if (Shape.IsValid() && !Scale.Equals(FVector::OneVector, 0.0))
+	{
+		Shape *= Scale;
+	}
+
+	// The bounding sphere only depends on the local bounds, which rotations do not change.
+	const FBox LocalBounds = Shape.GetBoundingBox(FVector::ZeroVector, FQuat::Identity);
+	LocalCenter = LocalBounds.GetCenter();
+	BoundingSphere.W = LocalBounds.GetExtent().Size();
+
+	UpdateTransform(Transform.GetLocation(), Transform.GetRotation());
+}
+
+void FKzShapeWorldCache::UpdateTransform(const FVector& InPosition, const FQuat& InRotation)
+{
+	Position = InPosition;
+	Rotation = InRotation;
+
+	RotationMatrix = Rotation.ToMatrix();
+	InverseRotationMatrix = RotationMatrix.GetTransposed();
+
+	Bounds = Shape.GetBoundingBox(Position, Rotation);
+	BoundingSphere.Center = ToWorldPoint(LocalCenter);
+}
\ No newline at end of file
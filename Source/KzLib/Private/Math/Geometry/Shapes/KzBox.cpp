@@ -29,6 +29,11 @@ bool FKzBox::Raycast(FKzHitResult& OutHit, const FVector& Center, const FQuat& R
 	return Kz::Raycast::Box(OutHit, Center, Rotation, HalfSize, RayStart, RayDir, MaxDistance);
 }
 
+bool FKzBox::RaycastTest(const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+{
+	return Kz::Raycast::Box(Center, Rotation, HalfSize, RayStart, RayDir, MaxDistance);
+}
+
 void FKzBox::DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
 {
 	DrawDebugBox(InWorld, Center, HalfSize, Rotation, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
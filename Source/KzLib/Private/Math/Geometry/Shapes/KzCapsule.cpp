@@ -29,6 +29,11 @@ bool FKzCapsule::Raycast(FKzHitResult& OutHit, const FVector& Center, const FQua
 	return Kz::Raycast::Capsule(OutHit, Center, Rotation, Radius, HalfHeight, RayStart, RayDir, MaxDistance);
 }
 
+bool FKzCapsule::RaycastTest(const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+{
+	return Kz::Raycast::Capsule(Center, Rotation, Radius, HalfHeight, RayStart, RayDir, MaxDistance);
+}
+
 void FKzCapsule::DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
 {
 	DrawDebugCapsule(InWorld, Center, HalfHeight, Radius, Rotation, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
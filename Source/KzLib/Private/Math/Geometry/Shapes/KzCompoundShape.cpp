@@ -0,0 +1,429 @@
+// Copyright 2026 kirzo
+
+#include "Math/Geometry/Shapes/KzCompoundShape.h"
+#include "Collision/KzHitResult.h"
+#include "Collision/KzGJK.h"
+#include "Collision/KzOverlap.h"
+#include "Algo/Sort.h"
+
+void FKzCompoundShape::Build()
+{
+	Nodes.Reset();
+
+	const int32 NumChildren = Children.Num();
+	if (NumChildren == 0)
+	{
+		return;
+	}
+
+	TArray<FBox> ChildBounds;
+	ChildBounds.Reserve(NumChildren);
+	for (FKzCompoundChild& Child : Children)
+	{
+		if (Child.Shape.IsValid())
+		{
+			Child.Shape.As<FKzShape>().Sanitize();
+			ChildBounds.Add(Child.Shape.GetBoundingBox(Child.Position, Child.Rotation));
+		}
+		else
+		{
+			ChildBounds.Add(FBox(Child.Position, Child.Position));
+		}
+	}
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumChildren);
+	for (int32 i = 0; i < NumChildren; ++i)
+	{
+		Order[i] = i;
+	}
+
+	// Top-down median splits along the widest axis of the child centers. Siblings are allocated in pairs.
+	Nodes.Reserve(2 * NumChildren - 1);
+	Nodes.AddDefaulted();
+
+	// Node, first child in Order, number of children.
+	TArray<FIntVector, TInlineAllocator<32>> Pending;
+	Pending.Emplace(0, 0, NumChildren);
+
+	while (Pending.Num() > 0)
+	{
+		const FIntVector Item = Pending.Pop(EAllowShrinking::No);
+		const int32 NodeIndex = Item.X;
+		const int32 First = Item.Y;
+		const int32 Count = Item.Z;
+
+		FBox Bounds(ForceInit);
+		FBox Centers(ForceInit);
+		for (int32 i = First; i < First + Count; ++i)
+		{
+			Bounds += ChildBounds[Order[i]];
+			Centers += ChildBounds[Order[i]].GetCenter();
+		}
+		Nodes[NodeIndex].Bounds = Bounds;
+
+		if (Count == 1)
+		{
+			Nodes[NodeIndex].Child = Order[First];
+			continue;
+		}
+
+		const FVector Extent = Centers.GetExtent();
+		const int32 Axis = Extent.X >= Extent.Y ? (Extent.X >= Extent.Z ? 0 : 2) : (Extent.Y >= Extent.Z ? 1 : 2);
+		Algo::SortBy(TArrayView<int32>(Order.GetData() + First, Count), [&](int32 Child) { return ChildBounds[Child].GetCenter()[Axis]; });
+
+		const int32 FirstNode = Nodes.Num();
+		Nodes.AddDefaulted(2);
+		Nodes[NodeIndex].FirstNode = FirstNode;
+
+		const int32 Half = Count / 2;
+		Pending.Emplace(FirstNode, First, Half);
+		Pending.Emplace(FirstNode + 1, First + Half, Count - Half);
+	}
+}
+
+bool FKzCompoundShape::IntersectsShape(const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FVector& Center, const FQuat& Rotation) const
+{
+	if (IsZeroExtent() || !Shape.IsValid())
+	{
+		return false;
+	}
+
+	// Candidate children come from the shape bounds, in the local space of the compound.
+	const FVector LocalPosition = Rotation.UnrotateVector(ShapePosition - Center);
+	const FQuat LocalRotation = Rotation.Inverse() * ShapeRotation;
+	const FBox LocalBounds = Shape.GetBoundingBox(LocalPosition, LocalRotation);
+
+	bool bIntersects = false;
+	ForEachChild(LocalBounds, [&](int32 ChildIndex)
+	{
+		const FKzCompoundChild& Child = Children[ChildIndex];
+		bIntersects = Child.Shape.IsValid() && Kz::Overlap::Intersect(Child.Shape, Center + Rotation.RotateVector(Child.Position), Rotation * Child.Rotation, Shape, ShapePosition, ShapeRotation);
+		return !bIntersects;
+	});
+
+	return bIntersects;
+}
+
+FBox FKzCompoundShape::GetBoundingBox(const FVector& Center, const FQuat& Rotation) const
+{
+	if (IsZeroExtent())
+	{
+		return FBox(Center, Center);
+	}
+
+	// Union of the rotated children, tighter than the rotated local bounds.
+	FBox Bounds(ForceInit);
+	for (const FKzCompoundChild& Child : Children)
+	{
+		const FVector ChildPosition = Center + Rotation.RotateVector(Child.Position);
+		Bounds += Child.Shape.IsValid() ? Child.Shape.GetBoundingBox(ChildPosition, Rotation * Child.Rotation) : FBox(ChildPosition, ChildPosition);
+	}
+	return Bounds;
+}
+
+FVector FKzCompoundShape::GetClosestPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const
+{
+	if (IsZeroExtent())
+	{
+		return Center;
+	}
+
+	const FVector LocalPoint = Rotation.UnrotateVector(Point - Center);
+
+	// Best-first descent, pruning nodes farther than the closest point found so far.
+	FVector Best = LocalPoint;
+	double BestDistSq = TNumericLimits<double>::Max();
+
+	TArray<int32, TInlineAllocator<32>> Stack;
+	Stack.Add(0);
+
+	while (Stack.Num() > 0)
+	{
+		const FKzCompoundNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+		if (Node.Bounds.ComputeSquaredDistanceToPoint(LocalPoint) >= BestDistSq)
+		{
+			continue;
+		}
+
+		if (Node.IsLeaf())
+		{
+			const FKzCompoundChild& Child = Children[Node.Child];
+			if (Child.Shape.IsValid())
+			{
+				const FVector Candidate = Child.Shape.GetClosestPoint(Child.Position, Child.Rotation, LocalPoint);
+				const double DistSq = FVector::DistSquared(Candidate, LocalPoint);
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					Best = Candidate;
+				}
+			}
+			continue;
+		}
+
+		const FKzCompoundNode& Left = Nodes[Node.FirstNode];
+		const FKzCompoundNode& Right = Nodes[Node.FirstNode + 1];
+		const bool bLeftFirst = Left.Bounds.ComputeSquaredDistanceToPoint(LocalPoint) <= Right.Bounds.ComputeSquaredDistanceToPoint(LocalPoint);
+		Stack.Add(bLeftFirst ? Node.FirstNode + 1 : Node.FirstNode);
+		Stack.Add(bLeftFirst ? Node.FirstNode : Node.FirstNode + 1);
+	}
+
+	return Center + Rotation.RotateVector(Best);
+}
+
+bool FKzCompoundShape::IntersectsPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const
+{
+	const FVector LocalPoint = Rotation.UnrotateVector(Point - Center);
+
+	bool bIntersects = false;
+	ForEachChild(FBox(LocalPoint, LocalPoint), [&](int32 ChildIndex)
+	{
+		const FKzCompoundChild& Child = Children[ChildIndex];
+		bIntersects = Child.Shape.IntersectsPoint(Child.Position, Child.Rotation, LocalPoint);
+		return !bIntersects;
+	});
+
+	return bIntersects;
+}
+
+FCollisionShape FKzCompoundShape::ToCollisionShape(float Inflation) const
+{
+	if (IsZeroExtent())
+	{
+		return FCollisionShape::MakeBox(FVector(Inflation));
+	}
+
+	// Engine shapes are centered, use the box around the origin that encloses the children.
+	const FBox& LocalBounds = Nodes[0].Bounds;
+	return FCollisionShape::MakeBox(FVector::Max(LocalBounds.Min.GetAbs(), LocalBounds.Max.GetAbs()) + Inflation);
+}
+
+void FKzCompoundShape::Inflate(float Inflation)
+{
+	for (FKzCompoundChild& Child : Children)
+	{
+		Child.Shape += Inflation;
+	}
+	Build();
+}
+
+void FKzCompoundShape::Inflate(const FVector& Inflation)
+{
+	for (FKzCompoundChild& Child : Children)
+	{
+		Child.Shape += Child.Rotation.UnrotateVector(Inflation).GetAbs();
+	}
+	Build();
+}
+
+void FKzCompoundShape::Scale(const FVector& Scale)
+{
+	for (FKzCompoundChild& Child : Children)
+	{
+		Child.Position *= Scale;
+		Child.Shape *= Child.Rotation.UnrotateVector(Scale).GetAbs();
+	}
+	Build();
+}
+
+FVector FKzCompoundShape::GetSupportPoint(const FVector& Direction) const
+{
+	FVector Best = FVector::ZeroVector;
+	double BestDot = -TNumericLimits<double>::Max();
+
+	for (const FKzCompoundChild& Child : Children)
+	{
+		if (!Child.Shape.IsValid())
+		{
+			continue;
+		}
+
+		const FVector Support = Child.Position + Child.Rotation.RotateVector(Child.Shape.GetSupportPoint(Child.Rotation.UnrotateVector(Direction)));
+		const double Dot = Support | Direction;
+		if (Dot > BestDot)
+		{
+			BestDot = Dot;
+			Best = Support;
+		}
+	}
+
+	return Best;
+}
+
+bool FKzCompoundShape::Raycast(FKzHitResult& OutHit, const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+{
+	if (MaxDistance <= 0.0f)
+	{
+		MaxDistance = UE_BIG_NUMBER;
+	}
+
+	OutHit.Reset(1.f, false);
+	OutHit.TraceStart = RayStart;
+	OutHit.TraceEnd = RayStart + RayDir * MaxDistance;
+
+	if (IsZeroExtent())
+	{
+		return false;
+	}
+
+	// The hierarchy is traversed in local space, children are cast against in world space.
+	const FVector LocalStart = Rotation.UnrotateVector(RayStart - Center);
+	const FVector LocalDir = Rotation.UnrotateVector(RayDir);
+
+	auto SafeInv = [](double Value) { return FMath::Abs(Value) > UE_DOUBLE_SMALL_NUMBER ? 1.0 / Value : (Value < 0.0 ? -UE_BIG_NUMBER : UE_BIG_NUMBER); };
+	const FVector InvDir(SafeInv(LocalDir.X), SafeInv(LocalDir.Y), SafeInv(LocalDir.Z));
+
+	// Returns the entry distance into a node, or a negative value if the ray misses it within BestDistance.
+	auto IntersectNode = [&](const FKzCompoundNode& Node, double BestDistance)
+	{
+		const FVector T1 = (Node.Bounds.Min - LocalStart) * InvDir;
+		const FVector T2 = (Node.Bounds.Max - LocalStart) * InvDir;
+		const double TNear = FMath::Max(FMath::Max3(FMath::Min(T1.X, T2.X), FMath::Min(T1.Y, T2.Y), FMath::Min(T1.Z, T2.Z)), 0.0);
+		const double TFar = FMath::Min(FMath::Min3(FMath::Max(T1.X, T2.X), FMath::Max(T1.Y, T2.Y), FMath::Max(T1.Z, T2.Z)), BestDistance);
+		return TNear <= TFar ? TNear : -1.0;
+	};
+
+	float BestDistance = MaxDistance;
+	bool bHit = false;
+
+	TArray<int32, TInlineAllocator<32>> Stack;
+	if (IntersectNode(Nodes[0], BestDistance) >= 0.0)
+	{
+		Stack.Add(0);
+	}
+
+	while (Stack.Num() > 0)
+	{
+		const FKzCompoundNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+
+		if (Node.IsLeaf())
+		{
+			// Children visited after a closer hit may no longer be reachable.
+			if (IntersectNode(Node, BestDistance) < 0.0)
+			{
+				continue;
+			}
+
+			const FKzCompoundChild& Child = Children[Node.Child];
+			FKzHitResult ChildHit;
+			if (Child.Shape.IsValid() &&
+				Kz::GJK::Raycast(ChildHit, RayStart, RayDir, BestDistance, Child.Shape, Center + Rotation.RotateVector(Child.Position), Rotation * Child.Rotation) &&
+				ChildHit.bBlockingHit && ChildHit.Distance <= BestDistance)
+			{
+				OutHit = ChildHit;
+				BestDistance = ChildHit.Distance;
+				bHit = true;
+
+				if (BestDistance <= 0.0f)
+				{
+					break;
+				}
+			}
+			continue;
+		}
+
+		const double TLeft = IntersectNode(Nodes[Node.FirstNode], BestDistance);
+		const double TRight = IntersectNode(Nodes[Node.FirstNode + 1], BestDistance);
+
+		if (TLeft >= 0.0 && TRight >= 0.0)
+		{
+			const bool bLeftFirst = TLeft <= TRight;
+			Stack.Add(bLeftFirst ? Node.FirstNode + 1 : Node.FirstNode);
+			Stack.Add(bLeftFirst ? Node.FirstNode : Node.FirstNode + 1);
+		}
+		else if (TLeft >= 0.0)
+		{
+			Stack.Add(Node.FirstNode);
+		}
+		else if (TRight >= 0.0)
+		{
+			Stack.Add(Node.FirstNode + 1);
+		}
+	}
+
+	if (bHit)
+	{
+		// Report the trace of the whole query, not the clipped one of the child.
+		OutHit.TraceStart = RayStart;
+		OutHit.TraceEnd = RayStart + RayDir * MaxDistance;
+		OutHit.Time = OutHit.Distance / MaxDistance;
+	}
+
+	return bHit;
+}
+
+bool FKzCompoundShape::RaycastTest(const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+{
+	if (IsZeroExtent())
+	{
+		return false;
+	}
+
+	const double Length = MaxDistance > 0.0f ? MaxDistance : UE_BIG_NUMBER;
+	const FVector LocalStart = Rotation.UnrotateVector(RayStart - Center);
+	const FVector LocalDir = Rotation.UnrotateVector(RayDir);
+
+	auto SafeInv = [](double Value) { return FMath::Abs(Value) > UE_DOUBLE_SMALL_NUMBER ? 1.0 / Value : (Value < 0.0 ? -UE_BIG_NUMBER : UE_BIG_NUMBER); };
+	const FVector InvDir(SafeInv(LocalDir.X), SafeInv(LocalDir.Y), SafeInv(LocalDir.Z));
+
+	auto HitsNode = [&](const FKzCompoundNode& Node)
+	{
+		const FVector T1 = (Node.Bounds.Min - LocalStart) * InvDir;
+		const FVector T2 = (Node.Bounds.Max - LocalStart) * InvDir;
+		const double TNear = FMath::Max(FMath::Max3(FMath::Min(T1.X, T2.X), FMath::Min(T1.Y, T2.Y), FMath::Min(T1.Z, T2.Z)), 0.0);
+		const double TFar = FMath::Min(FMath::Min3(FMath::Max(T1.X, T2.X), FMath::Max(T1.Y, T2.Y), FMath::Max(T1.Z, T2.Z)), Length);
+		return TNear <= TFar;
+	};
+
+	// Any child will do, so nodes are visited in storage order.
+	TArray<int32, TInlineAllocator<32>> Stack;
+	Stack.Add(0);
+
+	while (Stack.Num() > 0)
+	{
+		const FKzCompoundNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+		if (!HitsNode(Node))
+		{
+			continue;
+		}
+
+		if (Node.IsLeaf())
+		{
+			const FKzCompoundChild& Child = Children[Node.Child];
+			if (Child.Shape.IsValid() && Kz::GJK::RaycastTest(RayStart, RayDir, MaxDistance, Child.Shape, Center + Rotation.RotateVector(Child.Position), Rotation * Child.Rotation))
+			{
+				return true;
+			}
+			continue;
+		}
+
+		Stack.Add(Node.FirstNode + 1);
+		Stack.Add(Node.FirstNode);
+	}
+
+	return false;
+}
+
+void FKzCompoundShape::DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
+{
+	for (const FKzCompoundChild& Child : Children)
+	{
+		if (Child.Shape.IsValid())
+		{
+			Child.Shape.As<FKzShape>().DrawDebug(InWorld, Center + Rotation.RotateVector(Child.Position), Rotation * Child.Rotation, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+		}
+	}
+}
+
+void FKzCompoundShape::DrawSceneProxy(FPrimitiveDrawInterface* PDI, const FMatrix& LocalToWorld, const FLinearColor& Color, bool bDrawSolid, float Thickness, int32 ViewIndex, FMeshElementCollector& Collector) const
+{
+	for (const FKzCompoundChild& Child : Children)
+	{
+		if (Child.Shape.IsValid())
+		{
+			const FMatrix ChildToWorld = FTransform(Child.Rotation, Child.Position).ToMatrixNoScale() * LocalToWorld;
+			Child.Shape.As<FKzShape>().DrawSceneProxy(PDI, ChildToWorld, Color, bDrawSolid, Thickness, ViewIndex, Collector);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,995 @@
+// Copyright 2026 kirzo
+
+#include "Math/Geometry/Shapes/KzConvex.h"
+#include "Collision/KzHitResult.h"
+#include "Algo/Sort.h"
+#include "PhysicsEngine/AggregateGeom.h"
+#include "Engine/Engine.h"
+#include "Materials/Material.h"
+#include "DrawDebugHelpers.h"
+#include "DynamicMeshBuilder.h"
+#include "PrimitiveDrawingUtils.h"
+#include "Materials/MaterialRenderProxy.h"
+
+namespace
+{
+	/** Hulls with up to this many vertices use a linear support scan, which beats hill climbing on tiny hulls. */
+	constexpr int32 BruteForceSupportVertices = 16;
+
+	/** Triangle of the hull under construction. */
+	struct FHullFace
+	{
+		int32 V[3];
+		FVector Normal;
+		double Distance;
+		bool bAlive;
+	};
+
+	/** Distance below which points are considered coplanar or coincident, relative to the size of the input. */
+	double HullTolerance(TConstArrayView<FVector> Points)
+	{
+		double MaxAbs = 0.0;
+		for (const FVector& P : Points)
+		{
+			MaxAbs = FMath::Max(MaxAbs, P.GetAbsMax());
+		}
+		return UE_KINDA_SMALL_NUMBER * (1.0 + MaxAbs);
+	}
+
+	FORCEINLINE uint64 EdgeKey(int32 From, int32 To)
+	{
+		return (uint64(uint32(From)) << 32) | uint64(uint32(To));
+	}
+
+	/** Incrementally built hull triangles, with the face on the left of every directed edge. */
+	struct FHullBuilder
+	{
+		const TArray<FVector>& Points;
+		TArray<FHullFace> Faces;
+		TMap<uint64, int32> EdgeFaces;
+
+		explicit FHullBuilder(const TArray<FVector>& InPoints)
+			: Points(InPoints)
+		{
+		}
+
+		/** Adds the counter-clockwise (outward facing) triangle ABC. */
+		void AddFace(int32 A, int32 B, int32 C)
+		{
+			FHullFace Face;
+			Face.V[0] = A;
+			Face.V[1] = B;
+			Face.V[2] = C;
+			Face.Normal = ((Points[B] - Points[A]) ^ (Points[C] - Points[A])).GetSafeNormal();
+			Face.Distance = Face.Normal | Points[A];
+			Face.bAlive = true;
+
+			const int32 FaceIndex = Faces.Add(Face);
+			for (int32 Edge = 0; Edge < 3; ++Edge)
+			{
+				EdgeFaces.Add(EdgeKey(Face.V[Edge], Face.V[(Edge + 1) % 3]), FaceIndex);
+			}
+		}
+
+		/** Adds the triangle ABC, wound so its normal points away from Interior. */
+		void AddFaceFacingAway(int32 A, int32 B, int32 C, const FVector& Interior)
+		{
+			const FVector Normal = (Points[B] - Points[A]) ^ (Points[C] - Points[A]);
+			if ((Normal | (Interior - Points[A])) > 0.0)
+			{
+				Swap(B, C);
+			}
+			AddFace(A, B, C);
+		}
+
+		void RemoveFace(int32 FaceIndex)
+		{
+			FHullFace& Face = Faces[FaceIndex];
+			Face.bAlive = false;
+			for (int32 Edge = 0; Edge < 3; ++Edge)
+			{
+				EdgeFaces.Remove(EdgeKey(Face.V[Edge], Face.V[(Edge + 1) % 3]));
+			}
+		}
+
+		/** Returns the face across the directed edge AB, ie. the face owning BA. */
+		int32 GetTwinFace(int32 A, int32 B) const
+		{
+			const int32* Twin = EdgeFaces.Find(EdgeKey(B, A));
+			return Twin ? *Twin : INDEX_NONE;
+		}
+
+		double GetDistance(int32 FaceIndex, const FVector& Point) const
+		{
+			return (Faces[FaceIndex].Normal | Point) - Faces[FaceIndex].Distance;
+		}
+	};
+
+	/**
+	 * Returns the corners of the hull with every face plane pushed outwards by PlaneOffset(Normal), ie. the
+	 * vertices of the intersection of the offset half spaces. Computed in the dual: the plane N.X <= W becomes
+	 * the point N / (W - N.Center), the hull of those points has one face per corner of the intersection,
+	 * and faces that end up redundant simply do not make it into the dual hull.
+	 */
+	template <typename TPlaneOffset>
+	TArray<FVector> OffsetHullFaces(const FKzConvex& Convex, TPlaneOffset&& PlaneOffset)
+	{
+		FVector Center = FVector::ZeroVector;
+		for (const FVector& Vertex : Convex.Vertices)
+		{
+			Center += Vertex;
+		}
+		Center /= Convex.Vertices.Num();
+
+		const double Tolerance = HullTolerance(Convex.Vertices);
+
+		TArray<double> Distances;
+		Distances.Reserve(Convex.Planes.Num());
+		double MaxDistance = Tolerance;
+		for (const FPlane& Plane : Convex.Planes)
+		{
+			const double Distance = FMath::Max(PlaneOffset(Plane.GetNormal()) - Plane.PlaneDot(Center), Tolerance);
+			Distances.Add(Distance);
+			MaxDistance = FMath::Max(MaxDistance, Distance);
+		}
+
+		// Scaled by the largest distance so the dual points are around unit length, where the hull tolerance is meaningful.
+		TArray<FVector> DualPoints;
+		DualPoints.Reserve(Convex.Planes.Num());
+		for (int32 PlaneIndex = 0; PlaneIndex < Convex.Planes.Num(); ++PlaneIndex)
+		{
+			DualPoints.Add(Convex.Planes[PlaneIndex].GetNormal() * (MaxDistance / Distances[PlaneIndex]));
+		}
+
+		const FKzConvex Dual(DualPoints);
+
+		TArray<FVector> Corners;
+		Corners.Reserve(Dual.Planes.Num());
+		for (const FPlane& DualPlane : Dual.Planes)
+		{
+			if (DualPlane.W > UE_KINDA_SMALL_NUMBER)
+			{
+				Corners.Add(Center + DualPlane.GetNormal() * (MaxDistance / DualPlane.W));
+			}
+		}
+
+		return Corners;
+	}
+
+	/**
+	 * Pushes every face plane of a hull outwards by PlaneOffset(Normal) and rebuilds it. Flat hulls are first
+	 * thickened into a prism PlaneOffset(Normal) away from their plane on both sides, whose side faces are then
+	 * offset like those of a solid hull. Points and segments have no plane and are swept by the box with half size Extent.
+	 */
+	template <typename TPlaneOffset>
+	void InflateHull(FKzConvex& Convex, const FVector& Extent, TPlaneOffset&& PlaneOffset)
+	{
+		if (Convex.HasValidHull())
+		{
+			Convex.Vertices = OffsetHullFaces(Convex, PlaneOffset);
+			Convex.Build();
+			return;
+		}
+
+		const TArray<FVector> Vertices = MoveTemp(Convex.Vertices);
+		const double Tolerance = HullTolerance(Vertices);
+
+		// Plane through the first point, the point farthest from it, and the point farthest from their line.
+		const FVector& Origin = Vertices[0];
+		FVector Axis = FVector::ZeroVector;
+		for (const FVector& Vertex : Vertices)
+		{
+			if ((Vertex - Origin).SizeSquared() > Axis.SizeSquared())
+			{
+				Axis = Vertex - Origin;
+			}
+		}
+
+		FVector Normal = FVector::ZeroVector;
+		if (Axis.Size() > Tolerance)
+		{
+			const FVector Direction = Axis.GetUnsafeNormal();
+			double BestLineDist = Tolerance;
+			for (const FVector& Vertex : Vertices)
+			{
+				const FVector Cross = Direction ^ (Vertex - Origin);
+				const double LineDist = Cross.Size();
+				if (LineDist > BestLineDist)
+				{
+					BestLineDist = LineDist;
+					Normal = Cross / LineDist;
+				}
+			}
+		}
+
+		TArray<FVector> Points;
+		if (Normal.IsZero())
+		{
+			Points.Reserve(Vertices.Num() * 8);
+			for (const FVector& Vertex : Vertices)
+			{
+				for (int32 Corner = 0; Corner < 8; ++Corner)
+				{
+					Points.Add(Vertex + FVector((Corner & 1) ? Extent.X : -Extent.X, (Corner & 2) ? Extent.Y : -Extent.Y, (Corner & 4) ? Extent.Z : -Extent.Z));
+				}
+			}
+			Convex.Build(Points);
+			return;
+		}
+
+		const FVector NormalOffset = Normal * PlaneOffset(Normal);
+		Points.Reserve(Vertices.Num() * 2);
+		for (const FVector& Vertex : Vertices)
+		{
+			Points.Add(Vertex + NormalOffset);
+			Points.Add(Vertex - NormalOffset);
+		}
+		Convex.Build(Points);
+
+		// The caps are already in place, only the side faces still lie on the edges of the flat hull.
+		if (Convex.HasValidHull())
+		{
+			Convex.Vertices = OffsetHullFaces(Convex, [&](const FVector& FaceNormal)
+			{
+				return FMath::Abs(FaceNormal | Normal) > 1.0 - UE_KINDA_SMALL_NUMBER ? 0.0 : double(PlaneOffset(FaceNormal));
+			});
+			Convex.Build();
+		}
+	}
+
+	/**
+	 * Calls Func(A, B) once for every hull edge, skipping the edges between coplanar triangles
+	 * (eg. the diagonals of a box face) so only the silhouette of the hull faces is drawn.
+	 */
+	template <typename TFunc>
+	void ForEachFeatureEdge(const FKzConvex& Convex, TFunc&& Func)
+	{
+		const TArray<FVector>& Vertices = Convex.Vertices;
+		const TArray<int32>& Indices = Convex.Indices;
+		const int32 NumTriangles = Indices.Num() / 3;
+
+		auto TriangleNormal = [&](int32 Triangle)
+		{
+			const FVector& A = Vertices[Indices[Triangle * 3]];
+			return ((Vertices[Indices[Triangle * 3 + 1]] - A) ^ (Vertices[Indices[Triangle * 3 + 2]] - A)).GetSafeNormal();
+		};
+
+		TMap<uint64, int32> EdgeTriangles;
+		EdgeTriangles.Reserve(Indices.Num());
+		for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+		{
+			for (int32 Edge = 0; Edge < 3; ++Edge)
+			{
+				EdgeTriangles.Add(EdgeKey(Indices[Triangle * 3 + Edge], Indices[Triangle * 3 + (Edge + 1) % 3]), Triangle);
+			}
+		}
+
+		for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+		{
+			for (int32 Edge = 0; Edge < 3; ++Edge)
+			{
+				const int32 A = Indices[Triangle * 3 + Edge];
+				const int32 B = Indices[Triangle * 3 + (Edge + 1) % 3];
+				if (A > B)
+				{
+					continue;
+				}
+
+				const int32* Twin = EdgeTriangles.Find(EdgeKey(B, A));
+				if (Twin && (TriangleNormal(Triangle) | TriangleNormal(*Twin)) > 1.0 - UE_KINDA_SMALL_NUMBER)
+				{
+					continue;
+				}
+
+				Func(Vertices[A], Vertices[B]);
+			}
+		}
+	}
+}
+
+void FKzConvex::Build(TConstArrayView<FVector> Points)
+{
+	// Copied first, Points may view Vertices.
+	TArray<FVector> Input(Points.GetData(), Points.Num());
+
+	Vertices.Reset();
+	Indices.Reset();
+	Planes.Reset();
+	AdjacencyOffsets.Reset();
+	Adjacency.Reset();
+	SupportHint = 0;
+
+	const double Tolerance = HullTolerance(Input);
+
+	// Initial tetrahedron: the farthest pair of axis extremes, the point farthest from their line,
+	// and the point farthest from the plane of the three.
+	int32 Tetra[4] = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE };
+
+	if (Input.Num() >= 4)
+	{
+		int32 Extremes[6] = { 0, 0, 0, 0, 0, 0 };
+		for (int32 i = 1; i < Input.Num(); ++i)
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (Input[i][Axis] < Input[Extremes[Axis * 2]][Axis]) Extremes[Axis * 2] = i;
+				if (Input[i][Axis] > Input[Extremes[Axis * 2 + 1]][Axis]) Extremes[Axis * 2 + 1] = i;
+			}
+		}
+
+		double BestDistSq = 0.0;
+		for (int32 i = 0; i < 6; ++i)
+		{
+			for (int32 j = i + 1; j < 6; ++j)
+			{
+				const double DistSq = FVector::DistSquared(Input[Extremes[i]], Input[Extremes[j]]);
+				if (DistSq > BestDistSq)
+				{
+					BestDistSq = DistSq;
+					Tetra[0] = Extremes[i];
+					Tetra[1] = Extremes[j];
+				}
+			}
+		}
+
+		if (BestDistSq > FMath::Square(Tolerance))
+		{
+			const FVector P0 = Input[Tetra[0]];
+			const FVector Axis = (Input[Tetra[1]] - P0).GetSafeNormal();
+
+			double BestLineDist = Tolerance;
+			for (int32 i = 0; i < Input.Num(); ++i)
+			{
+				const double LineDist = ((Input[i] - P0) ^ Axis).Size();
+				if (LineDist > BestLineDist)
+				{
+					BestLineDist = LineDist;
+					Tetra[2] = i;
+				}
+			}
+
+			if (Tetra[2] != INDEX_NONE)
+			{
+				const FVector Normal = ((Input[Tetra[1]] - P0) ^ (Input[Tetra[2]] - P0)).GetSafeNormal();
+
+				double BestPlaneDist = Tolerance;
+				for (int32 i = 0; i < Input.Num(); ++i)
+				{
+					const double PlaneDist = FMath::Abs((Input[i] - P0) | Normal);
+					if (PlaneDist > BestPlaneDist)
+					{
+						BestPlaneDist = PlaneDist;
+						Tetra[3] = i;
+					}
+				}
+			}
+		}
+	}
+
+	if (Tetra[3] == INDEX_NONE)
+	{
+		// Flat or degenerate input: keep the distinct points, support queries scan them linearly.
+		for (const FVector& Point : Input)
+		{
+			if (!Vertices.ContainsByPredicate([&](const FVector& V) { return FVector::DistSquared(V, Point) <= FMath::Square(Tolerance); }))
+			{
+				Vertices.Add(Point);
+			}
+		}
+		AdjacencyOffsets.SetNumZeroed(Vertices.Num() + 1);
+		return;
+	}
+
+	const FVector Interior = (Input[Tetra[0]] + Input[Tetra[1]] + Input[Tetra[2]] + Input[Tetra[3]]) * 0.25;
+
+	FHullBuilder Hull(Input);
+	Hull.AddFaceFacingAway(Tetra[0], Tetra[1], Tetra[2], Interior);
+	Hull.AddFaceFacingAway(Tetra[0], Tetra[1], Tetra[3], Interior);
+	Hull.AddFaceFacingAway(Tetra[0], Tetra[2], Tetra[3], Interior);
+	Hull.AddFaceFacingAway(Tetra[1], Tetra[2], Tetra[3], Interior);
+
+	// Incremental hull: every point outside the hull replaces the faces it sees with a fan to their horizon.
+	// Farthest points first, so the hull grows quickly and few faces are replaced.
+	TArray<int32> Order;
+	Order.Reserve(Input.Num());
+	for (int32 PointIndex = 0; PointIndex < Input.Num(); ++PointIndex)
+	{
+		if (PointIndex != Tetra[0] && PointIndex != Tetra[1] && PointIndex != Tetra[2] && PointIndex != Tetra[3])
+		{
+			Order.Add(PointIndex);
+		}
+	}
+	Algo::SortBy(Order, [&](int32 PointIndex) { return -FVector::DistSquared(Input[PointIndex], Interior); });
+
+	TArray<int32> Visible;
+	TArray<int32> FaceStamps;
+	TArray<TPair<int32, int32>> Horizon;
+	TMap<int32, int32> HorizonNext;
+	int32 Stamp = 0;
+
+	// Points skipped as lying within tolerance of a face may end up outside once that face is replaced,
+	// so passes repeat until every point is inside.
+	constexpr int32 MaxPasses = 4;
+	for (int32 Pass = 0; Pass < MaxPasses; ++Pass)
+	{
+		bool bGrown = false;
+
+		for (int32 PointIndex : Order)
+		{
+			const FVector& Point = Input[PointIndex];
+
+			int32 FarthestFace = INDEX_NONE;
+			double FarthestDistance = Tolerance;
+			for (int32 FaceIndex = 0; FaceIndex < Hull.Faces.Num(); ++FaceIndex)
+			{
+				if (Hull.Faces[FaceIndex].bAlive)
+				{
+					const double Distance = Hull.GetDistance(FaceIndex, Point);
+					if (Distance > FarthestDistance)
+					{
+						FarthestDistance = Distance;
+						FarthestFace = FaceIndex;
+					}
+				}
+			}
+
+			if (FarthestFace == INDEX_NONE)
+			{
+				continue;
+			}
+
+			// Flood the visible region from the farthest face, so rounding never makes it disconnected.
+			++Stamp;
+			FaceStamps.SetNumZeroed(Hull.Faces.Num());
+			FaceStamps[FarthestFace] = Stamp;
+
+			Visible.Reset();
+			Visible.Add(FarthestFace);
+			Horizon.Reset();
+
+			for (int32 i = 0; i < Visible.Num(); ++i)
+			{
+				const FHullFace& Face = Hull.Faces[Visible[i]];
+				for (int32 Edge = 0; Edge < 3; ++Edge)
+				{
+					const int32 A = Face.V[Edge];
+					const int32 B = Face.V[(Edge + 1) % 3];
+					const int32 Twin = Hull.GetTwinFace(A, B);
+
+					if (Twin != INDEX_NONE && FaceStamps[Twin] == Stamp)
+					{
+						continue;
+					}
+
+					if (Twin != INDEX_NONE && Hull.GetDistance(Twin, Point) > 0.0)
+					{
+						FaceStamps[Twin] = Stamp;
+						Visible.Add(Twin);
+					}
+					else
+					{
+						Horizon.Emplace(A, B);
+					}
+				}
+			}
+
+			// The horizon must be a single loop, otherwise the fan would not close the hull. Such points are
+			// within rounding of the hull and are dropped.
+			HorizonNext.Reset();
+			for (const TPair<int32, int32>& Edge : Horizon)
+			{
+				HorizonNext.Add(Edge.Key, Edge.Value);
+			}
+
+			int32 LoopLength = 0;
+			if (HorizonNext.Num() == Horizon.Num() && Horizon.Num() >= 3)
+			{
+				int32 Vertex = Horizon[0].Key;
+				do
+				{
+					const int32* Next = HorizonNext.Find(Vertex);
+					Vertex = Next ? *Next : INDEX_NONE;
+					++LoopLength;
+				}
+				while (Vertex != INDEX_NONE && Vertex != Horizon[0].Key && LoopLength <= Horizon.Num());
+			}
+
+			if (LoopLength != Horizon.Num())
+			{
+				continue;
+			}
+
+			for (int32 FaceIndex : Visible)
+			{
+				Hull.RemoveFace(FaceIndex);
+			}
+
+			// Horizon edges keep the winding of the removed faces, so the fan faces outwards.
+			for (const TPair<int32, int32>& Edge : Horizon)
+			{
+				Hull.AddFace(Edge.Key, Edge.Value, PointIndex);
+			}
+
+			bGrown = true;
+		}
+
+		if (!bGrown)
+		{
+			break;
+		}
+	}
+
+	// Keep only the points on the hull.
+	TArray<int32> Remap;
+	Remap.Init(INDEX_NONE, Input.Num());
+
+	for (const FHullFace& Face : Hull.Faces)
+	{
+		if (!Face.bAlive)
+		{
+			continue;
+		}
+
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+		{
+			int32& Index = Remap[Face.V[Corner]];
+			if (Index == INDEX_NONE)
+			{
+				Index = Vertices.Add(Input[Face.V[Corner]]);
+			}
+			Indices.Add(Index);
+		}
+	}
+
+	// Vertex adjacency along the hull edges, flattened.
+	TArray<TArray<int32, TInlineAllocator<8>>> Neighbors;
+	Neighbors.SetNum(Vertices.Num());
+
+	for (int32 i = 0; i < Indices.Num(); i += 3)
+	{
+		for (int32 Edge = 0; Edge < 3; ++Edge)
+		{
+			const int32 A = Indices[i + Edge];
+			const int32 B = Indices[i + (Edge + 1) % 3];
+			Neighbors[A].AddUnique(B);
+			Neighbors[B].AddUnique(A);
+		}
+	}
+
+	AdjacencyOffsets.Reserve(Vertices.Num() + 1);
+	for (const auto& VertexNeighbors : Neighbors)
+	{
+		AdjacencyOffsets.Add(Adjacency.Num());
+		Adjacency.Append(VertexNeighbors);
+	}
+	AdjacencyOffsets.Add(Adjacency.Num());
+
+	BuildPlanes();
+}
+
+void FKzConvex::Build()
+{
+	Build(Vertices);
+}
+
+void FKzConvex::BuildPlanes()
+{
+	Planes.Reset();
+
+	const int32 NumTriangles = Indices.Num() / 3;
+	const double Tolerance = HullTolerance(Vertices);
+
+	auto TriangleNormal = [&](int32 Triangle)
+	{
+		const FVector& A = Vertices[Indices[Triangle * 3]];
+		return ((Vertices[Indices[Triangle * 3 + 1]] - A) ^ (Vertices[Indices[Triangle * 3 + 2]] - A)).GetSafeNormal();
+	};
+
+	TMap<uint64, int32> EdgeTriangles;
+	EdgeTriangles.Reserve(Indices.Num());
+	for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+	{
+		for (int32 Edge = 0; Edge < 3; ++Edge)
+		{
+			EdgeTriangles.Add(EdgeKey(Indices[Triangle * 3 + Edge], Indices[Triangle * 3 + (Edge + 1) % 3]), Triangle);
+		}
+	}
+
+	// Coplanar triangles of a hull face are connected through their shared edges, so each face is flooded
+	// from its first triangle instead of comparing every triangle against every plane found so far.
+	TArray<bool> Merged;
+	Merged.SetNumZeroed(NumTriangles);
+	TArray<int32> Pending;
+
+	for (int32 Seed = 0; Seed < NumTriangles; ++Seed)
+	{
+		if (Merged[Seed])
+		{
+			continue;
+		}
+		Merged[Seed] = true;
+
+		const FVector Normal = TriangleNormal(Seed);
+		if (Normal.IsZero())
+		{
+			continue;
+		}
+
+		const FPlane Plane(Vertices[Indices[Seed * 3]], Normal);
+		Planes.Add(Plane);
+
+		Pending.Reset();
+		Pending.Add(Seed);
+		while (Pending.Num() > 0)
+		{
+			const int32 Triangle = Pending.Pop(EAllowShrinking::No);
+			for (int32 Edge = 0; Edge < 3; ++Edge)
+			{
+				const int32* Twin = EdgeTriangles.Find(EdgeKey(Indices[Triangle * 3 + (Edge + 1) % 3], Indices[Triangle * 3 + Edge]));
+				if (!Twin || Merged[*Twin] || (TriangleNormal(*Twin) | Normal) <= 1.0 - UE_KINDA_SMALL_NUMBER)
+				{
+					continue;
+				}
+
+				// Checked against the seed plane, so a gently curved run of triangles is not merged into one face.
+				bool bCoplanar = true;
+				for (int32 Corner = 0; Corner < 3 && bCoplanar; ++Corner)
+				{
+					bCoplanar = FMath::Abs(Plane.PlaneDot(Vertices[Indices[*Twin * 3 + Corner]])) <= Tolerance;
+				}
+
+				if (bCoplanar)
+				{
+					Merged[*Twin] = true;
+					Pending.Add(*Twin);
+				}
+			}
+		}
+	}
+}
+
+FKzConvex FKzConvex::FromConvexElem(const FKConvexElem& ConvexElem)
+{
+	const FTransform ElemTransform = ConvexElem.GetTransform();
+
+	TArray<FVector> Points;
+	Points.Reserve(ConvexElem.VertexData.Num());
+	for (const FVector& Vertex : ConvexElem.VertexData)
+	{
+		Points.Add(ElemTransform.TransformPosition(Vertex));
+	}
+
+	return FKzConvex(Points);
+}
+
+void FKzConvex::FromAggregateGeom(const FKAggregateGeom& AggGeom, TArray<FKzConvex>& OutHulls)
+{
+	OutHulls.Reserve(OutHulls.Num() + AggGeom.ConvexElems.Num());
+
+	for (const FKConvexElem& ConvexElem : AggGeom.ConvexElems)
+	{
+		FKzConvex Hull = FromConvexElem(ConvexElem);
+		if (!Hull.IsZeroExtent())
+		{
+			OutHulls.Add(MoveTemp(Hull));
+		}
+	}
+}
+
+FVector FKzConvex::GetSupportPoint(const FVector& Direction) const
+{
+	const int32 NumVertices = Vertices.Num();
+	if (NumVertices == 0)
+	{
+		return FVector::ZeroVector;
+	}
+
+	if (NumVertices <= BruteForceSupportVertices || !HasValidHull())
+	{
+		int32 Best = 0;
+		double BestDot = Vertices[0] | Direction;
+		for (int32 i = 1; i < NumVertices; ++i)
+		{
+			const double Dot = Vertices[i] | Direction;
+			if (Dot > BestDot)
+			{
+				BestDot = Dot;
+				Best = i;
+			}
+		}
+		return Vertices[Best];
+	}
+
+	// Hill climb along the hull edges. On a convex polytope the first vertex without a better neighbor is the global maximum.
+	const int32 Hint = FPlatformAtomics::AtomicRead_Relaxed(&SupportHint);
+	int32 Best = (Hint >= 0 && Hint < NumVertices) ? Hint : 0;
+	double BestDot = Vertices[Best] | Direction;
+
+	for (bool bImproved = true; bImproved;)
+	{
+		bImproved = false;
+
+		const int32 First = AdjacencyOffsets[Best];
+		const int32 Last = AdjacencyOffsets[Best + 1];
+		for (int32 i = First; i < Last; ++i)
+		{
+			const int32 Neighbor = Adjacency[i];
+			const double Dot = Vertices[Neighbor] | Direction;
+			if (Dot > BestDot)
+			{
+				BestDot = Dot;
+				Best = Neighbor;
+				bImproved = true;
+			}
+		}
+	}
+
+	if (Best != Hint)
+	{
+		FPlatformAtomics::AtomicStore_Relaxed(&SupportHint, Best);
+	}
+
+	return Vertices[Best];
+}
+
+FBox FKzConvex::GetBoundingBox(const FVector& Center, const FQuat& Rotation) const
+{
+	if (Vertices.Num() == 0)
+	{
+		return FBox(Center, Center);
+	}
+
+	// Exact bounds: the hull extent along every world axis is one support query away.
+	FBox Bounds(ForceInit);
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		FVector WorldAxis = FVector::ZeroVector;
+		WorldAxis[Axis] = 1.0;
+
+		const FVector LocalAxis = Rotation.UnrotateVector(WorldAxis);
+		Bounds.Min[Axis] = Center[Axis] + (GetSupportPoint(-LocalAxis) | LocalAxis);
+		Bounds.Max[Axis] = Center[Axis] + (GetSupportPoint(LocalAxis) | LocalAxis);
+	}
+	Bounds.IsValid = 1;
+
+	return Bounds;
+}
+
+FVector FKzConvex::GetClosestPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const
+{
+	if (Vertices.Num() == 0)
+	{
+		return Center;
+	}
+
+	if (IntersectsPoint(Center, Rotation, Point))
+	{
+		return Point;
+	}
+
+	const FVector LocalPoint = Rotation.UnrotateVector(Point - Center);
+
+	FVector Best = Vertices[0];
+	double BestDistSq = FVector::DistSquared(Best, LocalPoint);
+
+	if (Indices.Num() > 0)
+	{
+		for (int32 i = 0; i < Indices.Num(); i += 3)
+		{
+			const FVector Candidate = FMath::ClosestPointOnTriangleToPoint(LocalPoint, Vertices[Indices[i]], Vertices[Indices[i + 1]], Vertices[Indices[i + 2]]);
+			const double DistSq = FVector::DistSquared(Candidate, LocalPoint);
+			if (DistSq < BestDistSq)
+			{
+				BestDistSq = DistSq;
+				Best = Candidate;
+			}
+		}
+	}
+	else
+	{
+		for (const FVector& Vertex : Vertices)
+		{
+			const double DistSq = FVector::DistSquared(Vertex, LocalPoint);
+			if (DistSq < BestDistSq)
+			{
+				BestDistSq = DistSq;
+				Best = Vertex;
+			}
+		}
+	}
+
+	return Center + Rotation.RotateVector(Best);
+}
+
+bool FKzConvex::IntersectsPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const
+{
+	if (!HasValidHull())
+	{
+		return false;
+	}
+
+	const FVector LocalPoint = Rotation.UnrotateVector(Point - Center);
+
+	for (const FPlane& Plane : Planes)
+	{
+		if (Plane.PlaneDot(LocalPoint) > UE_KINDA_SMALL_NUMBER)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FCollisionShape FKzConvex::ToCollisionShape(float Inflation) const
+{
+	// Engine shapes are centered, use the box around the origin that encloses the hull.
+	const FBox LocalBounds = GetBoundingBox(FVector::ZeroVector, FQuat::Identity);
+	return FCollisionShape::MakeBox(FVector::Max(LocalBounds.Min.GetAbs(), LocalBounds.Max.GetAbs()) + Inflation);
+}
+
+void FKzConvex::Inflate(float Inflation)
+{
+	if (Vertices.Num() > 0)
+	{
+		InflateHull(*this, FVector(Inflation), [Inflation](const FVector&) { return double(Inflation); });
+	}
+}
+
+void FKzConvex::Inflate(const FVector& Inflation)
+{
+	if (Vertices.Num() > 0)
+	{
+		// Support distance of the box with half size Inflation along the face normal.
+		InflateHull(*this, Inflation, [&Inflation](const FVector& Normal) { return Normal.GetAbs() | Inflation; });
+	}
+}
+
+void FKzConvex::Scale(const FVector& Scale)
+{
+	for (FVector& Vertex : Vertices)
+	{
+		Vertex *= Scale;
+	}
+
+	if (!HasValidHull() || FMath::Abs(Scale.X * Scale.Y * Scale.Z) < UE_SMALL_NUMBER)
+	{
+		Build();
+		return;
+	}
+
+	// A linear map keeps the hull topology and adjacency, only mirroring flips the winding.
+	if (Scale.X * Scale.Y * Scale.Z < 0.0)
+	{
+		for (int32 i = 0; i + 2 < Indices.Num(); i += 3)
+		{
+			Swap(Indices[i + 1], Indices[i + 2]);
+		}
+	}
+
+	BuildPlanes();
+}
+
+bool FKzConvex::Raycast(FKzHitResult& OutHit, const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+{
+	if (MaxDistance <= 0.0f)
+	{
+		MaxDistance = UE_BIG_NUMBER;
+	}
+
+	OutHit.Reset(1.f, false);
+	OutHit.TraceStart = RayStart;
+	OutHit.TraceEnd = RayStart + RayDir * MaxDistance;
+
+	if (!HasValidHull())
+	{
+		return false;
+	}
+
+	const FVector O = Rotation.UnrotateVector(RayStart - Center);
+	const FVector D = Rotation.UnrotateVector(RayDir);
+
+	// Clip the ray against every face plane (Cyrus-Beck).
+	double TEnter = 0.0;
+	double TExit = MaxDistance;
+	int32 EnterPlane = INDEX_NONE;
+
+	for (int32 i = 0; i < Planes.Num(); ++i)
+	{
+		const FPlane& Plane = Planes[i];
+		const double Dist = Plane.PlaneDot(O);
+		const double Denom = Plane.GetNormal() | D;
+
+		if (FMath::Abs(Denom) < UE_SMALL_NUMBER)
+		{
+			// Parallel to the plane: outside it means no hit.
+			if (Dist > 0.0)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		const double T = -Dist / Denom;
+		if (Denom < 0.0)
+		{
+			if (T > TEnter)
+			{
+				TEnter = T;
+				EnterPlane = i;
+			}
+		}
+		else
+		{
+			TExit = FMath::Min(TExit, T);
+		}
+
+		if (TEnter > TExit)
+		{
+			return false;
+		}
+	}
+
+	OutHit.bBlockingHit = true;
+
+	if (EnterPlane == INDEX_NONE)
+	{
+		// Starts inside the hull.
+		OutHit.bStartPenetrating = true;
+		OutHit.Location = RayStart;
+		OutHit.Normal = -RayDir;
+		OutHit.Time = 0.0f;
+		OutHit.Distance = 0.0f;
+		return true;
+	}
+
+	OutHit.Distance = TEnter;
+	OutHit.Time = TEnter / MaxDistance;
+	OutHit.Location = RayStart + RayDir * TEnter;
+	OutHit.Normal = Rotation.RotateVector(Planes[EnterPlane].GetNormal());
+
+	return true;
+}
+
+void FKzConvex::DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
+{
+	ForEachFeatureEdge(*this, [&](const FVector& A, const FVector& B)
+	{
+		DrawDebugLine(InWorld, Center + Rotation.RotateVector(A), Center + Rotation.RotateVector(B), Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+	});
+}
+
+void FKzConvex::DrawSceneProxy(FPrimitiveDrawInterface* PDI, const FMatrix& LocalToWorld, const FLinearColor& Color, bool bDrawSolid, float Thickness, int32 ViewIndex, FMeshElementCollector& Collector) const
+{
+	ForEachFeatureEdge(*this, [&](const FVector& A, const FVector& B)
+	{
+		PDI->DrawLine(LocalToWorld.TransformPosition(A), LocalToWorld.TransformPosition(B), Color, SDPG_World, Thickness);
+	});
+
+	if (bDrawSolid && Indices.Num() > 0)
+	{
+		const FLinearColor SolidColor = FLinearColor(Color.R, Color.G, Color.B, 0.2f);
+		const FColor VertexColor = SolidColor.ToFColor(true);
+
+		// Flat shaded: every triangle gets its own vertices.
+		FDynamicMeshBuilder MeshBuilder(Collector.GetFeatureLevel());
+		for (int32 i = 0; i + 2 < Indices.Num(); i += 3)
+		{
+			const FVector3f A = FVector3f(Vertices[Indices[i]]);
+			const FVector3f B = FVector3f(Vertices[Indices[i + 1]]);
+			const FVector3f C = FVector3f(Vertices[Indices[i + 2]]);
+
+			const FVector3f Normal = ((B - A) ^ (C - A)).GetSafeNormal();
+			FVector3f TangentX, TangentY;
+			Normal.FindBestAxisVectors(TangentX, TangentY);
+
+			const int32 First = MeshBuilder.AddVertex(FDynamicMeshVertex(A, TangentX, Normal, FVector2f::ZeroVector, VertexColor));
+			MeshBuilder.AddVertex(FDynamicMeshVertex(B, TangentX, Normal, FVector2f::ZeroVector, VertexColor));
+			MeshBuilder.AddVertex(FDynamicMeshVertex(C, TangentX, Normal, FVector2f::ZeroVector, VertexColor));
+			MeshBuilder.AddTriangle(First, First + 1, First + 2);
+		}
+
+		FMaterialRenderProxy* const MaterialRenderProxy = new FColoredMaterialRenderProxy(GEngine->DebugMeshMaterial->GetRenderProxy(), SolidColor);
+		MeshBuilder.GetMesh(LocalToWorld, MaterialRenderProxy, SDPG_World, true, false, ViewIndex, Collector);
+	}
+}
\ No newline at end of file
@@ -29,6 +29,11 @@ bool FKzCylinder::Raycast(FKzHitResult& OutHit, const FVector& Center, const FQu
 	return Kz::Raycast::Cylinder(OutHit, Center, Rotation, Radius, HalfHeight, RayStart, RayDir, MaxDistance);
 }
 
+bool FKzCylinder::RaycastTest(const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+{
+	return Kz::Raycast::Cylinder(Center, Rotation, Radius, HalfHeight, RayStart, RayDir, MaxDistance);
+}
+
 void FKzCylinder::DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
 {
 	const FVector UpVector = Rotation.GetUpVector();
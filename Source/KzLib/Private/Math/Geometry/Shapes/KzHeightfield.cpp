@@ -0,0 +1,736 @@
+// Copyright 2026 kirzo
+
+#include "Math/Geometry/Shapes/KzHeightfield.h"
+#include "Math/Geometry/KzShapeInstance.h"
+#include "Collision/KzHitResult.h"
+#include "Collision/KzGJK.h"
+#include "Algo/Sort.h"
+#include "Engine/Texture2D.h"
+#include "Engine/Engine.h"
+#include "Materials/Material.h"
+#include "DrawDebugHelpers.h"
+#include "DynamicMeshBuilder.h"
+#include "PrimitiveDrawingUtils.h"
+#include "Materials/MaterialRenderProxy.h"
+
+namespace
+{
+	/** Two-sided Möller–Trumbore. */
+	bool RayTriangle(const FVector& Origin, const FVector& Dir, const FVector& A, const FVector& B, const FVector& C, double& OutT)
+	{
+		const FVector E1 = B - A;
+		const FVector E2 = C - A;
+
+		const FVector P = Dir ^ E2;
+		const double Det = E1 | P;
+		if (FMath::Abs(Det) <= UE_DOUBLE_SMALL_NUMBER)
+		{
+			return false;
+		}
+
+		const double InvDet = 1.0 / Det;
+		const FVector T = Origin - A;
+		const double U = (T | P) * InvDet;
+		if (U < 0.0 || U > 1.0)
+		{
+			return false;
+		}
+
+		const FVector Q = T ^ E1;
+		const double V = (Dir | Q) * InvDet;
+		if (V < 0.0 || U + V > 1.0)
+		{
+			return false;
+		}
+
+		OutT = (E2 | Q) * InvDet;
+		return OutT >= 0.0;
+	}
+
+	/** Farthest vertex of a triangle along a direction. */
+	FORCEINLINE FVector TriangleSupport(const FVector& V0, const FVector& V1, const FVector& V2, const FVector& Dir)
+	{
+		const double D0 = V0 | Dir;
+		const double D1 = V1 | Dir;
+		const double D2 = V2 | Dir;
+		return D0 >= D1 ? (D0 >= D2 ? V0 : V2) : (D1 >= D2 ? V1 : V2);
+	}
+
+	/**
+	 * GJK between a convex support function and the triangles of the cells under its bounds, both in local space.
+	 * Support(Dir) returns the farthest point of the convex along Dir.
+	 */
+	template <typename TSupport>
+	bool IntersectsSupport(const FKzHeightfield& Heightfield, const FBox& LocalBounds, TSupport&& Support)
+	{
+		bool bIntersects = false;
+		Heightfield.ForEachTriangle(LocalBounds, [&](const FVector& V0, const FVector& V1, const FVector& V2)
+		{
+			// Minkowski difference triangle - convex.
+			bIntersects = Kz::GJK::Internal::Intersect([&](const FVector& Dir)
+			{
+				return TriangleSupport(V0, V1, V2, Dir) - Support(-Dir);
+			}, 20);
+
+			return !bIntersects;
+		});
+
+		return bIntersects;
+	}
+
+	/** Largest projection of a box onto a direction. */
+	FORCEINLINE double BoxSupport(const FBox& Box, const FVector& Dir)
+	{
+		return FMath::Max(Box.Min.X * Dir.X, Box.Max.X * Dir.X)
+			+ FMath::Max(Box.Min.Y * Dir.Y, Box.Max.Y * Dir.Y)
+			+ FMath::Max(Box.Min.Z * Dir.Z, Box.Max.Z * Dir.Z);
+	}
+
+	/** Converts pixels to heights. 8-bit values are expanded to the full 16-bit range. */
+	TArray<uint16> ReadHeights(const uint8* Data, int32 NumPixels, int32 BytesPerPixel, int32 ChannelOffset, bool b16Bit)
+	{
+		TArray<uint16> Heights;
+		Heights.SetNumUninitialized(NumPixels);
+		for (int32 i = 0; i < NumPixels; ++i)
+		{
+			const uint8* Pixel = Data + (int64)i * BytesPerPixel + ChannelOffset;
+			if (b16Bit)
+			{
+				FMemory::Memcpy(&Heights[i], Pixel, sizeof(uint16));
+			}
+			else
+			{
+				Heights[i] = *Pixel * 257;
+			}
+		}
+		return Heights;
+	}
+}
+
+TSharedRef<const FKzHeightfieldData> FKzHeightfieldData::Build(int32 InSizeX, int32 InSizeY, TArray<uint16> InHeights)
+{
+	TSharedRef<FKzHeightfieldData> Data = MakeShared<FKzHeightfieldData>();
+
+	if (InSizeX < 2 || InSizeY < 2 || InHeights.Num() != InSizeX * InSizeY)
+	{
+		return Data;
+	}
+
+	Data->SizeX = InSizeX;
+	Data->SizeY = InSizeY;
+	Data->Heights = MoveTemp(InHeights);
+
+	// Level 0: one block per cell, over its four samples.
+	const int32 CellsX = Data->SizeX - 1;
+	const int32 CellsY = Data->SizeY - 1;
+
+	Data->MipOffsets.Add(0);
+	Data->MipMin.SetNumUninitialized(CellsX * CellsY);
+	Data->MipMax.SetNumUninitialized(CellsX * CellsY);
+
+	for (int32 Y = 0; Y < CellsY; ++Y)
+	{
+		for (int32 X = 0; X < CellsX; ++X)
+		{
+			const uint16 H00 = Data->Heights[Y * Data->SizeX + X];
+			const uint16 H10 = Data->Heights[Y * Data->SizeX + X + 1];
+			const uint16 H01 = Data->Heights[(Y + 1) * Data->SizeX + X];
+			const uint16 H11 = Data->Heights[(Y + 1) * Data->SizeX + X + 1];
+
+			Data->MipMin[Y * CellsX + X] = FMath::Min(FMath::Min(H00, H10), FMath::Min(H01, H11));
+			Data->MipMax[Y * CellsX + X] = FMath::Max(FMath::Max(H00, H10), FMath::Max(H01, H11));
+		}
+	}
+
+	// Every other level merges 2x2 blocks of the previous one, until a single block covers the grid.
+	for (int32 Level = 1; Data->GetLevelSizeX(Level - 1) > 1 || Data->GetLevelSizeY(Level - 1) > 1; ++Level)
+	{
+		const int32 PrevSizeX = Data->GetLevelSizeX(Level - 1);
+		const int32 PrevSizeY = Data->GetLevelSizeY(Level - 1);
+		const int32 PrevOffset = Data->MipOffsets.Last();
+		const int32 LevelSizeX = Data->GetLevelSizeX(Level);
+		const int32 LevelSizeY = Data->GetLevelSizeY(Level);
+
+		Data->MipOffsets.Add(Data->MipMin.Num());
+		for (int32 Y = 0; Y < LevelSizeY; ++Y)
+		{
+			for (int32 X = 0; X < LevelSizeX; ++X)
+			{
+				uint16 Min = MAX_uint16;
+				uint16 Max = 0;
+				for (int32 ChildY = Y * 2; ChildY < FMath::Min(Y * 2 + 2, PrevSizeY); ++ChildY)
+				{
+					for (int32 ChildX = X * 2; ChildX < FMath::Min(X * 2 + 2, PrevSizeX); ++ChildX)
+					{
+						Min = FMath::Min(Min, Data->MipMin[PrevOffset + ChildY * PrevSizeX + ChildX]);
+						Max = FMath::Max(Max, Data->MipMax[PrevOffset + ChildY * PrevSizeX + ChildX]);
+					}
+				}
+				Data->MipMin.Add(Min);
+				Data->MipMax.Add(Max);
+			}
+		}
+	}
+
+	return Data;
+}
+
+void FKzHeightfieldData::Serialize(FArchive& Ar)
+{
+	Ar << SizeX;
+	Ar << SizeY;
+	Ar << Heights;
+	Ar << MipMin;
+	Ar << MipMax;
+	Ar << MipOffsets;
+}
+
+bool FKzHeightfield::Serialize(FArchive& Ar)
+{
+	Ar << GridScale;
+
+	bool bHasHeightData = HeightData.IsValid();
+	Ar << bHasHeightData;
+
+	if (Ar.IsLoading())
+	{
+		if (bHasHeightData)
+		{
+			TSharedRef<FKzHeightfieldData> Data = MakeShared<FKzHeightfieldData>();
+			Data->Serialize(Ar);
+			HeightData = Data;
+		}
+		else
+		{
+			HeightData.Reset();
+		}
+	}
+	else if (bHasHeightData)
+	{
+		// Saving only reads the data, which may be shared with other shapes.
+		const_cast<FKzHeightfieldData&>(*HeightData).Serialize(Ar);
+	}
+
+	return true;
+}
+
+FBox FKzHeightfield::GetBlockBounds(int32 Level, int32 BlockX, int32 BlockY) const
+{
+	const FKzHeightfieldData& Data = *HeightData;
+	const int32 Block = Data.GetBlockIndex(Level, BlockX, BlockY);
+	const FVector A(BlockX << Level, BlockY << Level, Data.MipMin[Block] - HeightOffset);
+	const FVector B(FMath::Min((BlockX + 1) << Level, Data.SizeX - 1), FMath::Min((BlockY + 1) << Level, Data.SizeY - 1), Data.MipMax[Block] - HeightOffset);
+	return FBox((A * GridScale).ComponentMin(B * GridScale), (A * GridScale).ComponentMax(B * GridScale));
+}
+
+FKzHeightfield FKzHeightfield::FromTexture(UTexture2D* Texture, const FVector& InGridScale)
+{
+	if (!Texture)
+	{
+		return FKzHeightfield();
+	}
+
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray<uint16> Heights;
+
+#if WITH_EDITORONLY_DATA
+	if (Texture->Source.IsValid())
+	{
+		TArray64<uint8> MipData;
+		if (Texture->Source.GetMipData(MipData, 0))
+		{
+			Width = Texture->Source.GetSizeX();
+			Height = Texture->Source.GetSizeY();
+
+			switch (Texture->Source.GetFormat())
+			{
+			case TSF_G16:    Heights = ReadHeights(MipData.GetData(), Width * Height, 2, 0, true); break;
+			case TSF_RGBA16: Heights = ReadHeights(MipData.GetData(), Width * Height, 8, 0, true); break;
+			case TSF_G8:     Heights = ReadHeights(MipData.GetData(), Width * Height, 1, 0, false); break;
+			case TSF_BGRA8:  Heights = ReadHeights(MipData.GetData(), Width * Height, 4, 2, false); break;
+			default: break;
+			}
+		}
+	}
+#endif
+
+	if (Heights.Num() == 0)
+	{
+		const FTexturePlatformData* PlatformData = Texture->GetPlatformData();
+		if (PlatformData && PlatformData->Mips.Num() > 0)
+		{
+			const FTexture2DMipMap& Mip = PlatformData->Mips[0];
+			if (const uint8* Data = static_cast<const uint8*>(Mip.BulkData.LockReadOnly()))
+			{
+				Width = Mip.SizeX;
+				Height = Mip.SizeY;
+
+				switch (PlatformData->PixelFormat)
+				{
+				case PF_G16:        Heights = ReadHeights(Data, Width * Height, 2, 0, true); break;
+				case PF_G8:         Heights = ReadHeights(Data, Width * Height, 1, 0, false); break;
+				case PF_B8G8R8A8:   Heights = ReadHeights(Data, Width * Height, 4, 2, false); break;
+				case PF_R8G8B8A8:   Heights = ReadHeights(Data, Width * Height, 4, 0, false); break;
+				default: break;
+				}
+
+				Mip.BulkData.Unlock();
+			}
+		}
+	}
+
+	if (Heights.Num() == 0)
+	{
+		return FKzHeightfield();
+	}
+
+	return FKzHeightfield(Width, Height, MoveTemp(Heights), InGridScale);
+}
+
+bool FKzHeightfield::IntersectsShape(const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FVector& Center, const FQuat& Rotation) const
+{
+	if (IsZeroExtent() || !Shape.IsValid())
+	{
+		return false;
+	}
+
+	// Shape transform relative to the heightfield.
+	const FVector LocalPosition = Rotation.UnrotateVector(ShapePosition - Center);
+	const FQuat LocalRotation = Rotation.Inverse() * ShapeRotation;
+
+	return IntersectsSupport(*this, Shape.GetBoundingBox(LocalPosition, LocalRotation), [&](const FVector& Dir)
+	{
+		return LocalPosition + LocalRotation.RotateVector(Shape.GetSupportPoint(LocalRotation.UnrotateVector(Dir)));
+	});
+}
+
+bool FKzHeightfield::IntersectsTriangle(const FVector& V0, const FVector& V1, const FVector& V2, const FVector& Center, const FQuat& Rotation) const
+{
+	if (IsZeroExtent())
+	{
+		return false;
+	}
+
+	// Triangle relative to the heightfield.
+	const FVector L0 = Rotation.UnrotateVector(V0 - Center);
+	const FVector L1 = Rotation.UnrotateVector(V1 - Center);
+	const FVector L2 = Rotation.UnrotateVector(V2 - Center);
+
+	FBox LocalBounds(L0, L0);
+	LocalBounds += L1;
+	LocalBounds += L2;
+
+	return IntersectsSupport(*this, LocalBounds, [&](const FVector& Dir)
+	{
+		return TriangleSupport(L0, L1, L2, Dir);
+	});
+}
+
+FBox FKzHeightfield::GetBoundingBox(const FVector& Center, const FQuat& Rotation) const
+{
+	if (IsZeroExtent())
+	{
+		return FBox(Center, Center);
+	}
+
+	const FBox LocalBounds = GetBlockBounds(HeightData->GetTopLevel(), 0, 0);
+
+	FBox Bounds(ForceInit);
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const FVector Point((Corner & 1) ? LocalBounds.Max.X : LocalBounds.Min.X, (Corner & 2) ? LocalBounds.Max.Y : LocalBounds.Min.Y, (Corner & 4) ? LocalBounds.Max.Z : LocalBounds.Min.Z);
+		Bounds += Center + Rotation.RotateVector(Point);
+	}
+	return Bounds;
+}
+
+FVector FKzHeightfield::GetClosestPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const
+{
+	if (IsZeroExtent())
+	{
+		return Center;
+	}
+
+	const FKzHeightfieldData& Data = *HeightData;
+
+	const FVector LocalPoint = Rotation.UnrotateVector(Point - Center);
+
+	// Best-first descent of the mip pyramid, pruning blocks farther than the closest point found so far.
+	FVector Best = LocalPoint;
+	double BestDistSq = TNumericLimits<double>::Max();
+
+	TArray<FIntVector, TInlineAllocator<128>> Stack;
+	Stack.Emplace(Data.GetTopLevel(), 0, 0);
+
+	while (Stack.Num() > 0)
+	{
+		const FIntVector Block = Stack.Pop(EAllowShrinking::No);
+		if (GetBlockBounds(Block.X, Block.Y, Block.Z).ComputeSquaredDistanceToPoint(LocalPoint) >= BestDistSq)
+		{
+			continue;
+		}
+
+		if (Block.X == 0)
+		{
+			const int32 X = Block.Y;
+			const int32 Y = Block.Z;
+			const FVector P00 = FVector(X, Y, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X, Y));
+			const FVector P10 = FVector(X + 1, Y, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X + 1, Y));
+			const FVector P01 = FVector(X, Y + 1, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X, Y + 1));
+			const FVector P11 = FVector(X + 1, Y + 1, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X + 1, Y + 1));
+
+			for (const FVector& Candidate : { FMath::ClosestPointOnTriangleToPoint(LocalPoint, P00, P10, P11), FMath::ClosestPointOnTriangleToPoint(LocalPoint, P00, P11, P01) })
+			{
+				const double DistSq = FVector::DistSquared(Candidate, LocalPoint);
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					Best = Candidate;
+				}
+			}
+			continue;
+		}
+
+		// Push the children farthest first, so the nearest one is visited next.
+		const int32 ChildLevel = Block.X - 1;
+		TPair<double, FIntVector> Children[4];
+		int32 NumChildren = 0;
+		for (int32 ChildY = Block.Z * 2; ChildY < FMath::Min(Block.Z * 2 + 2, Data.GetLevelSizeY(ChildLevel)); ++ChildY)
+		{
+			for (int32 ChildX = Block.Y * 2; ChildX < FMath::Min(Block.Y * 2 + 2, Data.GetLevelSizeX(ChildLevel)); ++ChildX)
+			{
+				const double DistSq = GetBlockBounds(ChildLevel, ChildX, ChildY).ComputeSquaredDistanceToPoint(LocalPoint);
+				Children[NumChildren++] = TPair<double, FIntVector>(DistSq, FIntVector(ChildLevel, ChildX, ChildY));
+			}
+		}
+
+		Algo::SortBy(TArrayView<TPair<double, FIntVector>>(Children, NumChildren), [](const TPair<double, FIntVector>& Child) { return -Child.Key; });
+		for (int32 i = 0; i < NumChildren; ++i)
+		{
+			Stack.Add(Children[i].Value);
+		}
+	}
+
+	return Center + Rotation.RotateVector(Best);
+}
+
+bool FKzHeightfield::IntersectsPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const
+{
+	return !IsZeroExtent() && FVector::DistSquared(GetClosestPoint(Center, Rotation, Point), Point) <= FMath::Square(UE_KINDA_SMALL_NUMBER);
+}
+
+FCollisionShape FKzHeightfield::ToCollisionShape(float Inflation) const
+{
+	// Engine shapes are centered, use the box around the origin that encloses the grid.
+	const FBox LocalBounds = GetBoundingBox(FVector::ZeroVector, FQuat::Identity);
+	return FCollisionShape::MakeBox(FVector::Max(LocalBounds.Min.GetAbs(), LocalBounds.Max.GetAbs()) + Inflation);
+}
+
+FVector FKzHeightfield::GetSupportPoint(const FVector& Direction) const
+{
+	if (IsZeroExtent())
+	{
+		return FVector::ZeroVector;
+	}
+
+	const FKzHeightfieldData& Data = *HeightData;
+
+	// Branch and bound on the block supports.
+	FVector Best = FVector(0.0, 0.0, GetHeight(0, 0));
+	double BestDot = Best | Direction;
+
+	TArray<FIntVector, TInlineAllocator<128>> Stack;
+	Stack.Emplace(Data.GetTopLevel(), 0, 0);
+
+	while (Stack.Num() > 0)
+	{
+		const FIntVector Block = Stack.Pop(EAllowShrinking::No);
+		if (BoxSupport(GetBlockBounds(Block.X, Block.Y, Block.Z), Direction) <= BestDot)
+		{
+			continue;
+		}
+
+		if (Block.X == 0)
+		{
+			for (int32 Corner = 0; Corner < 4; ++Corner)
+			{
+				const int32 X = Block.Y + (Corner & 1);
+				const int32 Y = Block.Z + (Corner >> 1);
+				const FVector Vertex = FVector(X, Y, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X, Y));
+				const double Dot = Vertex | Direction;
+				if (Dot > BestDot)
+				{
+					BestDot = Dot;
+					Best = Vertex;
+				}
+			}
+			continue;
+		}
+
+		const int32 ChildLevel = Block.X - 1;
+		for (int32 ChildY = Block.Z * 2; ChildY < FMath::Min(Block.Z * 2 + 2, Data.GetLevelSizeY(ChildLevel)); ++ChildY)
+		{
+			for (int32 ChildX = Block.Y * 2; ChildX < FMath::Min(Block.Y * 2 + 2, Data.GetLevelSizeX(ChildLevel)); ++ChildX)
+			{
+				Stack.Emplace(ChildLevel, ChildX, ChildY);
+			}
+		}
+	}
+
+	return Best;
+}
+
+bool FKzHeightfield::Raycast(FKzHitResult& OutHit, const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+{
+	if (MaxDistance <= 0.0f)
+	{
+		MaxDistance = UE_BIG_NUMBER;
+	}
+
+	OutHit.Reset(1.f, false);
+	OutHit.TraceStart = RayStart;
+	OutHit.TraceEnd = RayStart + RayDir * MaxDistance;
+
+	if (IsZeroExtent())
+	{
+		return false;
+	}
+
+	const FKzHeightfieldData& Data = *HeightData;
+
+	// Into grid space, where cells are unit squares and Z is in height steps. The mapping is affine, so ray distances are preserved.
+	const FVector InvScale(1.0 / GridScale.X, 1.0 / GridScale.Y, 1.0 / GridScale.Z);
+	const FVector Origin = Rotation.UnrotateVector(RayStart - Center) * InvScale + FVector(0.0, 0.0, HeightOffset);
+	const FVector Dir = Rotation.UnrotateVector(RayDir) * InvScale;
+
+	const int32 CellsX = Data.SizeX - 1;
+	const int32 CellsY = Data.SizeY - 1;
+	const int32 TopLevel = Data.GetTopLevel();
+
+	// Clip the ray against the grid bounds.
+	const FVector BoundsMin(0.0, 0.0, Data.MipMin[Data.MipOffsets[TopLevel]]);
+	const FVector BoundsMax(CellsX, CellsY, Data.MipMax[Data.MipOffsets[TopLevel]]);
+
+	double TMin = 0.0;
+	double TMax = MaxDistance;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		if (FMath::Abs(Dir[Axis]) <= UE_DOUBLE_SMALL_NUMBER)
+		{
+			if (Origin[Axis] < BoundsMin[Axis] || Origin[Axis] > BoundsMax[Axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		double T1 = (BoundsMin[Axis] - Origin[Axis]) / Dir[Axis];
+		double T2 = (BoundsMax[Axis] - Origin[Axis]) / Dir[Axis];
+		if (T1 > T2)
+		{
+			Swap(T1, T2);
+		}
+
+		TMin = FMath::Max(TMin, T1);
+		TMax = FMath::Min(TMax, T2);
+		if (TMin > TMax)
+		{
+			return false;
+		}
+	}
+
+	// 2D DDA over the cells. At every step, the coarsest block around the current cell that the ray
+	// passes entirely above or below is skipped at once; cells that pass all levels test their triangles.
+	const FVector Entry = Origin + Dir * TMin;
+	int32 CellX = FMath::Clamp(FMath::FloorToInt32(Entry.X), 0, CellsX - 1);
+	int32 CellY = FMath::Clamp(FMath::FloorToInt32(Entry.Y), 0, CellsY - 1);
+	double T = TMin;
+
+	double HitT = TNumericLimits<double>::Max();
+	FVector HitNormal = FVector::ZeroVector;
+
+	for (;;)
+	{
+		for (int32 Level = TopLevel; Level >= 0; --Level)
+		{
+			const int32 BlockX = CellX >> Level;
+			const int32 BlockY = CellY >> Level;
+			const int32 LoX = BlockX << Level;
+			const int32 LoY = BlockY << Level;
+			const int32 HiX = FMath::Min((BlockX + 1) << Level, CellsX);
+			const int32 HiY = FMath::Min((BlockY + 1) << Level, CellsY);
+
+			const double ExitX = Dir.X > UE_DOUBLE_SMALL_NUMBER ? (HiX - Origin.X) / Dir.X : (Dir.X < -UE_DOUBLE_SMALL_NUMBER ? (LoX - Origin.X) / Dir.X : TNumericLimits<double>::Max());
+			const double ExitY = Dir.Y > UE_DOUBLE_SMALL_NUMBER ? (HiY - Origin.Y) / Dir.Y : (Dir.Y < -UE_DOUBLE_SMALL_NUMBER ? (LoY - Origin.Y) / Dir.Y : TNumericLimits<double>::Max());
+			const double TExit = FMath::Min3(ExitX, ExitY, TMax);
+
+			const int32 Block = Data.GetBlockIndex(Level, BlockX, BlockY);
+			const double Z0 = Origin.Z + Dir.Z * T;
+			const double Z1 = Origin.Z + Dir.Z * TExit;
+			const bool bOverlaps = FMath::Max(Z0, Z1) >= Data.MipMin[Block] && FMath::Min(Z0, Z1) <= Data.MipMax[Block];
+
+			if (bOverlaps && Level > 0)
+			{
+				continue;
+			}
+
+			if (bOverlaps)
+			{
+				const FVector P00(CellX, CellY, Data.GetSample(CellX, CellY));
+				const FVector P10(CellX + 1, CellY, Data.GetSample(CellX + 1, CellY));
+				const FVector P01(CellX, CellY + 1, Data.GetSample(CellX, CellY + 1));
+				const FVector P11(CellX + 1, CellY + 1, Data.GetSample(CellX + 1, CellY + 1));
+
+				double TriangleT;
+				if (RayTriangle(Origin, Dir, P00, P10, P11, TriangleT) && TriangleT <= MaxDistance && TriangleT < HitT)
+				{
+					HitT = TriangleT;
+					HitNormal = (P10 - P00) ^ (P11 - P00);
+				}
+				if (RayTriangle(Origin, Dir, P00, P11, P01, TriangleT) && TriangleT <= MaxDistance && TriangleT < HitT)
+				{
+					HitT = TriangleT;
+					HitNormal = (P11 - P00) ^ (P01 - P00);
+				}
+
+				// Cells are visited in ray order, so the first cell with a hit holds the closest one.
+				if (HitT != TNumericLimits<double>::Max())
+				{
+					// Normals transform with the inverse scale, and face the ray since the surface is two-sided.
+					FVector Normal = Rotation.RotateVector((HitNormal * InvScale).GetSafeNormal());
+					if ((Normal | RayDir) > 0.0)
+					{
+						Normal = -Normal;
+					}
+
+					OutHit.bBlockingHit = true;
+					OutHit.Distance = HitT;
+					OutHit.Time = HitT / MaxDistance;
+					OutHit.Location = RayStart + RayDir * HitT;
+					OutHit.Normal = Normal;
+					return true;
+				}
+			}
+
+			// Step past the block.
+			if (TExit >= TMax)
+			{
+				return false;
+			}
+
+			T = TExit;
+			CellX = ExitX <= TExit ? (Dir.X > 0.0 ? HiX : LoX - 1) : FMath::Clamp(FMath::FloorToInt32(Origin.X + Dir.X * T), LoX, HiX - 1);
+			CellY = ExitY <= TExit ? (Dir.Y > 0.0 ? HiY : LoY - 1) : FMath::Clamp(FMath::FloorToInt32(Origin.Y + Dir.Y * T), LoY, HiY - 1);
+			if (CellX < 0 || CellX >= CellsX || CellY < 0 || CellY >= CellsY)
+			{
+				return false;
+			}
+			break;
+		}
+	}
+}
+
+void FKzHeightfield::DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
+{
+	if (IsZeroExtent())
+	{
+		return;
+	}
+
+	const FKzHeightfieldData& Data = *HeightData;
+
+	auto GetPoint = [&](int32 X, int32 Y)
+	{
+		return Center + Rotation.RotateVector(FVector(X, Y, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X, Y)));
+	};
+
+	for (int32 Y = 0; Y < Data.SizeY; ++Y)
+	{
+		for (int32 X = 0; X < Data.SizeX; ++X)
+		{
+			const FVector P = GetPoint(X, Y);
+			if (X + 1 < Data.SizeX)
+			{
+				DrawDebugLine(InWorld, P, GetPoint(X + 1, Y), Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+			}
+			if (Y + 1 < Data.SizeY)
+			{
+				DrawDebugLine(InWorld, P, GetPoint(X, Y + 1), Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+			}
+			if (X + 1 < Data.SizeX && Y + 1 < Data.SizeY)
+			{
+				DrawDebugLine(InWorld, P, GetPoint(X + 1, Y + 1), Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+			}
+		}
+	}
+}
+
+void FKzHeightfield::DrawSceneProxy(FPrimitiveDrawInterface* PDI, const FMatrix& LocalToWorld, const FLinearColor& Color, bool bDrawSolid, float Thickness, int32 ViewIndex, FMeshElementCollector& Collector) const
+{
+	if (IsZeroExtent())
+	{
+		return;
+	}
+
+	const FKzHeightfieldData& Data = *HeightData;
+
+	auto GetPoint = [&](int32 X, int32 Y)
+	{
+		return FVector(X, Y, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X, Y));
+	};
+
+	for (int32 Y = 0; Y < Data.SizeY; ++Y)
+	{
+		for (int32 X = 0; X < Data.SizeX; ++X)
+		{
+			const FVector P = LocalToWorld.TransformPosition(GetPoint(X, Y));
+			if (X + 1 < Data.SizeX)
+			{
+				PDI->DrawLine(P, LocalToWorld.TransformPosition(GetPoint(X + 1, Y)), Color, SDPG_World, Thickness);
+			}
+			if (Y + 1 < Data.SizeY)
+			{
+				PDI->DrawLine(P, LocalToWorld.TransformPosition(GetPoint(X, Y + 1)), Color, SDPG_World, Thickness);
+			}
+		}
+	}
+
+	if (bDrawSolid)
+	{
+		const FLinearColor SolidColor = FLinearColor(Color.R, Color.G, Color.B, 0.2f);
+		const FColor VertexColor = SolidColor.ToFColor(true);
+
+		// Smooth shaded: one vertex per sample, with the normal from the neighboring samples.
+		FDynamicMeshBuilder MeshBuilder(Collector.GetFeatureLevel());
+		for (int32 Y = 0; Y < Data.SizeY; ++Y)
+		{
+			for (int32 X = 0; X < Data.SizeX; ++X)
+			{
+				const FVector DX = GetPoint(FMath::Min(X + 1, Data.SizeX - 1), Y) - GetPoint(FMath::Max(X - 1, 0), Y);
+				const FVector DY = GetPoint(X, FMath::Min(Y + 1, Data.SizeY - 1)) - GetPoint(X, FMath::Max(Y - 1, 0));
+				const FVector3f Normal = FVector3f(DX ^ DY).GetSafeNormal();
+				FVector3f TangentX, TangentY;
+				Normal.FindBestAxisVectors(TangentX, TangentY);
+
+				MeshBuilder.AddVertex(FDynamicMeshVertex(FVector3f(GetPoint(X, Y)), TangentX, Normal, FVector2f(X, Y), VertexColor));
+			}
+		}
+
+		for (int32 Y = 0; Y + 1 < Data.SizeY; ++Y)
+		{
+			for (int32 X = 0; X + 1 < Data.SizeX; ++X)
+			{
+				const int32 I00 = Y * Data.SizeX + X;
+				const int32 I10 = I00 + 1;
+				const int32 I01 = I00 + Data.SizeX;
+				const int32 I11 = I01 + 1;
+				MeshBuilder.AddTriangle(I00, I10, I11);
+				MeshBuilder.AddTriangle(I00, I11, I01);
+			}
+		}
+
+		FMaterialRenderProxy* const MaterialRenderProxy = new FColoredMaterialRenderProxy(GEngine->DebugMeshMaterial->GetRenderProxy(), SolidColor);
+		MeshBuilder.GetMesh(LocalToWorld, MaterialRenderProxy, SDPG_World, true, false, ViewIndex, Collector);
+	}
+}
\ No newline at end of file
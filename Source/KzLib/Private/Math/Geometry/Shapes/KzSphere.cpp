@@ -29,6 +29,11 @@ bool FKzSphere::Raycast(struct FKzHitResult& OutHit, const FVector& Center, cons
 	return Kz::Raycast::Sphere(OutHit, Center, Radius, RayStart, RayDir, MaxDistance);
 }
 
+bool FKzSphere::RaycastTest(const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+{
+	return Kz::Raycast::Sphere(Center, Radius, RayStart, RayDir, MaxDistance);
+}
+
 void FKzSphere::DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
 {
 	DrawDebugSphere(InWorld, Center, Radius, 12, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
@@ -0,0 +1,737 @@
+// Copyright 2026 kirzo
+
+#include "Math/Geometry/Shapes/KzTriangleMesh.h"
+#include "Math/Geometry/KzShapeInstance.h"
+#include "Collision/KzHitResult.h"
+#include "Collision/KzGJK.h"
+#include "Algo/Sort.h"
+#include "Engine/Engine.h"
+#include "Materials/Material.h"
+#include "DrawDebugHelpers.h"
+#include "DynamicMeshBuilder.h"
+#include "PrimitiveDrawingUtils.h"
+#include "Materials/MaterialRenderProxy.h"
+
+namespace
+{
+	using FNode = FKzTriangleMeshData::FNode;
+	using FTriangle = FKzTriangleMeshData::FTriangle;
+
+	/** Number of centroid bins evaluated by the SAH split. */
+	constexpr int32 NumSplitBins = 16;
+
+	/** Past this depth nodes are split at the median, which bounds the depth of the traversal stacks. */
+	constexpr int32 MaxSAHDepth = 40;
+
+	FORCEINLINE float HalfArea(const FVector3f& Min, const FVector3f& Max)
+	{
+		const FVector3f Extent = Max - Min;
+		return Extent.X * Extent.Y + Extent.Y * Extent.Z + Extent.Z * Extent.X;
+	}
+
+	/** Mesh space box scaled by a (possibly negative) per-axis scale. */
+	FORCEINLINE void ScaleBox(const FVector3f& Min, const FVector3f& Max, const FVector& Scale, FVector& OutMin, FVector& OutMax)
+	{
+		const FVector A = FVector(Min) * Scale;
+		const FVector B = FVector(Max) * Scale;
+		OutMin = FVector(FMath::Min(A.X, B.X), FMath::Min(A.Y, B.Y), FMath::Min(A.Z, B.Z));
+		OutMax = FVector(FMath::Max(A.X, B.X), FMath::Max(A.Y, B.Y), FMath::Max(A.Z, B.Z));
+	}
+
+	/** Squared distance from a point to a box, zero inside. */
+	FORCEINLINE double BoxDistSquared(const FVector& Min, const FVector& Max, const FVector& Point)
+	{
+		double DistSq = 0.0;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const double Below = Min[Axis] - Point[Axis];
+			const double Above = Point[Axis] - Max[Axis];
+			DistSq += FMath::Square(FMath::Max(0.0, FMath::Max(Below, Above)));
+		}
+		return DistSq;
+	}
+
+	/** Largest projection of a box onto a direction. */
+	FORCEINLINE float BoxSupport(const FNode& Node, const FVector3f& Dir)
+	{
+		return FMath::Max(Node.Min.X * Dir.X, Node.Max.X * Dir.X)
+			+ FMath::Max(Node.Min.Y * Dir.Y, Node.Max.Y * Dir.Y)
+			+ FMath::Max(Node.Min.Z * Dir.Z, Node.Max.Z * Dir.Z);
+	}
+
+	/** Farthest vertex of a triangle along a direction. */
+	FORCEINLINE FVector TriangleSupport(const FVector& V0, const FVector& V1, const FVector& V2, const FVector& Dir)
+	{
+		const double D0 = V0 | Dir;
+		const double D1 = V1 | Dir;
+		const double D2 = V2 | Dir;
+		return D0 >= D1 ? (D0 >= D2 ? V0 : V2) : (D1 >= D2 ? V1 : V2);
+	}
+
+	/**
+	 * GJK between a convex support function and the triangles under its bounds, both in scaled mesh space.
+	 * Support(Dir) returns the farthest point of the convex along Dir.
+	 */
+	template <typename TSupport>
+	bool IntersectsSupport(const FKzTriangleMesh& Mesh, const FBox& LocalBounds, TSupport&& Support)
+	{
+		bool bIntersects = false;
+		Mesh.ForEachTriangle(LocalBounds, [&](const FVector& V0, const FVector& V1, const FVector& V2)
+		{
+			// Minkowski difference triangle - convex.
+			bIntersects = Kz::GJK::Internal::Intersect([&](const FVector& Dir)
+			{
+				return TriangleSupport(V0, V1, V2, Dir) - Support(-Dir);
+			}, 20);
+
+			return !bIntersects;
+		});
+
+		return bIntersects;
+	}
+}
+
+TSharedRef<const FKzTriangleMeshData> FKzTriangleMeshData::Build(TConstArrayView<FVector> Vertices, TConstArrayView<int32> Indices)
+{
+	TSharedRef<FKzTriangleMeshData> Data = MakeShared<FKzTriangleMeshData>();
+
+	// Gather the valid triangles with their bounds and centroids.
+	TArray<FTriangle> Source;
+	TArray<FVector3f> Centroids;
+	TArray<FVector3f> BoundsMin;
+	TArray<FVector3f> BoundsMax;
+
+	const int32 NumSourceTriangles = Indices.Num() / 3;
+	Source.Reserve(NumSourceTriangles);
+	Centroids.Reserve(NumSourceTriangles);
+	BoundsMin.Reserve(NumSourceTriangles);
+	BoundsMax.Reserve(NumSourceTriangles);
+
+	for (int32 i = 0; i < NumSourceTriangles; ++i)
+	{
+		const int32 I0 = Indices[i * 3];
+		const int32 I1 = Indices[i * 3 + 1];
+		const int32 I2 = Indices[i * 3 + 2];
+		if (!Vertices.IsValidIndex(I0) || !Vertices.IsValidIndex(I1) || !Vertices.IsValidIndex(I2))
+		{
+			continue;
+		}
+
+		const FVector3f A(Vertices[I0]);
+		const FVector3f B(Vertices[I1]);
+		const FVector3f C(Vertices[I2]);
+		if (((B - A) ^ (C - A)).SizeSquared() <= UE_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		Source.Add(FTriangle{ A, B - A, C - A });
+		Centroids.Add((A + B + C) / 3.0f);
+		BoundsMin.Add(FVector3f(FMath::Min3(A.X, B.X, C.X), FMath::Min3(A.Y, B.Y, C.Y), FMath::Min3(A.Z, B.Z, C.Z)));
+		BoundsMax.Add(FVector3f(FMath::Max3(A.X, B.X, C.X), FMath::Max3(A.Y, B.Y, C.Y), FMath::Max3(A.Z, B.Z, C.Z)));
+	}
+
+	const int32 NumTriangles = Source.Num();
+	if (NumTriangles == 0)
+	{
+		return Data;
+	}
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumTriangles);
+	for (int32 i = 0; i < NumTriangles; ++i)
+	{
+		Order[i] = i;
+	}
+
+	// A binary tree with N leaves has 2N - 1 nodes, so node references stay valid while splitting.
+	TArray<FNode>& Nodes = Data->Nodes;
+	Nodes.Reserve(2 * NumTriangles);
+	Nodes.Add(FNode{ FVector3f::ZeroVector, 0, FVector3f::ZeroVector, NumTriangles });
+
+	// Nodes waiting to be split, with their depth. Unsplit nodes are leaves over [Index, Index + Count).
+	TArray<TPair<int32, int32>> Pending;
+	Pending.Emplace(0, 0);
+
+	while (Pending.Num() > 0)
+	{
+		const TPair<int32, int32> Item = Pending.Pop(EAllowShrinking::No);
+		FNode& Node = Nodes[Item.Key];
+		const int32 Depth = Item.Value;
+		const int32 First = Node.Index;
+		const int32 Count = Node.Count;
+
+		Node.Min = FVector3f(UE_BIG_NUMBER);
+		Node.Max = FVector3f(-UE_BIG_NUMBER);
+		FVector3f CentroidMin(UE_BIG_NUMBER);
+		FVector3f CentroidMax(-UE_BIG_NUMBER);
+		for (int32 i = First; i < First + Count; ++i)
+		{
+			const int32 Triangle = Order[i];
+			Node.Min = Node.Min.ComponentMin(BoundsMin[Triangle]);
+			Node.Max = Node.Max.ComponentMax(BoundsMax[Triangle]);
+			CentroidMin = CentroidMin.ComponentMin(Centroids[Triangle]);
+			CentroidMax = CentroidMax.ComponentMax(Centroids[Triangle]);
+		}
+
+		if (Count <= MaxLeafTriangles)
+		{
+			continue;
+		}
+
+		const FVector3f CentroidExtent = CentroidMax - CentroidMin;
+		const int32 Axis = CentroidExtent.X >= CentroidExtent.Y ? (CentroidExtent.X >= CentroidExtent.Z ? 0 : 2) : (CentroidExtent.Y >= CentroidExtent.Z ? 1 : 2);
+		if (CentroidExtent[Axis] <= UE_SMALL_NUMBER)
+		{
+			// Coincident centroids cannot be separated, keep a larger leaf.
+			continue;
+		}
+
+		int32 SplitCount = 0;
+
+		if (Depth < MaxSAHDepth)
+		{
+			// Binned surface area heuristic.
+			int32 BinCounts[NumSplitBins] = {};
+			FVector3f BinMin[NumSplitBins];
+			FVector3f BinMax[NumSplitBins];
+			for (int32 Bin = 0; Bin < NumSplitBins; ++Bin)
+			{
+				BinMin[Bin] = FVector3f(UE_BIG_NUMBER);
+				BinMax[Bin] = FVector3f(-UE_BIG_NUMBER);
+			}
+
+			const float BinScale = NumSplitBins / CentroidExtent[Axis];
+			auto GetBin = [&](int32 Triangle)
+			{
+				return FMath::Min(NumSplitBins - 1, (int32)((Centroids[Triangle][Axis] - CentroidMin[Axis]) * BinScale));
+			};
+
+			for (int32 i = First; i < First + Count; ++i)
+			{
+				const int32 Triangle = Order[i];
+				const int32 Bin = GetBin(Triangle);
+				++BinCounts[Bin];
+				BinMin[Bin] = BinMin[Bin].ComponentMin(BoundsMin[Triangle]);
+				BinMax[Bin] = BinMax[Bin].ComponentMax(BoundsMax[Triangle]);
+			}
+
+			// Sweep from the right to get the cost of every right side, then from the left.
+			float RightCost[NumSplitBins];
+			{
+				FVector3f Min(UE_BIG_NUMBER);
+				FVector3f Max(-UE_BIG_NUMBER);
+				int32 Num = 0;
+				for (int32 Bin = NumSplitBins - 1; Bin > 0; --Bin)
+				{
+					Min = Min.ComponentMin(BinMin[Bin]);
+					Max = Max.ComponentMax(BinMax[Bin]);
+					Num += BinCounts[Bin];
+					RightCost[Bin] = Num > 0 ? HalfArea(Min, Max) * Num : 0.0f;
+				}
+			}
+
+			float BestCost = TNumericLimits<float>::Max();
+			int32 BestBin = INDEX_NONE;
+			{
+				FVector3f Min(UE_BIG_NUMBER);
+				FVector3f Max(-UE_BIG_NUMBER);
+				int32 Num = 0;
+				for (int32 Bin = 0; Bin < NumSplitBins - 1; ++Bin)
+				{
+					Min = Min.ComponentMin(BinMin[Bin]);
+					Max = Max.ComponentMax(BinMax[Bin]);
+					Num += BinCounts[Bin];
+
+					const float Cost = (Num > 0 ? HalfArea(Min, Max) * Num : 0.0f) + RightCost[Bin + 1];
+					if (Num > 0 && Num < Count && Cost < BestCost)
+					{
+						BestCost = Cost;
+						BestBin = Bin;
+					}
+				}
+			}
+
+			if (BestBin != INDEX_NONE)
+			{
+				// Partition the range: triangles in bins <= BestBin go left.
+				int32 Left = First;
+				int32 Right = First + Count - 1;
+				while (Left <= Right)
+				{
+					if (GetBin(Order[Left]) <= BestBin)
+					{
+						++Left;
+					}
+					else
+					{
+						Swap(Order[Left], Order[Right--]);
+					}
+				}
+				SplitCount = Left - First;
+			}
+		}
+
+		if (SplitCount == 0 || SplitCount == Count)
+		{
+			// Median split along the widest axis.
+			TArrayView<int32> Range(Order.GetData() + First, Count);
+			Algo::SortBy(Range, [&](int32 Triangle) { return Centroids[Triangle][Axis]; });
+			SplitCount = Count / 2;
+		}
+
+		const int32 ChildIndex = Nodes.Num();
+		Nodes.Add(FNode{ FVector3f::ZeroVector, First, FVector3f::ZeroVector, SplitCount });
+		Nodes.Add(FNode{ FVector3f::ZeroVector, First + SplitCount, FVector3f::ZeroVector, Count - SplitCount });
+
+		Node.Index = ChildIndex;
+		Node.Count = 0;
+
+		Pending.Emplace(ChildIndex, Depth + 1);
+		Pending.Emplace(ChildIndex + 1, Depth + 1);
+	}
+
+	// Store the triangles in leaf order.
+	Data->Triangles.Reserve(NumTriangles);
+	for (int32 Triangle : Order)
+	{
+		Data->Triangles.Add(Source[Triangle]);
+	}
+
+	return Data;
+}
+
+void FKzTriangleMeshData::Serialize(FArchive& Ar)
+{
+	Ar << Nodes;
+	Ar << Triangles;
+}
+
+FBox FKzTriangleMeshData::GetBounds() const
+{
+	return Nodes.Num() > 0 ? FBox(FVector(Nodes[0].Min), FVector(Nodes[0].Max)) : FBox(ForceInit);
+}
+
+int32 FKzTriangleMeshData::Raycast(const FVector3f& Origin, const FVector3f& Dir, float& InOutT) const
+{
+	if (Nodes.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	auto SafeInv = [](float Value) { return FMath::Abs(Value) > UE_SMALL_NUMBER ? 1.0f / Value : (Value < 0.0f ? -UE_BIG_NUMBER : UE_BIG_NUMBER); };
+	const FVector3f InvDir(SafeInv(Dir.X), SafeInv(Dir.Y), SafeInv(Dir.Z));
+
+	// Returns the entry distance into a node, or a negative value if the ray misses it within BestT.
+	auto IntersectNode = [&](const FNode& Node, float BestT)
+	{
+		const FVector3f T1 = (Node.Min - Origin) * InvDir;
+		const FVector3f T2 = (Node.Max - Origin) * InvDir;
+		const float TNear = FMath::Max(FMath::Max3(FMath::Min(T1.X, T2.X), FMath::Min(T1.Y, T2.Y), FMath::Min(T1.Z, T2.Z)), 0.0f);
+		const float TFar = FMath::Min(FMath::Min3(FMath::Max(T1.X, T2.X), FMath::Max(T1.Y, T2.Y), FMath::Max(T1.Z, T2.Z)), BestT);
+		return TNear <= TFar ? TNear : -1.0f;
+	};
+
+	float BestT = InOutT;
+	int32 BestTriangle = INDEX_NONE;
+
+	if (IntersectNode(Nodes[0], BestT) < 0.0f)
+	{
+		return INDEX_NONE;
+	}
+
+	int32 Stack[64];
+	int32 StackSize = 0;
+	Stack[StackSize++] = 0;
+
+	while (StackSize > 0)
+	{
+		const FNode& Node = Nodes[Stack[--StackSize]];
+
+		if (Node.IsLeaf())
+		{
+			// Möller–Trumbore, two-sided.
+			for (int32 i = Node.Index; i < Node.Index + Node.Count; ++i)
+			{
+				const FTriangle& Triangle = Triangles[i];
+
+				const FVector3f P = Dir ^ Triangle.E2;
+				const float Det = Triangle.E1 | P;
+				if (FMath::Abs(Det) <= UE_SMALL_NUMBER)
+				{
+					continue;
+				}
+
+				const float InvDet = 1.0f / Det;
+				const FVector3f T = Origin - Triangle.V0;
+				const float U = (T | P) * InvDet;
+				if (U < 0.0f || U > 1.0f)
+				{
+					continue;
+				}
+
+				const FVector3f Q = T ^ Triangle.E1;
+				const float V = (Dir | Q) * InvDet;
+				if (V < 0.0f || U + V > 1.0f)
+				{
+					continue;
+				}
+
+				const float HitT = (Triangle.E2 | Q) * InvDet;
+				if (HitT >= 0.0f && HitT <= BestT)
+				{
+					BestT = HitT;
+					BestTriangle = i;
+				}
+			}
+			continue;
+		}
+
+		// Visit the nearer child first, and skip children beyond the closest hit so far.
+		const float TLeft = IntersectNode(Nodes[Node.Index], BestT);
+		const float TRight = IntersectNode(Nodes[Node.Index + 1], BestT);
+
+		check(StackSize + 2 <= UE_ARRAY_COUNT(Stack));
+		if (TLeft >= 0.0f && TRight >= 0.0f)
+		{
+			const bool bLeftFirst = TLeft <= TRight;
+			Stack[StackSize++] = bLeftFirst ? Node.Index + 1 : Node.Index;
+			Stack[StackSize++] = bLeftFirst ? Node.Index : Node.Index + 1;
+		}
+		else if (TLeft >= 0.0f)
+		{
+			Stack[StackSize++] = Node.Index;
+		}
+		else if (TRight >= 0.0f)
+		{
+			Stack[StackSize++] = Node.Index + 1;
+		}
+	}
+
+	if (BestTriangle != INDEX_NONE)
+	{
+		InOutT = BestT;
+	}
+	return BestTriangle;
+}
+
+bool FKzTriangleMesh::Serialize(FArchive& Ar)
+{
+	Ar << MeshScale;
+
+	bool bHasMeshData = MeshData.IsValid();
+	Ar << bHasMeshData;
+
+	if (Ar.IsLoading())
+	{
+		if (bHasMeshData)
+		{
+			TSharedRef<FKzTriangleMeshData> Data = MakeShared<FKzTriangleMeshData>();
+			Data->Serialize(Ar);
+			MeshData = Data;
+		}
+		else
+		{
+			MeshData.Reset();
+		}
+	}
+	else if (bHasMeshData)
+	{
+		// Saving only reads the data, which may be shared with other shapes.
+		const_cast<FKzTriangleMeshData&>(*MeshData).Serialize(Ar);
+	}
+
+	return true;
+}
+
+bool FKzTriangleMesh::IntersectsShape(const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FVector& Center, const FQuat& Rotation) const
+{
+	if (IsZeroExtent() || !Shape.IsValid())
+	{
+		return false;
+	}
+
+	// Shape transform relative to the mesh.
+	const FVector LocalPosition = Rotation.UnrotateVector(ShapePosition - Center);
+	const FQuat LocalRotation = Rotation.Inverse() * ShapeRotation;
+
+	return IntersectsSupport(*this, Shape.GetBoundingBox(LocalPosition, LocalRotation), [&](const FVector& Dir)
+	{
+		return LocalPosition + LocalRotation.RotateVector(Shape.GetSupportPoint(LocalRotation.UnrotateVector(Dir)));
+	});
+}
+
+bool FKzTriangleMesh::IntersectsTriangle(const FVector& V0, const FVector& V1, const FVector& V2, const FVector& Center, const FQuat& Rotation) const
+{
+	if (IsZeroExtent())
+	{
+		return false;
+	}
+
+	// Triangle relative to the mesh.
+	const FVector L0 = Rotation.UnrotateVector(V0 - Center);
+	const FVector L1 = Rotation.UnrotateVector(V1 - Center);
+	const FVector L2 = Rotation.UnrotateVector(V2 - Center);
+
+	FBox LocalBounds(L0, L0);
+	LocalBounds += L1;
+	LocalBounds += L2;
+
+	return IntersectsSupport(*this, LocalBounds, [&](const FVector& Dir)
+	{
+		return TriangleSupport(L0, L1, L2, Dir);
+	});
+}
+
+FBox FKzTriangleMesh::GetBoundingBox(const FVector& Center, const FQuat& Rotation) const
+{
+	if (IsZeroExtent())
+	{
+		return FBox(Center, Center);
+	}
+
+	const FNode& Root = MeshData->Nodes[0];
+	FVector Min, Max;
+	ScaleBox(Root.Min, Root.Max, MeshScale, Min, Max);
+
+	FBox Bounds(ForceInit);
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const FVector Point((Corner & 1) ? Max.X : Min.X, (Corner & 2) ? Max.Y : Min.Y, (Corner & 4) ? Max.Z : Min.Z);
+		Bounds += Center + Rotation.RotateVector(Point);
+	}
+	return Bounds;
+}
+
+FVector FKzTriangleMesh::GetClosestPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const
+{
+	if (IsZeroExtent())
+	{
+		return Center;
+	}
+
+	const FVector LocalPoint = Rotation.UnrotateVector(Point - Center);
+
+	// Best-first descent, pruning nodes farther than the closest point found so far.
+	FVector Best = LocalPoint;
+	double BestDistSq = TNumericLimits<double>::Max();
+
+	int32 Stack[64];
+	int32 StackSize = 0;
+	Stack[StackSize++] = 0;
+
+	const TArray<FNode>& Nodes = MeshData->Nodes;
+	while (StackSize > 0)
+	{
+		const FNode& Node = Nodes[Stack[--StackSize]];
+
+		FVector Min, Max;
+		ScaleBox(Node.Min, Node.Max, MeshScale, Min, Max);
+		if (BoxDistSquared(Min, Max, LocalPoint) >= BestDistSq)
+		{
+			continue;
+		}
+
+		if (Node.IsLeaf())
+		{
+			for (int32 i = Node.Index; i < Node.Index + Node.Count; ++i)
+			{
+				const FTriangle& Triangle = MeshData->Triangles[i];
+				const FVector Candidate = FMath::ClosestPointOnTriangleToPoint(LocalPoint,
+					FVector(Triangle.V0) * MeshScale, FVector(Triangle.V0 + Triangle.E1) * MeshScale, FVector(Triangle.V0 + Triangle.E2) * MeshScale);
+
+				const double DistSq = FVector::DistSquared(Candidate, LocalPoint);
+				if (DistSq < BestDistSq)
+				{
+					BestDistSq = DistSq;
+					Best = Candidate;
+				}
+			}
+			continue;
+		}
+
+		FVector LeftMin, LeftMax, RightMin, RightMax;
+		ScaleBox(Nodes[Node.Index].Min, Nodes[Node.Index].Max, MeshScale, LeftMin, LeftMax);
+		ScaleBox(Nodes[Node.Index + 1].Min, Nodes[Node.Index + 1].Max, MeshScale, RightMin, RightMax);
+
+		check(StackSize + 2 <= UE_ARRAY_COUNT(Stack));
+		const bool bLeftFirst = BoxDistSquared(LeftMin, LeftMax, LocalPoint) <= BoxDistSquared(RightMin, RightMax, LocalPoint);
+		Stack[StackSize++] = bLeftFirst ? Node.Index + 1 : Node.Index;
+		Stack[StackSize++] = bLeftFirst ? Node.Index : Node.Index + 1;
+	}
+
+	return Center + Rotation.RotateVector(Best);
+}
+
+bool FKzTriangleMesh::IntersectsPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const
+{
+	return !IsZeroExtent() && FVector::DistSquared(GetClosestPoint(Center, Rotation, Point), Point) <= FMath::Square(UE_KINDA_SMALL_NUMBER);
+}
+
+FCollisionShape FKzTriangleMesh::ToCollisionShape(float Inflation) const
+{
+	// Engine shapes are centered, use the box around the origin that encloses the mesh.
+	const FBox LocalBounds = GetBoundingBox(FVector::ZeroVector, FQuat::Identity);
+	return FCollisionShape::MakeBox(FVector::Max(LocalBounds.Min.GetAbs(), LocalBounds.Max.GetAbs()) + Inflation);
+}
+
+FVector FKzTriangleMesh::GetSupportPoint(const FVector& Direction) const
+{
+	if (IsZeroExtent())
+	{
+		return FVector::ZeroVector;
+	}
+
+	// The support of the scaled mesh along D is the scaled support of the mesh along Scale * D.
+	const FVector3f Dir(Direction * MeshScale);
+
+	// Branch and bound on the box supports, best child first.
+	FVector3f Best = MeshData->Triangles[0].V0;
+	float BestDot = Best | Dir;
+
+	int32 Stack[64];
+	int32 StackSize = 0;
+	Stack[StackSize++] = 0;
+
+	const TArray<FNode>& Nodes = MeshData->Nodes;
+	while (StackSize > 0)
+	{
+		const FNode& Node = Nodes[Stack[--StackSize]];
+		if (BoxSupport(Node, Dir) <= BestDot)
+		{
+			continue;
+		}
+
+		if (Node.IsLeaf())
+		{
+			for (int32 i = Node.Index; i < Node.Index + Node.Count; ++i)
+			{
+				for (int32 Corner = 0; Corner < 3; ++Corner)
+				{
+					const FVector3f Vertex = MeshData->Triangles[i].GetVertex(Corner);
+					const float Dot = Vertex | Dir;
+					if (Dot > BestDot)
+					{
+						BestDot = Dot;
+						Best = Vertex;
+					}
+				}
+			}
+			continue;
+		}
+
+		check(StackSize + 2 <= UE_ARRAY_COUNT(Stack));
+		const bool bLeftFirst = BoxSupport(Nodes[Node.Index], Dir) >= BoxSupport(Nodes[Node.Index + 1], Dir);
+		Stack[StackSize++] = bLeftFirst ? Node.Index + 1 : Node.Index;
+		Stack[StackSize++] = bLeftFirst ? Node.Index : Node.Index + 1;
+	}
+
+	return FVector(Best) * MeshScale;
+}
+
+bool FKzTriangleMesh::Raycast(FKzHitResult& OutHit, const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+{
+	if (MaxDistance <= 0.0f)
+	{
+		MaxDistance = UE_BIG_NUMBER;
+	}
+
+	OutHit.Reset(1.f, false);
+	OutHit.TraceStart = RayStart;
+	OutHit.TraceEnd = RayStart + RayDir * MaxDistance;
+
+	if (IsZeroExtent())
+	{
+		return false;
+	}
+
+	// Into unscaled mesh space. The direction is scaled as well, so ray distances are preserved.
+	const FVector InvScale(1.0 / MeshScale.X, 1.0 / MeshScale.Y, 1.0 / MeshScale.Z);
+	const FVector3f Origin(Rotation.UnrotateVector(RayStart - Center) * InvScale);
+	const FVector3f Dir(Rotation.UnrotateVector(RayDir) * InvScale);
+
+	float T = MaxDistance;
+	const int32 TriangleIndex = MeshData->Raycast(Origin, Dir, T);
+	if (TriangleIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Normals transform with the inverse scale, and face the ray since triangles are two-sided.
+	const FKzTriangleMeshData::FTriangle& Triangle = MeshData->Triangles[TriangleIndex];
+	FVector Normal = Rotation.RotateVector((FVector(Triangle.E1 ^ Triangle.E2) * InvScale).GetSafeNormal());
+	if ((Normal | RayDir) > 0.0)
+	{
+		Normal = -Normal;
+	}
+
+	OutHit.bBlockingHit = true;
+	OutHit.Distance = T;
+	OutHit.Time = T / MaxDistance;
+	OutHit.Location = RayStart + RayDir * T;
+	OutHit.Normal = Normal;
+
+	return true;
+}
+
+void FKzTriangleMesh::DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
+{
+	if (IsZeroExtent())
+	{
+		return;
+	}
+
+	for (const FKzTriangleMeshData::FTriangle& Triangle : MeshData->Triangles)
+	{
+		const FVector A = Center + Rotation.RotateVector(FVector(Triangle.GetVertex(0)) * MeshScale);
+		const FVector B = Center + Rotation.RotateVector(FVector(Triangle.GetVertex(1)) * MeshScale);
+		const FVector C = Center + Rotation.RotateVector(FVector(Triangle.GetVertex(2)) * MeshScale);
+
+		DrawDebugLine(InWorld, A, B, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+		DrawDebugLine(InWorld, B, C, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+		DrawDebugLine(InWorld, C, A, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+	}
+}
+
+void FKzTriangleMesh::DrawSceneProxy(FPrimitiveDrawInterface* PDI, const FMatrix& LocalToWorld, const FLinearColor& Color, bool bDrawSolid, float Thickness, int32 ViewIndex, FMeshElementCollector& Collector) const
+{
+	if (IsZeroExtent())
+	{
+		return;
+	}
+
+	const FMatrix MeshToWorld = FScaleMatrix(MeshScale) * LocalToWorld;
+
+	for (const FKzTriangleMeshData::FTriangle& Triangle : MeshData->Triangles)
+	{
+		const FVector A = MeshToWorld.TransformPosition(FVector(Triangle.GetVertex(0)));
+		const FVector B = MeshToWorld.TransformPosition(FVector(Triangle.GetVertex(1)));
+		const FVector C = MeshToWorld.TransformPosition(FVector(Triangle.GetVertex(2)));
+
+		PDI->DrawLine(A, B, Color, SDPG_World, Thickness);
+		PDI->DrawLine(B, C, Color, SDPG_World, Thickness);
+		PDI->DrawLine(C, A, Color, SDPG_World, Thickness);
+	}
+
+	if (bDrawSolid)
+	{
+		const FLinearColor SolidColor = FLinearColor(Color.R, Color.G, Color.B, 0.2f);
+		const FColor VertexColor = SolidColor.ToFColor(true);
+
+		FDynamicMeshBuilder MeshBuilder(Collector.GetFeatureLevel());
+		for (const FKzTriangleMeshData::FTriangle& Triangle : MeshData->Triangles)
+		{
+			const FVector3f Normal = (Triangle.E1 ^ Triangle.E2).GetSafeNormal();
+			FVector3f TangentX, TangentY;
+			Normal.FindBestAxisVectors(TangentX, TangentY);
+
+			const int32 First = MeshBuilder.AddVertex(FDynamicMeshVertex(Triangle.GetVertex(0), TangentX, Normal, FVector2f::ZeroVector, VertexColor));
+			MeshBuilder.AddVertex(FDynamicMeshVertex(Triangle.GetVertex(1), TangentX, Normal, FVector2f::ZeroVector, VertexColor));
+			MeshBuilder.AddVertex(FDynamicMeshVertex(Triangle.GetVertex(2), TangentX, Normal, FVector2f::ZeroVector, VertexColor));
+			MeshBuilder.AddTriangle(First, First + 1, First + 2);
+		}
+
+		FMaterialRenderProxy* const MaterialRenderProxy = new FColoredMaterialRenderProxy(GEngine->DebugMeshMaterial->GetRenderProxy(), SolidColor);
+		MeshBuilder.GetMesh(MeshToWorld, MaterialRenderProxy, SDPG_World, true, false, ViewIndex, Collector);
+	}
+}
\ No newline at end of file
@@ -3,19 +3,152 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Math/Geometry/KzShape.h"
 
 struct FKzShapeInstance;
+struct FKzShapeWorldCache;
+struct FKzShapeValue;
 struct FKzHitResult;
 
 namespace Kz::GJK
 {
+	/**
+	 * Warm start data for repeated GJK queries on the same pair of shapes (eg. a sensor scanning the same targets).
+	 *
+	 * Stores the last separating axis and the search directions of the last simplex, in the local frame of shape A.
+	 * Shapes are implicit support functions, so the directions play the role of support indices: evaluating them
+	 * again picks the same features of both shapes, which barely move between frames. Start with an empty cache.
+	 */
+	struct FSimplexCache
+	{
+		FVector Directions[4];
+		FVector SeparatingAxis = FVector::ZeroVector;
+		int32 NumDirections = 0;
+
+		void Reset()
+		{
+			SeparatingAxis = FVector::ZeroVector;
+			NumDirections = 0;
+		}
+	};
+
 	/** Performs a raycast against a convex shape. */
 	KZLIB_API bool Raycast(FKzHitResult& OutHit,
 							 const FVector& RayOrigin, const FVector& RayDir, float MaxDistance,
 							 const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation);
 
+	/**
+	 * Performs a raycast against a shape placed by a world cache.
+	 * Rays that miss the cached bounding sphere are rejected without touching the shape.
+	 */
+	KZLIB_API bool Raycast(FKzHitResult& OutHit,
+							 const FVector& RayOrigin, const FVector& RayDir, float MaxDistance,
+							 const FKzShapeWorldCache& Shape);
+
+	/** Performs a raycast against a shape value, through the analytic raycast of its concrete type. */
+	KZLIB_API bool Raycast(FKzHitResult& OutHit,
+							 const FVector& RayOrigin, const FVector& RayDir, float MaxDistance,
+							 const FKzShapeValue& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation);
+
+	/**
+	 * Returns true if a ray touches a shape, without computing the hit data (eg. for any-hit and line of sight queries).
+	 * Uses the shape's analytic test when it has one, and otherwise GJK between the shape and the ray segment.
+	 */
+	KZLIB_API bool RaycastTest(const FVector& RayOrigin, const FVector& RayDir, float MaxDistance,
+								 const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation);
+
+	/** Same as above, for a shape placed by a world cache. Rays that miss the cached bounding sphere are rejected first. */
+	KZLIB_API bool RaycastTest(const FVector& RayOrigin, const FVector& RayDir, float MaxDistance, const FKzShapeWorldCache& Shape);
+
+	/** Same as above, for a shape value. */
+	KZLIB_API bool RaycastTest(const FVector& RayOrigin, const FVector& RayDir, float MaxDistance,
+								 const FKzShapeValue& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation);
+
 	/** Performs a GJK intersection test between two convex shapes. */
 	KZLIB_API bool Intersect(const FKzShapeInstance& ShapeA, const FVector& PositionA, const FQuat& RotationA,
 								 const FKzShapeInstance& ShapeB, const FVector& PositionB, const FQuat& RotationB,
 								 int32 MaxIterations = 20);
-}
\ No newline at end of file
+
+	/**
+	 * Performs a GJK intersection test between two shapes of known concrete types (eg. Intersect<FKzCapsule, FKzBox>).
+	 * The support mappings are bound at compile time and inlined, and the relative transform is computed once per call.
+	 * The FKzShapeInstance overload dispatches to this for the built-in shape types.
+	 */
+	template <typename ShapeTypeA, typename ShapeTypeB, typename = std::enable_if_t<TIsDerivedFrom<ShapeTypeA, FKzShape>::Value && TIsDerivedFrom<ShapeTypeB, FKzShape>::Value>>
+	bool Intersect(const ShapeTypeA& ShapeA, const FVector& PositionA, const FQuat& RotationA,
+				   const ShapeTypeB& ShapeB, const FVector& PositionB, const FQuat& RotationB,
+				   int32 MaxIterations = 20);
+
+	/** Performs a GJK intersection test between two shape values, through the devirtualized path of their concrete types. */
+	KZLIB_API bool Intersect(const FKzShapeValue& ShapeA, const FVector& PositionA, const FQuat& RotationA,
+								 const FKzShapeValue& ShapeB, const FVector& PositionB, const FQuat& RotationB,
+								 int32 MaxIterations = 20);
+
+	/**
+	 * Performs a GJK intersection test seeded from, and updating, a per-pair cache.
+	 * Repeated queries on slowly moving shapes usually finish in one or two iterations.
+	 */
+	KZLIB_API bool Intersect(const FKzShapeInstance& ShapeA, const FVector& PositionA, const FQuat& RotationA,
+								 const FKzShapeInstance& ShapeB, const FVector& PositionB, const FQuat& RotationB,
+								 FSimplexCache& Cache, int32 MaxIterations = 20);
+
+	/** Performs a GJK intersection test between two cached shapes. Pairs whose cached bounds are apart are rejected first. */
+	KZLIB_API bool Intersect(const FKzShapeWorldCache& ShapeA, const FKzShapeWorldCache& ShapeB, int32 MaxIterations = 20);
+
+	/** Same as above, warm starting GJK from a per-pair cache. */
+	KZLIB_API bool Intersect(const FKzShapeWorldCache& ShapeA, const FKzShapeWorldCache& ShapeB, FSimplexCache& Cache, int32 MaxIterations = 20);
+
+	/**
+	 * Computes the penetration between two intersecting convex shapes (GJK followed by EPA).
+	 * Runs entirely on the stack, without heap allocations.
+	 *
+	 * @param OutNormal      Unit direction from A towards B. Moving B by OutNormal * OutDepth separates the shapes.
+	 * @param OutDepth       Penetration depth.
+	 * @param OutContactA    Deepest point of A inside B.
+	 * @param OutContactB    Deepest point of B inside A (OutContactA - OutNormal * OutDepth).
+	 * @param MaxIterations  Iteration cap, applied to GJK and EPA separately.
+	 * @return True if the shapes intersect. Touching shapes may report either no intersection or zero depth.
+	 */
+	KZLIB_API bool Penetration(const FKzShapeInstance& ShapeA, const FVector& PositionA, const FQuat& RotationA,
+								 const FKzShapeInstance& ShapeB, const FVector& PositionB, const FQuat& RotationB,
+								 FVector& OutNormal, float& OutDepth, FVector& OutContactA, FVector& OutContactB,
+								 int32 MaxIterations = 64);
+
+	/**
+	 * Computes the distance and closest points between two convex shapes.
+	 *
+	 * @param OutDistance    Separation distance. Zero if the shapes overlap (see Penetration()).
+	 * @param OutPointA      Closest point on A. Overlapping shapes report a point inside both shapes.
+	 * @param OutPointB      Closest point on B.
+	 * @param OutNormal      Unit direction from A towards B. Zero if the shapes overlap.
+	 * @param MaxDistance    Pairs farther apart than this are rejected, usually after a single iteration.
+	 * @param MaxIterations  Maximum number of GJK iterations.
+	 * @return False if the shapes are farther apart than MaxDistance, in which case the outputs are not set.
+	 */
+	KZLIB_API bool Distance(const FKzShapeInstance& ShapeA, const FVector& PositionA, const FQuat& RotationA,
+							  const FKzShapeInstance& ShapeB, const FVector& PositionB, const FQuat& RotationB,
+							  float& OutDistance, FVector& OutPointA, FVector& OutPointB, FVector& OutNormal,
+							  float MaxDistance = UE_BIG_NUMBER, int32 MaxIterations = 32);
+
+	/**
+	 * Computes the first time of contact between two moving convex shapes (conservative advancement).
+	 * Each shape moves linearly from its start to its end location and rotates at constant angular velocity
+	 * (slerp) between the start and end rotations. Scale is ignored.
+	 *
+	 * Every step advances by the current distance over an upper bound of the closing speed, so the shapes
+	 * are never moved through each other, even for large steps.
+	 *
+	 * @param OutTOI         Fraction of the motion [0, 1] at which the shapes touch. 0 if they start overlapping.
+	 * @param OutNormal      Unit contact normal from A towards B at the time of impact.
+	 * @param Tolerance      Distance at which the shapes are considered touching.
+	 * @param MaxIterations  Iteration cap. If reached before the shapes get within Tolerance, no impact is reported;
+	 *                       long grazing or fast spinning motions may need a higher cap.
+	 * @return True if the shapes come within Tolerance of each other during the motion.
+	 */
+	KZLIB_API bool TimeOfImpact(const FKzShapeInstance& ShapeA, const FTransform& StartA, const FTransform& EndA,
+								  const FKzShapeInstance& ShapeB, const FTransform& StartB, const FTransform& EndB,
+								  float& OutTOI, FVector& OutNormal,
+								  float Tolerance = 0.01f, int32 MaxIterations = 32);
+}
+
+#include "Collision/KzGJK.inl"
\ No newline at end of file
@@ -0,0 +1,514 @@
+// Copyright 2026 kirzo
+
+#include "KzGJK.h"
+
+namespace Kz::GJK
+{
+	namespace Internal
+	{
+		/** A Minkowski difference vertex (A - B), plus the support point on A and the search direction that produced it. */
+		struct FSupportVertex
+		{
+			FVector W;
+			FVector A;
+			FVector Dir;
+		};
+
+		/**
+		 * Simplex for GJK.
+		 * NOTE: This does NOT use the classic GJK convention where the newest point
+		 * is stored at index 0. Here, points are kept in insertion order and the
+		 * newest support point is always Points[NumPoints - 1]. All update functions
+		 * are written to follow this ordering.
+		 *
+		 * Vertices are copied before reordering, since the reductions overwrite slots
+		 * that are read afterwards, and every reduction keeps the newest point last.
+		 */
+		struct FSimplex
+		{
+			/** Adds a new Minkowski support point to the simplex. */
+			void Add(const FVector& P)
+			{
+				Add(FSupportVertex{ P, FVector::ZeroVector, FVector::ZeroVector });
+			}
+
+			/** Adds a new Minkowski support vertex to the simplex, keeping track of its support point on A. */
+			void Add(const FSupportVertex& V)
+			{
+				check(NumPoints < 4);
+				Points[NumPoints++] = V;
+			}
+
+			int32 Num() const { return NumPoints; }
+			const FSupportVertex& operator[](int32 Index) const { return Points[Index]; }
+
+			/** Dispatch to the appropriate simplex evolution function. */
+			bool Next(FVector& Direction)
+			{
+				switch (NumPoints)
+				{
+					case 1: Direction = -Points[0].W; return false;
+					case 2: return Line(Direction);
+					case 3: return Triangle(Direction);
+					case 4: return Tetrahedron(Direction);
+				}
+
+				check(false);
+				return false;
+			}
+
+			/**
+			 * Distance sub-algorithm: reduces the simplex to the smallest sub-simplex supporting the point
+			 * closest to the origin (Johnson's sub-algorithm, evaluated through Voronoi region tests)
+			 * and stores that point's barycentric weights.
+			 *
+			 * @param OutClosest  Point of the simplex closest to the origin.
+			 * @return False if the origin is inside the tetrahedron.
+			 */
+			bool SolveClosestPoint(FVector& OutClosest)
+			{
+				switch (NumPoints)
+				{
+					case 1:
+						Weights[0] = 1.0;
+						OutClosest = Points[0].W;
+						return true;
+
+					case 2:
+						OutClosest = SolveSegment(Points[0], Points[1]);
+						return true;
+
+					case 3:
+						OutClosest = SolveTriangle(Points[0], Points[1], Points[2]);
+						return true;
+
+					case 4:
+						return SolveTetrahedron(OutClosest);
+				}
+
+				check(false);
+				return false;
+			}
+
+			/** Barycentric weight of a vertex, as computed by the last SolveClosestPoint(). */
+			double GetWeight(int32 Index) const { return Weights[Index]; }
+
+			/** Returns the point of shape A matching the last SolveClosestPoint(). */
+			FVector GetClosestPointOnA() const
+			{
+				FVector Result = FVector::ZeroVector;
+				for (int32 i = 0; i < NumPoints; ++i)
+				{
+					Result += Points[i].A * Weights[i];
+				}
+				return Result;
+			}
+
+		private:
+			/** Keeps a single vertex. */
+			FVector SetVertex(const FSupportVertex& A)
+			{
+				Points[0] = A;
+				Weights[0] = 1.0;
+				NumPoints = 1;
+				return A.W;
+			}
+
+			/** Keeps an edge, with the closest point at parameter T from A to B. */
+			FVector SetEdge(const FSupportVertex& A, const FSupportVertex& B, double T)
+			{
+				Points[0] = A;
+				Points[1] = B;
+				Weights[0] = 1.0 - T;
+				Weights[1] = T;
+				NumPoints = 2;
+				return A.W + (B.W - A.W) * T;
+			}
+
+			FVector SolveSegment(const FSupportVertex A, const FSupportVertex B)
+			{
+				const FVector ab = B.W - A.W;
+
+				const double t = FVector::DotProduct(-A.W, ab);
+				if (t <= 0.0)
+				{
+					return SetVertex(A);
+				}
+
+				const double Denom = FVector::DotProduct(ab, ab);
+				if (t >= Denom)
+				{
+					return SetVertex(B);
+				}
+
+				return SetEdge(A, B, t / Denom);
+			}
+
+			FVector SolveTriangle(const FSupportVertex A, const FSupportVertex B, const FSupportVertex C)
+			{
+				const FVector ab = B.W - A.W;
+				const FVector ac = C.W - A.W;
+
+				// Vertex region A
+				const double d1 = FVector::DotProduct(ab, -A.W);
+				const double d2 = FVector::DotProduct(ac, -A.W);
+				if (d1 <= 0.0 && d2 <= 0.0)
+				{
+					return SetVertex(A);
+				}
+
+				// Vertex region B
+				const double d3 = FVector::DotProduct(ab, -B.W);
+				const double d4 = FVector::DotProduct(ac, -B.W);
+				if (d3 >= 0.0 && d4 <= d3)
+				{
+					return SetVertex(B);
+				}
+
+				// Edge region AB
+				const double vc = d1 * d4 - d3 * d2;
+				if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+				{
+					return SetEdge(A, B, d1 / (d1 - d3));
+				}
+
+				// Vertex region C
+				const double d5 = FVector::DotProduct(ab, -C.W);
+				const double d6 = FVector::DotProduct(ac, -C.W);
+				if (d6 >= 0.0 && d5 <= d6)
+				{
+					return SetVertex(C);
+				}
+
+				// Edge region AC
+				const double vb = d5 * d2 - d1 * d6;
+				if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+				{
+					return SetEdge(A, C, d2 / (d2 - d6));
+				}
+
+				// Edge region BC
+				const double va = d3 * d6 - d5 * d4;
+				if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+				{
+					return SetEdge(B, C, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+				}
+
+				// Face region
+				const double Denom = va + vb + vc;
+				if (Denom <= UE_DOUBLE_SMALL_NUMBER)
+				{
+					// Degenerate triangle, fall back to its longest edge.
+					return SolveSegment(A, (ab.SizeSquared() >= ac.SizeSquared()) ? B : C);
+				}
+
+				const double v = vb / Denom;
+				const double w = vc / Denom;
+
+				Points[0] = A;
+				Points[1] = B;
+				Points[2] = C;
+				Weights[0] = 1.0 - v - w;
+				Weights[1] = v;
+				Weights[2] = w;
+				NumPoints = 3;
+				return A.W + ab * v + ac * w;
+			}
+
+			bool SolveTetrahedron(FVector& OutClosest)
+			{
+				const FSupportVertex A = Points[0];
+				const FSupportVertex B = Points[1];
+				const FSupportVertex C = Points[2];
+				const FSupportVertex D = Points[3];
+
+				// Faces paired with the vertex opposite to them.
+				const FSupportVertex Faces[4][4] = { { A, B, C, D }, { A, C, D, B }, { A, D, B, C }, { B, D, C, A } };
+
+				FSimplex Best;
+				FVector BestClosest = FVector::ZeroVector;
+				double BestDistSq = TNumericLimits<double>::Max();
+
+				for (const FSupportVertex (&Face)[4] : Faces)
+				{
+					const FVector Normal = FVector::CrossProduct(Face[1].W - Face[0].W, Face[2].W - Face[0].W);
+					const double SignOrigin = FVector::DotProduct(-Face[0].W, Normal);
+					const double SignOpposite = FVector::DotProduct(Face[3].W - Face[0].W, Normal);
+
+					// Only faces with the origin on their outer side (or flat tetrahedra) can hold the closest point.
+					if (SignOrigin * SignOpposite > 0.0)
+					{
+						continue;
+					}
+
+					FSimplex Candidate;
+					const FVector Closest = Candidate.SolveTriangle(Face[0], Face[1], Face[2]);
+					const double DistSq = Closest.SizeSquared();
+					if (DistSq < BestDistSq)
+					{
+						Best = Candidate;
+						BestClosest = Closest;
+						BestDistSq = DistSq;
+					}
+				}
+
+				if (BestDistSq == TNumericLimits<double>::Max())
+				{
+					// Origin is inside the tetrahedron. Weights of the origin from the signed volumes.
+					const FVector ab = B.W - A.W;
+					const FVector ac = C.W - A.W;
+					const FVector ad = D.W - A.W;
+
+					const double Volume = FVector::DotProduct(ab, FVector::CrossProduct(ac, ad));
+					if (FMath::Abs(Volume) > UE_DOUBLE_SMALL_NUMBER)
+					{
+						Weights[1] = FVector::DotProduct(-A.W, FVector::CrossProduct(ac, ad)) / Volume;
+						Weights[2] = FVector::DotProduct(ab, FVector::CrossProduct(-A.W, ad)) / Volume;
+						Weights[3] = FVector::DotProduct(ab, FVector::CrossProduct(ac, -A.W)) / Volume;
+						Weights[0] = 1.0 - Weights[1] - Weights[2] - Weights[3];
+					}
+					else
+					{
+						Weights[0] = 1.0;
+						Weights[1] = Weights[2] = Weights[3] = 0.0;
+					}
+
+					OutClosest = FVector::ZeroVector;
+					return false;
+				}
+
+				*this = Best;
+				OutClosest = BestClosest;
+				return true;
+			}
+
+			/** Handles the 1D simplex (line segment).
+			 *  Returns false and updates direction to keep searching.
+			 */
+			bool Line(FVector& Direction)
+			{
+				// a = newest point, b = previous point
+				const FSupportVertex A = Points[1];
+				const FSupportVertex B = Points[0];
+
+				const FVector ab = B.W - A.W;
+				const FVector ao = -A.W;
+
+				// If the origin lies beyond A in direction AB
+				if (FVector::DotProduct(ab, ao) > 0.0f)
+				{
+					// New direction is perpendicular to AB towards the origin
+					Direction = FVector::CrossProduct(FVector::CrossProduct(ab, ao), ab);
+				}
+				else
+				{
+					// Drop B, keep only A
+					Points[0] = A;
+					NumPoints = 1;
+					Direction = ao;
+				}
+
+				return false;
+			}
+
+			/** Handles the 2D simplex (triangle). */
+			bool Triangle(FVector& Direction)
+			{
+				// a = newest, then b, then c
+				const FSupportVertex A = Points[2];
+				const FSupportVertex B = Points[1];
+				const FSupportVertex C = Points[0];
+
+				const FVector ab = B.W - A.W;
+				const FVector ac = C.W - A.W;
+				const FVector ao = -A.W;
+
+				const FVector abc = FVector::CrossProduct(ab, ac);
+
+				// Check if origin is outside AC
+				if (FVector::DotProduct(FVector::CrossProduct(abc, ac), ao) > 0.0f)
+				{
+					if (FVector::DotProduct(ac, ao) > 0.0f)
+					{
+						// Reduce to line A-C
+						Points[0] = C;
+						Points[1] = A;
+						NumPoints = 2;
+
+						Direction = FVector::CrossProduct(FVector::CrossProduct(ac, ao), ac);
+					}
+					else
+					{
+						// Reduce to line A-B
+						Points[0] = B;
+						Points[1] = A;
+						NumPoints = 2;
+						return Line(Direction);
+					}
+				}
+				else
+				{
+					// Check if origin is outside AB
+					if (FVector::DotProduct(FVector::CrossProduct(ab, abc), ao) > 0.0f)
+					{
+						// Reduce to line A-B
+						Points[0] = B;
+						Points[1] = A;
+						NumPoints = 2;
+						return Line(Direction);
+					}
+					else
+					{
+						// Origin lies above or below the triangle
+						if (FVector::DotProduct(abc, ao) > 0.0f)
+						{
+							// Above ABC
+							Direction = abc;
+						}
+						else
+						{
+							// Below ABC, flip winding
+							Points[0] = B;
+							Points[1] = C;
+							Points[2] = A;
+							Direction = -abc;
+						}
+					}
+				}
+
+				return false;
+			}
+
+			/** Handles the 3D simplex (tetrahedron). */
+			bool Tetrahedron(FVector& Direction)
+			{
+				// a = newest, then b, c, d
+				const FSupportVertex A = Points[3];
+				const FSupportVertex B = Points[2];
+				const FSupportVertex C = Points[1];
+				const FSupportVertex D = Points[0];
+
+				const FVector ao = -A.W;
+
+				const FVector ab = B.W - A.W;
+				const FVector ac = C.W - A.W;
+				const FVector ad = D.W - A.W;
+
+				const FVector abc = FVector::CrossProduct(ab, ac);
+				const FVector acd = FVector::CrossProduct(ac, ad);
+				const FVector adb = FVector::CrossProduct(ad, ab);
+
+				// Check face ABC
+				if (FVector::DotProduct(abc, ao) > 0.0f)
+				{
+					Points[0] = C;
+					Points[1] = B;
+					Points[2] = A;
+					NumPoints = 3;
+					return Triangle(Direction);
+				}
+
+				// Check face ACD
+				if (FVector::DotProduct(acd, ao) > 0.0f)
+				{
+					Points[0] = D;
+					Points[1] = C;
+					Points[2] = A;
+					NumPoints = 3;
+					return Triangle(Direction);
+				}
+
+				// Check face ADB
+				if (FVector::DotProduct(adb, ao) > 0.0f)
+				{
+					Points[0] = B;
+					Points[1] = D;
+					Points[2] = A;
+					NumPoints = 3;
+					return Triangle(Direction);
+				}
+
+				// Origin is inside the tetrahedron
+				return true;
+			}
+
+			FSupportVertex Points[4];
+			double Weights[4] = { 1.0, 0.0, 0.0, 0.0 };
+			int32 NumPoints = 0;
+		};
+
+		/**
+		 * Support mapping of the Minkowski difference A - B for concrete shape types, evaluated in the local frame of A.
+		 * The transform of B relative to A is computed once, and the support calls are bound statically so they inline.
+		 */
+		template <typename ShapeTypeA, typename ShapeTypeB>
+		struct TMinkowskiSupport
+		{
+			TMinkowskiSupport(const ShapeTypeA& InShapeA, const FVector& PositionA, const FQuat& RotationA, const ShapeTypeB& InShapeB, const FVector& PositionB, const FQuat& RotationB)
+				: ShapeA(InShapeA)
+				, ShapeB(InShapeB)
+				, RelativePosition(RotationA.UnrotateVector(PositionB - PositionA))
+				, RelativeRotation(RotationA.Inverse() * RotationB)
+			{
+			}
+
+			FORCEINLINE FVector operator()(const FVector& Dir) const
+			{
+				const FVector sA = ShapeA.ShapeTypeA::GetSupportPoint(Dir);
+				const FVector sB = RelativePosition + RelativeRotation.RotateVector(ShapeB.ShapeTypeB::GetSupportPoint(RelativeRotation.UnrotateVector(-Dir)));
+				return sA - sB;
+			}
+
+			const ShapeTypeA& ShapeA;
+			const ShapeTypeB& ShapeB;
+			FVector RelativePosition;
+			FQuat RelativeRotation;
+		};
+
+		/** GJK intersection loop over any support mapping of a Minkowski difference. */
+		template <typename TSupportFunc>
+		bool Intersect(const TSupportFunc& Support, int32 MaxIterations)
+		{
+			// This direction could be random.
+			FVector Dir = FVector::OneVector;
+
+			FVector SupportPoint = Support(Dir);
+
+			FSimplex Simplex;
+			Simplex.Add(SupportPoint);
+
+			Dir = -SupportPoint;
+
+			for (int32 i = MaxIterations; --i;)
+			{
+				// The origin lies on the simplex (eg. collinear support points): the shapes touch or overlap.
+				if (Dir.IsNearlyZero(UE_KINDA_SMALL_NUMBER))
+				{
+					return true;
+				}
+
+				SupportPoint = Support(Dir);
+
+				if (FVector::DotProduct(SupportPoint, Dir) < UE_KINDA_SMALL_NUMBER * Dir.Size())
+				{
+					return false; // No intersection
+				}
+
+				Simplex.Add(SupportPoint);
+
+				if (Simplex.Next(Dir))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+	}
+
+	template <typename ShapeTypeA, typename ShapeTypeB, typename>
+	bool Intersect(const ShapeTypeA& ShapeA, const FVector& PositionA, const FQuat& RotationA, const ShapeTypeB& ShapeB, const FVector& PositionB, const FQuat& RotationB, int32 MaxIterations)
+	{
+		return Internal::Intersect(Internal::TMinkowskiSupport<ShapeTypeA, ShapeTypeB>(ShapeA, PositionA, RotationA, ShapeB, PositionB, RotationB), MaxIterations);
+	}
+}
\ No newline at end of file
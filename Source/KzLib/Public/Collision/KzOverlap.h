@@ -0,0 +1,97 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
+#include "Containers/BitArray.h"
+
+struct FKzShapeInstance;
+struct FKzShapeWorldCache;
+struct FKzShapeValue;
+
+namespace Kz::GJK
+{
+	struct FSimplexCache;
+}
+
+namespace Kz::Overlap
+{
+	// Fast path: Sphere vs Sphere
+	KZLIB_API bool SphereSphere(const FVector& CenterA, float RadiusA, const FVector& CenterB, float RadiusB);
+
+	// Fast path: Sphere vs Capsule
+	KZLIB_API bool SphereCapsule(const FVector& SphereCenter, float SphereRadius, const FVector& CapsuleCenter, const FQuat& CapsuleRotation, float CapsuleRadius, float CapsuleHalfHeight);
+
+	// Fast path: Capsule vs Capsule
+	KZLIB_API bool CapsuleCapsule(const FVector& CenterA, const FQuat& RotationA, float RadiusA, float HalfHeightA, const FVector& CenterB, const FQuat& RotationB, float RadiusB, float HalfHeightB);
+
+	// Fast path: Sphere vs Box (OBB)
+	KZLIB_API bool SphereBox(const FVector& SphereCenter, float SphereRadius, const FVector& BoxCenter, const FQuat& BoxRotation, const FVector& BoxHalfSize);
+
+	// Fast path: Box vs Box (OBB, separating axis test)
+	KZLIB_API bool BoxBox(const FVector& CenterA, const FQuat& RotationA, const FVector& HalfSizeA, const FVector& CenterB, const FQuat& RotationB, const FVector& HalfSizeB);
+
+	/** Overlap test between two shapes whose concrete types are known to match the registered pair. */
+	using FOverlapFunc = bool (*)(const FKzShapeInstance& ShapeA, const FVector& PositionA, const FQuat& RotationA, const FKzShapeInstance& ShapeB, const FVector& PositionB, const FQuat& RotationB);
+
+	/**
+	 * Registers an analytic overlap test for a pair of shape types. The reversed pair is registered as well.
+	 * Built-in pairs are registered automatically. Not thread-safe: register during module startup.
+	 */
+	KZLIB_API void RegisterOverlap(const UScriptStruct* TypeA, const UScriptStruct* TypeB, FOverlapFunc Func);
+
+	/** Returns true if an analytic overlap test is registered for a pair of shape types (in either order). */
+	KZLIB_API bool HasOverlap(const UScriptStruct* TypeA, const UScriptStruct* TypeB);
+
+	/**
+	 * Tests two shapes for overlap, using the analytic test of their type pair when one is registered
+	 * and falling back to GJK otherwise.
+	 */
+	KZLIB_API bool Intersect(const FKzShapeInstance& ShapeA, const FVector& PositionA, const FQuat& RotationA,
+							   const FKzShapeInstance& ShapeB, const FVector& PositionB, const FQuat& RotationB);
+
+	/** Same as above, warm starting GJK from a per-pair cache when the pair has no analytic test. */
+	KZLIB_API bool Intersect(const FKzShapeInstance& ShapeA, const FVector& PositionA, const FQuat& RotationA,
+							   const FKzShapeInstance& ShapeB, const FVector& PositionB, const FQuat& RotationB,
+							   Kz::GJK::FSimplexCache& Cache);
+
+	/**
+	 * Tests two cached shapes for overlap. Pairs whose cached bounds are apart are rejected first,
+	 * and pairs without an analytic test run GJK on the cached rotation matrices.
+	 */
+	KZLIB_API bool Intersect(const FKzShapeWorldCache& ShapeA, const FKzShapeWorldCache& ShapeB);
+
+	/** Same as above, warm starting GJK from a per-pair cache when the pair has no analytic test. */
+	KZLIB_API bool Intersect(const FKzShapeWorldCache& ShapeA, const FKzShapeWorldCache& ShapeB, Kz::GJK::FSimplexCache& Cache);
+
+	/**
+	 * Tests two shape values for overlap without touching the heap. Built-in analytic pairs run their fast path,
+	 * the others the devirtualized GJK. Tests registered with RegisterOverlap() are not consulted.
+	 */
+	KZLIB_API bool Intersect(const FKzShapeValue& ShapeA, const FVector& PositionA, const FQuat& RotationA,
+							   const FKzShapeValue& ShapeB, const FVector& PositionB, const FQuat& RotationB);
+
+	/**
+	 * Tests a shape instance against a shape value. Instances holding a built-in shape take the value path above;
+	 * other shape types go through the pair table with the value converted to an instance.
+	 */
+	KZLIB_API bool Intersect(const FKzShapeInstance& ShapeA, const FVector& PositionA, const FQuat& RotationA,
+							   const FKzShapeValue& ShapeB, const FVector& PositionB, const FQuat& RotationB);
+
+	/**
+	 * Tests many candidate pairs (eg. the output of a broadphase) in parallel.
+	 * Pair i is (ShapesA[i], PositionsA[i], RotationsA[i]) against (ShapesB[i], PositionsB[i], RotationsB[i]).
+	 *
+	 * Pairs are split into fixed chunks of 256 that run on worker threads. Each chunk buckets its pairs
+	 * by shape type combination, so every bucket runs a single kernel (the registered analytic test or
+	 * the devirtualized GJK) back to back.
+	 * Registered overlap tests are invoked concurrently and must be thread-safe.
+	 *
+	 * @param OutResults  Resized to the number of pairs. Bit i is set if pair i overlaps.
+	 * @return Number of overlapping pairs.
+	 */
+	KZLIB_API int32 IntersectBatch(TBitArray<>& OutResults,
+							   TConstArrayView<const FKzShapeInstance*> ShapesA, TConstArrayView<FVector> PositionsA, TConstArrayView<FQuat> RotationsA,
+							   TConstArrayView<const FKzShapeInstance*> ShapesB, TConstArrayView<FVector> PositionsB, TConstArrayView<FQuat> RotationsB);
+}
\ No newline at end of file
@@ -22,4 +22,84 @@ namespace Kz::Raycast
 
 	// Fast path: Cylinder (aligned in local Z)
 	KZLIB_API bool Cylinder(FKzHitResult& OutHit, const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight, const FVector& RayStart, const FVector& RayDir, float MaxDistance);
+
+	// Boolean tests: only report whether the ray (within MaxDistance, <= 0 meaning infinite) touches the shape,
+	// including rays starting inside it. No hit data is computed, for any-hit and line of sight queries.
+
+	KZLIB_API bool Sphere(const FVector& Center, float Radius, const FVector& RayStart, const FVector& RayDir, float MaxDistance);
+	KZLIB_API bool Box(const FVector& Center, const FQuat& Rotation, const FVector& Extents, const FVector& RayStart, const FVector& RayDir, float MaxDistance);
+	KZLIB_API bool Capsule(const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight, const FVector& RayStart, const FVector& RayDir, float MaxDistance);
+	KZLIB_API bool Cylinder(const FVector& Center, const FQuat& Rotation, float Radius, float HalfHeight, const FVector& RayStart, const FVector& RayDir, float MaxDistance);
+
+	/** Spheres stored as SoA float arrays of Num elements each. */
+	struct FSphereSoA
+	{
+		const float* CenterX = nullptr;
+		const float* CenterY = nullptr;
+		const float* CenterZ = nullptr;
+		const float* Radius = nullptr;
+		int32 Num = 0;
+	};
+
+	/** Axis-aligned boxes stored as SoA float arrays of Num elements each. */
+	struct FBoxSoA
+	{
+		const float* CenterX = nullptr;
+		const float* CenterY = nullptr;
+		const float* CenterZ = nullptr;
+		const float* ExtentX = nullptr;
+		const float* ExtentY = nullptr;
+		const float* ExtentZ = nullptr;
+		int32 Num = 0;
+	};
+
+	/** Oriented boxes stored as SoA float arrays of Num elements each. Rotations must be normalized. */
+	struct FOrientedBoxSoA
+	{
+		const float* CenterX = nullptr;
+		const float* CenterY = nullptr;
+		const float* CenterZ = nullptr;
+		const float* RotationX = nullptr;
+		const float* RotationY = nullptr;
+		const float* RotationZ = nullptr;
+		const float* RotationW = nullptr;
+		const float* ExtentX = nullptr;
+		const float* ExtentY = nullptr;
+		const float* ExtentZ = nullptr;
+		int32 Num = 0;
+	};
+
+	/** Capsules (aligned in local Z) stored as SoA float arrays of Num elements each. Rotations must be normalized. */
+	struct FCapsuleSoA
+	{
+		const float* CenterX = nullptr;
+		const float* CenterY = nullptr;
+		const float* CenterZ = nullptr;
+		const float* RotationX = nullptr;
+		const float* RotationY = nullptr;
+		const float* RotationZ = nullptr;
+		const float* RotationW = nullptr;
+		const float* Radius = nullptr;
+		const float* HalfHeight = nullptr;
+		int32 Num = 0;
+	};
+
+	/**
+	 * Batch raycasts: test one ray against every primitive of a SoA array, 4 primitives per SIMD register,
+	 * and return the index of the closest hit (INDEX_NONE if nothing is hit). OutHit is only filled for that
+	 * primitive, so OutHit.Distance holds the nearest distance.
+	 *
+	 * Primitives containing RayStart are hit at distance 0 with bStartPenetrating set and the normal facing
+	 * the ray. Ties are resolved towards the lowest index. RayDir must be normalized.
+	 */
+	KZLIB_API int32 SphereBatch(FKzHitResult& OutHit, const FSphereSoA& Spheres, const FVector& RayStart, const FVector& RayDir, float MaxDistance);
+
+	/** Batch raycast against axis-aligned boxes. See SphereBatch(). */
+	KZLIB_API int32 BoxBatch(FKzHitResult& OutHit, const FBoxSoA& Boxes, const FVector& RayStart, const FVector& RayDir, float MaxDistance);
+
+	/** Batch raycast against oriented boxes. See SphereBatch(). */
+	KZLIB_API int32 BoxBatch(FKzHitResult& OutHit, const FOrientedBoxSoA& Boxes, const FVector& RayStart, const FVector& RayDir, float MaxDistance);
+
+	/** Batch raycast against capsules. See SphereBatch(). */
+	KZLIB_API int32 CapsuleBatch(FKzHitResult& OutHit, const FCapsuleSoA& Capsules, const FVector& RayStart, const FVector& RayDir, float MaxDistance);
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/KzShapeComponent.h"
+#include "Collision/KzGJK.h"
 #include "KzSensorComponent.generated.h"
 
 class UKzRegistrySubsystem;
@@ -28,7 +29,7 @@ struct FKzOverlapResult
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FKzSensorObjectEvent, const FKzOverlapResult&, OverlapInfo);
 
 /**
- * A sensor component that detects objects using KzLib's GJK intersection.
+ * A sensor component that detects objects using KzLib's analytic overlap tests, falling back to GJK intersection.
  * Optimized to maintain the link between the Physical Shape and the Logical Object
  * to avoid ambiguous resolution steps.
  */
@@ -101,5 +102,18 @@ private:
 	/** The cache of resolved logical objects and shapes. */
 	TArray<FKzOverlapResult> CachedOverlaps;
 
+	/** GJK warm start data of a shape, and the last scan that tested it. */
+	struct FSimplexCacheEntry
+	{
+		Kz::GJK::FSimplexCache Cache;
+		uint32 ScanStamp = 0;
+	};
+
+	/** GJK warm start data for every shape tested in the last scan. Updated in place, stale entries are dropped after each scan. */
+	TMap<TWeakObjectPtr<UKzShapeComponent>, FSimplexCacheEntry> SimplexCaches;
+
+	/** Incremented by every scan, to find the entries of SimplexCaches the scan did not test. */
+	uint32 ScanStamp = 0;
+
 	float TimeSinceLastScan = 0.0f;
 };
\ No newline at end of file
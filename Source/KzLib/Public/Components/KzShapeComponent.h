@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/ShapeComponent.h"
 #include "Math/Geometry/KzShapeInstance.h"
+#include "Math/Geometry/KzShapeWorldCache.h"
 #include "KzShapeComponent.generated.h"
 
 /** A component that defines a renderable geometric shape using the KzLib shape system. */
@@ -14,10 +15,6 @@ class KZLIB_API UKzShapeComponent : public UShapeComponent
 	GENERATED_BODY()
 
 public:
-	/** Shape definition (sphere, box, capsule, etc.) */
-	UPROPERTY(EditAnywhere, Category = Shape, meta = (ShowOnlyInnerProperties))
-	FKzShapeInstance Shape;
-
 	/** If true, solid geometry will be rendered in addition to wireframe. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, export, Category = Shape, AdvancedDisplay)
 	bool bDrawSolid = false;
@@ -25,10 +22,30 @@ public:
 public:
 	UKzShapeComponent();
 
+	/** Returns the shape definition. Changes go through SetShape(), so the world cache never sees a stale shape. */
+	UFUNCTION(BlueprintPure, Category = Shape)
+	const FKzShapeInstance& GetShape() const { return Shape; }
+
+	/** Replaces the shape, refreshing the render state and the world cache. */
+	UFUNCTION(BlueprintCallable, Category = Shape)
+	void SetShape(const FKzShapeInstance& InShape);
+
+	/**
+	 * Returns the shape in world space (scaled, with its rotation matrices and bounds), for repeated queries.
+	 * The cache is refreshed when the component is registered, moved or given a new shape, so reading it
+	 * never writes: parallel and async queries may call this concurrently while the component stays put.
+	 */
+	const FKzShapeWorldCache& GetWorldCache() const { return WorldCache; }
+
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
 #endif
 
+	//~ Begin UActorComponent Interface.
+	virtual void OnRegister() override;
+	//~ End UActorComponent Interface.
+
 	//~ Begin UPrimitiveComponent Interface.
 	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
 	virtual bool IsZeroExtent() const override;
@@ -38,9 +55,21 @@ public:
 	//~ Begin USceneComponent Interface
 	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
 	virtual void CalcBoundingCylinder(float& CylinderRadius, float& CylinderHalfHeight) const override;
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport = ETeleportType::None) override;
 	//~ End USceneComponent Interface
 
 	//~ Begin UShapeComponent Interface
 	virtual void UpdateBodySetup() override;
 	//~ End UShapeComponent Interface
+
+private:
+	/** Shape definition (sphere, box, capsule, etc.) */
+	UPROPERTY(EditAnywhere, Category = Shape, meta = (ShowOnlyInnerProperties))
+	FKzShapeInstance Shape;
+
+	/** Rebuilds the world cache from the shape and the component transform. */
+	void UpdateWorldCache() { WorldCache.Update(Shape, GetComponentTransform()); }
+
+	/** World space data of the shape, see GetWorldCache(). */
+	FKzShapeWorldCache WorldCache;
 };
\ No newline at end of file
@@ -276,6 +276,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "KzLib|Geometry", meta = (DisplayName = "Cylinder Intersects Point"))
 	static bool CylinderIntersectsPoint(const FVector Center, float Radius, float HalfHeight, const FRotator Rotation, FVector Point);
 
+	// === Convex ===
+
+	/** Static utility function to make the convex hull of a set of points */
+	UFUNCTION(BlueprintPure, Category = "KzLib|Geometry")
+	static FKzShapeInstance MakeConvex(const TArray<FVector>& Points);
+
 	// === Geometry ===
 
 	/**
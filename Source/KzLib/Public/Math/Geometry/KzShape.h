@@ -67,6 +67,12 @@ public:
 		return false; // base: no fast path
 	}
 
+	/**
+	 * Returns true if a ray touches this shape, without computing the hit data (eg. for line of sight).
+	 * Should only be called if ImplementsRaycast() returns true. Defaults to Raycast() into a scratch hit.
+	 */
+	virtual bool RaycastTest(const FVector& Position, const FQuat& Orientation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const;
+
 	/** Returns the farthest point in the given direction, in local space. */
 	virtual FVector GetSupportPoint(const FVector& Direction) const PURE_VIRTUAL(FKzShape::GetSupportPoint, return {};);
 };
\ No newline at end of file
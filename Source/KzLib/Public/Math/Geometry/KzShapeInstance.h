@@ -204,6 +204,9 @@ public:
 		return Shape.GetMutablePtr<T>();
 	}
 
+	/** Returns the script struct of the contained shape, or nullptr if the instance is not valid. */
+	FORCEINLINE const UScriptStruct* GetScriptStruct() const { return Shape.GetScriptStruct(); }
+
 	/** Returns true if the contained shape instance is valid. */
 	FORCEINLINE bool IsValid() const { return Shape.IsValid(); }
 
@@ -255,6 +258,15 @@ public:
 		return IsValid() ? Shape.Get().Raycast(OutHit, Position, Orientation, RayStart, RayDir, MaxDistance) : false;
 	}
 
+	/**
+	 * Returns true if a ray touches this shape, without computing the hit data.
+	 * Should only be called if ImplementsRaycast() returns true.
+	 */
+	FORCEINLINE bool RaycastTest(const FVector& Position, const FQuat& Orientation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+	{
+		return IsValid() ? Shape.Get().RaycastTest(Position, Orientation, RayStart, RayDir, MaxDistance) : false;
+	}
+
 	/** Returns the farthest point in the given direction, in local space. */
 	FORCEINLINE FVector GetSupportPoint(const FVector& Direction) const
 	{
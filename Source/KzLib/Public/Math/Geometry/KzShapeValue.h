@@ -0,0 +1,160 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Math/Geometry/KzShapeInstance.h"
+#include "Math/Geometry/Shapes/KzSphere.h"
+#include "Math/Geometry/Shapes/KzBox.h"
+#include "Math/Geometry/Shapes/KzCapsule.h"
+#include "Math/Geometry/Shapes/KzCylinder.h"
+
+/** Built-in shape types an FKzShapeValue can hold. */
+enum class EKzShapeValueType : uint8
+{
+	Sphere,
+	Box,
+	Capsule,
+	Cylinder
+};
+
+/**
+ * Compact value form of the built-in shapes (sphere, box, capsule and cylinder).
+ *
+ * Holds the type and its parameters inline in 32 bytes, with no vtable and no heap storage, so hot paths
+ * (broadphase Semantics, batched queries) can build, copy and pass shapes by value. The concrete shape is
+ * rebuilt on the stack by Visit(), which lets GJK and the overlap tests bind its support mapping at compile time.
+ * Other shape types only exist as FKzShapeInstance; see TryFrom().
+ */
+struct KZLIB_API FKzShapeValue
+{
+	/** A default FKzSphere, like a default FKzShapeInstance. */
+	FKzShapeValue()
+		: Params(FKzSphere().Radius, 0.0, 0.0), Type(EKzShapeValueType::Sphere)
+	{
+	}
+
+	explicit FKzShapeValue(const FKzSphere& Sphere)
+		: Params(Sphere.Radius, 0.0, 0.0), Type(EKzShapeValueType::Sphere)
+	{
+	}
+
+	explicit FKzShapeValue(const FKzBox& Box)
+		: Params(Box.HalfSize), Type(EKzShapeValueType::Box)
+	{
+	}
+
+	explicit FKzShapeValue(const FKzCapsule& Capsule)
+		: Params(Capsule.Radius, Capsule.HalfHeight, 0.0), Type(EKzShapeValueType::Capsule)
+	{
+	}
+
+	explicit FKzShapeValue(const FKzCylinder& Cylinder)
+		: Params(Cylinder.Radius, Cylinder.HalfHeight, 0.0), Type(EKzShapeValueType::Cylinder)
+	{
+	}
+
+	/** Converts a shape instance holding a built-in shape. Returns false, leaving OutValue untouched, for other shape types. */
+	static bool TryFrom(const FKzShapeInstance& Shape, FKzShapeValue& OutValue);
+
+	/** Returns the shape as an instance. Allocates; meant for the paths that need a type the value cannot hold. */
+	FKzShapeInstance ToInstance() const;
+
+	FORCEINLINE EKzShapeValueType GetType() const { return Type; }
+
+	/** Radius of a sphere, capsule or cylinder. */
+	FORCEINLINE float GetRadius() const
+	{
+		checkSlow(Type != EKzShapeValueType::Box);
+		return static_cast<float>(Params.X);
+	}
+
+	/** Half height of a capsule or cylinder. */
+	FORCEINLINE float GetHalfHeight() const
+	{
+		checkSlow(Type == EKzShapeValueType::Capsule || Type == EKzShapeValueType::Cylinder);
+		return static_cast<float>(Params.Y);
+	}
+
+	/** Half size of a box. */
+	FORCEINLINE const FVector& GetHalfSize() const
+	{
+		checkSlow(Type == EKzShapeValueType::Box);
+		return Params;
+	}
+
+	/** Calls Func with the concrete shape, built on the stack, and returns its result. */
+	template <typename TFunc>
+	FORCEINLINE decltype(auto) Visit(TFunc&& Func) const
+	{
+		switch (Type)
+		{
+		case EKzShapeValueType::Box:
+			return Func(FKzBox(Params));
+		case EKzShapeValueType::Capsule:
+			return Func(FKzCapsule(static_cast<float>(Params.X), static_cast<float>(Params.Y)));
+		case EKzShapeValueType::Cylinder:
+			return Func(FKzCylinder(static_cast<float>(Params.X), static_cast<float>(Params.Y)));
+		default:
+			return Func(FKzSphere(static_cast<float>(Params.X)));
+		}
+	}
+
+	/** Returns true if this shape has zero extent (e.g. radius or half-size is zero). */
+	FORCEINLINE bool IsZeroExtent() const
+	{
+		return Visit([](const auto& Shape) { return Shape.IsZeroExtent(); });
+	}
+
+	/** Computes the world-space axis-aligned bounding box (AABB) for this shape. */
+	FORCEINLINE FBox GetBoundingBox(const FVector& Position, const FQuat& Orientation) const
+	{
+		return Visit([&](const auto& Shape) { return Shape.GetBoundingBox(Position, Orientation); });
+	}
+
+	/** Returns the closest point on (or inside) this shape to a given world-space point. */
+	FORCEINLINE FVector GetClosestPoint(const FVector& Position, const FQuat& Orientation, const FVector& Point) const
+	{
+		return Visit([&](const auto& Shape) { return Shape.GetClosestPoint(Position, Orientation, Point); });
+	}
+
+	/** Checks whether a world-space point lies inside (or on the surface of) this shape. */
+	FORCEINLINE bool IntersectsPoint(const FVector& Position, const FQuat& Orientation, const FVector& Point) const
+	{
+		return Visit([&](const auto& Shape) { return Shape.IntersectsPoint(Position, Orientation, Point); });
+	}
+
+	/** Returns the farthest point of the shape along a local space direction. */
+	FORCEINLINE FVector GetSupportPoint(const FVector& Direction) const
+	{
+		return Visit([&](const auto& Shape) { return Shape.GetSupportPoint(Direction); });
+	}
+
+	FORCEINLINE FKzShapeValue operator+(float Inflation) const
+	{
+		return Visit([&](const auto& Shape) { return FKzShapeValue(Shape + Inflation); });
+	}
+
+	FORCEINLINE FKzShapeValue operator+(const FVector& Inflation) const
+	{
+		return Visit([&](const auto& Shape) { return FKzShapeValue(Shape + Inflation); });
+	}
+
+	FORCEINLINE FKzShapeValue operator*(float Scale) const
+	{
+		return Visit([&](const auto& Shape) { return FKzShapeValue(Shape * Scale); });
+	}
+
+	FORCEINLINE FKzShapeValue operator*(const FVector& Scale) const
+	{
+		return Visit([&](const auto& Shape) { return FKzShapeValue(Shape * Scale); });
+	}
+
+private:
+	/** Box half size, or (Radius, HalfHeight, 0) for the other types. */
+	FVector Params;
+
+	EKzShapeValueType Type;
+};
+
+static_assert(sizeof(FKzShapeValue) <= 32, "FKzShapeValue must stay small enough to pass by value.");
+static_assert(std::is_trivially_copyable_v<FKzShapeValue>, "FKzShapeValue must stay trivially copyable.");
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Math/Geometry/KzShapeInstance.h"
+
+/**
+ * World space data of a placed shape, for shapes queried many times between moves (eg. components scanned by sensors).
+ *
+ * Holds the shape with the transform scale already applied, the rotation as matrices and the world bounds, so the
+ * queries taking a cache skip the scaled copy, the virtual bounds call and the quaternion rotations, and reject
+ * distant pairs and rays on the bounds alone. Call Update() when the shape or the scale changes, and
+ * UpdateTransform() when only the location or rotation did.
+ */
+struct KZLIB_API FKzShapeWorldCache
+{
+	/** The shape, with the transform scale applied. */
+	FKzShapeInstance Shape;
+
+	FVector Position = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+
+	/** Local to world rotation. */
+	FMatrix RotationMatrix = FMatrix::Identity;
+
+	/** World to local rotation, the transpose of RotationMatrix. */
+	FMatrix InverseRotationMatrix = FMatrix::Identity;
+
+	/** World space bounding box. */
+	FBox Bounds = FBox(ForceInit);
+
+	/** World space bounding sphere, enclosing the local bounds of the shape. */
+	FSphere BoundingSphere = FSphere(ForceInit);
+
+	/** Rebuilds the cache from an unscaled shape and its transform. */
+	void Update(const FKzShapeInstance& InShape, const FTransform& Transform);
+
+	/** Moves the cached shape. The scale must not have changed since the last Update(). */
+	void UpdateTransform(const FVector& InPosition, const FQuat& InRotation);
+
+	/** Returns the scale applied to the cached shape. */
+	FORCEINLINE const FVector& GetScale() const { return Scale; }
+
+	/** Returns true if the cache holds a shape. */
+	FORCEINLINE bool IsValid() const { return Shape.IsValid() && Bounds.IsValid; }
+
+	/** Rotates a world space direction into the local frame of the shape. */
+	FORCEINLINE FVector ToLocalVector(const FVector& Vector) const { return InverseRotationMatrix.TransformVector(Vector); }
+
+	/** Transforms a local space point of the shape into world space. */
+	FORCEINLINE FVector ToWorldPoint(const FVector& Point) const { return Position + RotationMatrix.TransformVector(Point); }
+
+	/** Returns the farthest point of the shape along a world space direction, in world space. */
+	FORCEINLINE FVector GetSupportPoint(const FVector& Direction) const
+	{
+		return ToWorldPoint(Shape.GetSupportPoint(ToLocalVector(Direction)));
+	}
+
+	/** Returns false if the bounds prove the shapes apart. */
+	FORCEINLINE bool IntersectsBounds(const FKzShapeWorldCache& Other) const
+	{
+		return FVector::DistSquared(BoundingSphere.Center, Other.BoundingSphere.Center) <= FMath::Square(BoundingSphere.W + Other.BoundingSphere.W) && Bounds.Intersect(Other.Bounds);
+	}
+
+	/** Returns false if the bounding sphere proves a ray (with a normalized direction) misses the shape. MaxDistance <= 0 means infinite. */
+	FORCEINLINE bool RayIntersectsBounds(const FVector& RayStart, const FVector& RayDir, float MaxDistance) const
+	{
+		const FVector ToCenter = BoundingSphere.Center - RayStart;
+		const double DistSq = ToCenter.SizeSquared();
+		const double RadiusSq = FMath::Square(BoundingSphere.W);
+		if (DistSq <= RadiusSq)
+		{
+			return true; // Starts inside.
+		}
+
+		const double Along = FVector::DotProduct(ToCenter, RayDir);
+		if (Along < 0.0 || (MaxDistance > 0.0f && Along - BoundingSphere.W > MaxDistance))
+		{
+			return false;
+		}
+
+		return DistSq - FMath::Square(Along) <= RadiusSq;
+	}
+
+private:
+	/** Scale applied to Shape. */
+	FVector Scale = FVector::OneVector;
+
+	/** Center of the local bounds of the scaled shape. */
+	FVector LocalCenter = FVector::ZeroVector;
+};
\ No newline at end of file
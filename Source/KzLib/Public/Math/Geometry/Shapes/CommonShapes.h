@@ -5,4 +5,8 @@
 #include "KzSphere.h"
 #include "KzBox.h"
 #include "KzCapsule.h"
-#include "KzCylinder.h"
\ No newline at end of file
+#include "KzCylinder.h"
+#include "KzConvex.h"
+#include "KzTriangleMesh.h"
+#include "KzHeightfield.h"
+#include "KzCompoundShape.h"
\ No newline at end of file
@@ -0,0 +1,249 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Math/Geometry/KzShape.h"
+#include "Math/Geometry/KzShapeInstance.h"
+#include "KzCompoundShape.generated.h"
+
+/** A child of a compound shape, placed in the local space of the compound. */
+USTRUCT(BlueprintType)
+struct KZLIB_API FKzCompoundChild
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Kz")
+	FKzShapeInstance Shape;
+
+	UPROPERTY(EditAnywhere, Category = "Kz")
+	FVector Position = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, Category = "Kz")
+	FQuat Rotation = FQuat::Identity;
+
+	FKzCompoundChild() = default;
+
+	FKzCompoundChild(const FKzShapeInstance& InShape, const FVector& InPosition = FVector::ZeroVector, const FQuat& InRotation = FQuat::Identity)
+		: Shape(InShape), Position(InPosition), Rotation(InRotation)
+	{
+	}
+};
+
+/** Node of the bounding volume hierarchy of a compound shape. */
+USTRUCT()
+struct KZLIB_API FKzCompoundNode
+{
+	GENERATED_BODY()
+
+	/** Local space bounds of the children below this node. */
+	UPROPERTY()
+	FBox Bounds = FBox(ForceInit);
+
+	/** Child shape of a leaf, or INDEX_NONE for interior nodes. */
+	UPROPERTY()
+	int32 Child = INDEX_NONE;
+
+	/** First child node of an interior node. The second one follows it. */
+	UPROPERTY()
+	int32 FirstNode = INDEX_NONE;
+
+	bool IsLeaf() const { return Child != INDEX_NONE; }
+};
+
+/**
+ * Several shapes queried as one, eg. an actor made of a few primitives.
+ *
+ * Broadphases see a single element with the bounds of all children, and narrow phase queries only visit the
+ * children whose bounds pass, through a small hierarchy built by Build(). Overlaps and raycasts are exact per
+ * child; support-based queries (GJK against the compound itself) see the convex hull of the children.
+ */
+USTRUCT(BlueprintType, meta = (DisplayName = "Compound"))
+struct KZLIB_API FKzCompoundShape : public FKzShape
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Kz")
+	TArray<FKzCompoundChild> Children;
+
+	/** Bounding volume hierarchy over the children, one leaf per child. Node 0 is the root. */
+	UPROPERTY()
+	TArray<FKzCompoundNode> Nodes;
+
+	FKzCompoundShape() = default;
+
+	explicit FKzCompoundShape(TArray<FKzCompoundChild> InChildren)
+		: Children(MoveTemp(InChildren))
+	{
+		Build();
+	}
+
+	/** Adds a child and rebuilds the hierarchy. */
+	void AddChild(const FKzShapeInstance& Shape, const FVector& Position = FVector::ZeroVector, const FQuat& Rotation = FQuat::Identity)
+	{
+		Children.Emplace(Shape, Position, Rotation);
+		Build();
+	}
+
+	/** Rebuilds the hierarchy from the children, eg. after editing them. */
+	void Build();
+
+	/** Returns true if the hierarchy matches the children. */
+	bool HasValidHierarchy() const
+	{
+		return Children.Num() > 0 && Nodes.Num() == 2 * Children.Num() - 1;
+	}
+
+	/** Calls Func(ChildIndex) for every child whose bounds overlap a local space box. Func returns false to stop. */
+	template <typename TFunc>
+	void ForEachChild(const FBox& Box, TFunc&& Func) const
+	{
+		if (!HasValidHierarchy())
+		{
+			return;
+		}
+
+		TArray<int32, TInlineAllocator<32>> Stack;
+		Stack.Add(0);
+
+		while (Stack.Num() > 0)
+		{
+			const FKzCompoundNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+			if (!Node.Bounds.Intersect(Box))
+			{
+				continue;
+			}
+
+			if (Node.IsLeaf())
+			{
+				if (!Func(Node.Child))
+				{
+					return;
+				}
+			}
+			else
+			{
+				Stack.Add(Node.FirstNode + 1);
+				Stack.Add(Node.FirstNode);
+			}
+		}
+	}
+
+	virtual bool IsZeroExtent() const override
+	{
+		return !HasValidHierarchy();
+	}
+
+	virtual void Sanitize() override
+	{
+		if (!HasValidHierarchy() && Children.Num() > 0)
+		{
+			Build();
+		}
+	}
+
+	/** Tests a shape against the children whose bounds overlap it, with Kz::Overlap::Intersect(). */
+	bool IntersectsShape(const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FVector& Center, const FQuat& Rotation) const;
+
+	virtual FBox GetBoundingBox(const FVector& Center, const FQuat& Rotation) const override;
+	virtual FVector GetClosestPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const override;
+	virtual bool IntersectsPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const override;
+	virtual FCollisionShape ToCollisionShape(float Inflation) const override;
+
+	FORCEINLINE FKzCompoundShape operator+(float Inflation) const
+	{
+		FKzCompoundShape Result(*this);
+		Result.Inflate(Inflation);
+		return Result;
+	}
+
+	FORCEINLINE FKzCompoundShape& operator+=(float Inflation)
+	{
+		this->Inflate(Inflation);
+		return *this;
+	}
+
+	FORCEINLINE FKzCompoundShape operator+(const FVector& Inflation) const
+	{
+		FKzCompoundShape Result(*this);
+		Result.Inflate(Inflation);
+		return Result;
+	}
+
+	FORCEINLINE FKzCompoundShape& operator+=(const FVector& Inflation)
+	{
+		this->Inflate(Inflation);
+		return *this;
+	}
+
+	FORCEINLINE FKzCompoundShape operator*(float Scale) const
+	{
+		FKzCompoundShape Result(*this);
+		Result.Scale(Scale);
+		return Result;
+	}
+
+	FORCEINLINE FKzCompoundShape& operator*=(float Scale)
+	{
+		this->Scale(Scale);
+		return *this;
+	}
+
+	FORCEINLINE FKzCompoundShape operator*(const FVector& Scale) const
+	{
+		FKzCompoundShape Result(*this);
+		Result.Scale(Scale);
+		return Result;
+	}
+
+	FORCEINLINE FKzCompoundShape& operator*=(const FVector& Scale)
+	{
+		this->Scale(Scale);
+		return *this;
+	}
+
+	/** Inflates every child. */
+	virtual void Inflate(float Inflation) override;
+
+	/** Inflates every child by the inflation expressed in its own frame. */
+	virtual void Inflate(const FVector& Inflation) override;
+
+	virtual void Scale(float Scale) override
+	{
+		this->Scale(FVector(Scale));
+	}
+
+	/**
+	 * Scales the child positions, and every child by the scale expressed in its own frame.
+	 * Exact for children aligned with the compound axes, approximate for other rotations under non-uniform scale.
+	 */
+	virtual void Scale(const FVector& Scale) override;
+
+	virtual FVector GetSupportPoint(const FVector& Direction) const override;
+
+	virtual bool ImplementsRaycast() const override { return true; }
+	virtual bool Raycast(struct FKzHitResult& OutHit, const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const override;
+	virtual bool RaycastTest(const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const override;
+
+	virtual void DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines = false, float LifeTime = -1.f, uint8 DepthPriority = 0, float Thickness = 0.f) const override;
+	virtual void DrawSceneProxy(FPrimitiveDrawInterface* PDI, const FMatrix& LocalToWorld, const FLinearColor& Color, bool bDrawSolid, float Thickness, int32 ViewIndex, FMeshElementCollector& Collector) const override;
+};
+
+FORCEINLINE FKzCompoundShape operator+(float Inflation, const FKzCompoundShape& Shape)
+{
+	return Shape.operator+(Inflation);
+}
+
+FORCEINLINE FKzCompoundShape operator+(const FVector& Inflation, const FKzCompoundShape& Shape)
+{
+	return Shape.operator+(Inflation);
+}
+
+FORCEINLINE FKzCompoundShape operator*(float Scale, const FKzCompoundShape& Shape)
+{
+	return Shape.operator*(Scale);
+}
+
+FORCEINLINE FKzCompoundShape operator*(const FVector& Scale, const FKzCompoundShape& Shape)
+{
+	return Shape.operator*(Scale);
+}
\ No newline at end of file
@@ -0,0 +1,190 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Math/Geometry/KzShape.h"
+#include "Containers/ArrayView.h"
+#include "KzConvex.generated.h"
+
+struct FKConvexElem;
+struct FKAggregateGeom;
+
+/**
+ * Convex hull of a set of points, in local space.
+ *
+ * The hull triangles, face planes and vertex adjacency are derived from Vertices by Build().
+ * Support queries hill-climb the vertex adjacency graph from the vertex found by the previous query,
+ * so coherent queries (GJK iterations, scans of the same target) only visit a few vertices.
+ */
+USTRUCT(BlueprintType, meta = (DisplayName = "Convex"))
+struct KZLIB_API FKzConvex : public FKzShape
+{
+	GENERATED_BODY()
+
+	/** Hull vertices. Points inside the hull are removed by Build(). */
+	UPROPERTY(EditAnywhere, Category = "Kz")
+	TArray<FVector> Vertices;
+
+	/** Outward facing (counter-clockwise) hull triangles, three vertex indices each. */
+	UPROPERTY()
+	TArray<int32> Indices;
+
+	/** Face planes, coplanar triangles merged. Normals point outwards. */
+	UPROPERTY()
+	TArray<FPlane> Planes;
+
+	/** Neighbors of vertex i are stored in Adjacency[AdjacencyOffsets[i], AdjacencyOffsets[i + 1]). */
+	UPROPERTY()
+	TArray<int32> AdjacencyOffsets;
+
+	/** Vertex neighbors along the hull edges. */
+	UPROPERTY()
+	TArray<int32> Adjacency;
+
+	FKzConvex() = default;
+
+	explicit FKzConvex(TConstArrayView<FVector> Points)
+	{
+		Build(Points);
+	}
+
+	/** Replaces the hull with the convex hull of the given points. */
+	void Build(TConstArrayView<FVector> Points);
+
+	/** Rebuilds the hull from Vertices, eg. after editing them. */
+	void Build();
+
+	/** Returns true if the derived hull data matches Vertices. */
+	bool HasValidHull() const
+	{
+		return Planes.Num() >= 4 && AdjacencyOffsets.Num() == Vertices.Num() + 1;
+	}
+
+	/** Makes a hull from a physics asset convex element, in the space of the body it belongs to. */
+	static FKzConvex FromConvexElem(const FKConvexElem& ConvexElem);
+
+	/** Makes one hull per convex element of an aggregate geometry (eg. UBodySetup::AggGeom). */
+	static void FromAggregateGeom(const FKAggregateGeom& AggGeom, TArray<FKzConvex>& OutHulls);
+
+	virtual bool IsZeroExtent() const override
+	{
+		return !HasValidHull();
+	}
+
+	virtual void Sanitize() override
+	{
+		if (!HasValidHull() && Vertices.Num() > 0)
+		{
+			Build();
+		}
+	}
+
+	virtual FBox GetBoundingBox(const FVector& Center, const FQuat& Rotation) const override;
+	virtual FVector GetClosestPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const override;
+	virtual bool IntersectsPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const override;
+	virtual FCollisionShape ToCollisionShape(float Inflation) const override;
+
+	FORCEINLINE FKzConvex operator+(float Inflation) const
+	{
+		FKzConvex Result(*this);
+		Result.Inflate(Inflation);
+		return Result;
+	}
+
+	FORCEINLINE FKzConvex& operator+=(float Inflation)
+	{
+		this->Inflate(Inflation);
+		return *this;
+	}
+
+	FORCEINLINE FKzConvex operator+(const FVector& Inflation) const
+	{
+		FKzConvex Result(*this);
+		Result.Inflate(Inflation);
+		return Result;
+	}
+
+	FORCEINLINE FKzConvex& operator+=(const FVector& Inflation)
+	{
+		this->Inflate(Inflation);
+		return *this;
+	}
+
+	FORCEINLINE FKzConvex operator*(float Scale) const
+	{
+		FKzConvex Result(*this);
+		Result.Scale(Scale);
+		return Result;
+	}
+
+	FORCEINLINE FKzConvex& operator*=(float Scale)
+	{
+		this->Scale(Scale);
+		return *this;
+	}
+
+	FORCEINLINE FKzConvex operator*(const FVector& Scale) const
+	{
+		FKzConvex Result(*this);
+		Result.Scale(Scale);
+		return Result;
+	}
+
+	FORCEINLINE FKzConvex& operator*=(const FVector& Scale)
+	{
+		this->Scale(Scale);
+		return *this;
+	}
+
+	/**
+	 * Pushes every face plane outwards by Inflation and rebuilds the hull from the offset planes, so every face
+	 * ends up exactly Inflation away from the original one. Encloses the Minkowski sum with a sphere.
+	 * Flat hulls become slabs Inflation thick on each side; points and segments are swept by a cube.
+	 */
+	virtual void Inflate(float Inflation) override;
+
+	/** Pushes every face plane outwards by the extent of a box with half size Inflation along its normal, and rebuilds the hull. */
+	virtual void Inflate(const FVector& Inflation) override;
+
+	virtual void Scale(float Scale) override
+	{
+		this->Scale(FVector(Scale));
+	}
+
+	virtual void Scale(const FVector& Scale) override;
+
+	virtual FVector GetSupportPoint(const FVector& Direction) const override;
+
+	virtual bool ImplementsRaycast() const override { return true; }
+	virtual bool Raycast(struct FKzHitResult& OutHit, const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const override;
+
+	virtual void DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines = false, float LifeTime = -1.f, uint8 DepthPriority = 0, float Thickness = 0.f) const override;
+	virtual void DrawSceneProxy(FPrimitiveDrawInterface* PDI, const FMatrix& LocalToWorld, const FLinearColor& Color, bool bDrawSolid, float Thickness, int32 ViewIndex, FMeshElementCollector& Collector) const override;
+
+private:
+	/** Recomputes the face planes from the hull triangles. */
+	void BuildPlanes();
+
+	/** Vertex the next support query starts climbing from. Shared by concurrent queries, accessed relaxed. */
+	mutable int32 SupportHint = 0;
+};
+
+FORCEINLINE FKzConvex operator+(float Inflation, const FKzConvex& Shape)
+{
+	return Shape.operator+(Inflation);
+}
+
+FORCEINLINE FKzConvex operator+(const FVector& Inflation, const FKzConvex& Shape)
+{
+	return Shape.operator+(Inflation);
+}
+
+FORCEINLINE FKzConvex operator*(float Scale, const FKzConvex& Shape)
+{
+	return Shape.operator*(Scale);
+}
+
+FORCEINLINE FKzConvex operator*(const FVector& Scale, const FKzConvex& Shape)
+{
+	return Shape.operator*(Scale);
+}
\ No newline at end of file
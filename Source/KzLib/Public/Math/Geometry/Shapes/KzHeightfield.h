@@ -0,0 +1,281 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Math/Geometry/KzShape.h"
+#include "Templates/SharedPointer.h"
+#include "KzHeightfield.generated.h"
+
+struct FKzShapeInstance;
+class UTexture2D;
+
+/**
+ * Grid of 16-bit height samples with a min/max mip pyramid over its cells, shared by every FKzHeightfield built from it.
+ *
+ * Level 0 of the pyramid holds one block per cell, every other level merges 2x2 blocks of the previous one,
+ * until a single block covers the grid. Raycasts use it to skip whole blocks of cells the ray passes above or below.
+ */
+struct KZLIB_API FKzHeightfieldData
+{
+	/** Height sample that maps to local Z = 0. */
+	static constexpr int32 HeightOffset = 32768;
+
+	/** Number of samples along X. */
+	int32 SizeX = 0;
+
+	/** Number of samples along Y. */
+	int32 SizeY = 0;
+
+	/** SizeX * SizeY height samples, X major (sample (X, Y) is Heights[Y * SizeX + X]). */
+	TArray<uint16> Heights;
+
+	/** Lowest height of every block of the mip pyramid. */
+	TArray<uint16> MipMin;
+
+	/** Highest height of every block of the mip pyramid. */
+	TArray<uint16> MipMax;
+
+	/** First block of each mip level in MipMin / MipMax. The last level is a single block. */
+	TArray<int32> MipOffsets;
+
+	/**
+	 * Builds the mip pyramid over a grid of samples.
+	 * @param Heights  InSizeX * InSizeY samples, X major. Grids smaller than 2x2 or with the wrong number of samples are left empty.
+	 */
+	static TSharedRef<const FKzHeightfieldData> Build(int32 InSizeX, int32 InSizeY, TArray<uint16> InHeights);
+
+	/** Returns true if the grid is valid and the mip pyramid matches it. */
+	bool IsValid() const
+	{
+		return SizeX >= 2 && SizeY >= 2 && Heights.Num() == SizeX * SizeY && MipOffsets.Num() > 0 && MipMin.Num() == MipMax.Num() && MipMin.Num() > MipOffsets.Last();
+	}
+
+	/** Serializes the grid and the mip pyramid, so loading does not need to rebuild it. */
+	void Serialize(FArchive& Ar);
+
+	/** Returns a height sample. */
+	FORCEINLINE uint16 GetSample(int32 X, int32 Y) const { return Heights[Y * SizeX + X]; }
+
+	/** Index of the top level of the mip pyramid. */
+	FORCEINLINE int32 GetTopLevel() const { return MipOffsets.Num() - 1; }
+
+	/** Number of cells along X at a mip level. */
+	FORCEINLINE int32 GetLevelSizeX(int32 Level) const { return ((SizeX - 2) >> Level) + 1; }
+
+	/** Number of cells along Y at a mip level. */
+	FORCEINLINE int32 GetLevelSizeY(int32 Level) const { return ((SizeY - 2) >> Level) + 1; }
+
+	/** Index of a block in MipMin / MipMax. */
+	FORCEINLINE int32 GetBlockIndex(int32 Level, int32 BlockX, int32 BlockY) const { return MipOffsets[Level] + BlockY * GetLevelSizeX(Level) + BlockX; }
+};
+
+/**
+ * Regular grid of 16-bit height samples, eg. terrain.
+ *
+ * Sample (X, Y) is at local position (X * GridScale.X, Y * GridScale.Y, (Height - HeightOffset) * GridScale.Z),
+ * the same encoding landscapes use, so the grid extends from the local origin along +X and +Y.
+ * Every cell is split into two triangles along its (X, Y) - (X + 1, Y + 1) diagonal.
+ * Landscapes are sampled by Kz::Landscape::MakeHeightfield(), in the KzLibLandscape module.
+ *
+ * The samples and their mip pyramid (see FKzHeightfieldData) are shared: copies of the shape (and scaled
+ * copies) reference the same data. It is saved with the shape (see Serialize()); each loaded shape owns its
+ * own copy. Like FKzTriangleMesh, a heightfield is a surface, not a solid.
+ */
+USTRUCT(BlueprintType, meta = (DisplayName = "Heightfield"))
+struct KZLIB_API FKzHeightfield : public FKzShape
+{
+	GENERATED_BODY()
+
+	/** Height sample that maps to local Z = 0. */
+	static constexpr int32 HeightOffset = FKzHeightfieldData::HeightOffset;
+
+	/** Cell size along X and Y, and local units per height step along Z. */
+	UPROPERTY(EditAnywhere, Category = "Kz")
+	FVector GridScale = FVector(100.0, 100.0, 1.0 / 128.0);
+
+	/** Height samples and mip pyramid. Not a property, written by Serialize(). */
+	TSharedPtr<const FKzHeightfieldData> HeightData;
+
+	FKzHeightfield() = default;
+
+	explicit FKzHeightfield(const TSharedPtr<const FKzHeightfieldData>& InHeightData, const FVector& InGridScale)
+		: GridScale(InGridScale), HeightData(InHeightData)
+	{
+	}
+
+	/** Builds new height data from a grid of samples. See FKzHeightfieldData::Build(). */
+	FKzHeightfield(int32 InSizeX, int32 InSizeY, TArray<uint16> InHeights, const FVector& InGridScale)
+		: GridScale(InGridScale), HeightData(FKzHeightfieldData::Build(InSizeX, InSizeY, MoveTemp(InHeights)))
+	{
+	}
+
+	/** Returns true if the shape holds a valid grid. */
+	bool HasValidData() const
+	{
+		return HeightData.IsValid() && HeightData->IsValid();
+	}
+
+	/** Number of samples along X. */
+	FORCEINLINE int32 GetSizeX() const { return HeightData.IsValid() ? HeightData->SizeX : 0; }
+
+	/** Number of samples along Y. */
+	FORCEINLINE int32 GetSizeY() const { return HeightData.IsValid() ? HeightData->SizeY : 0; }
+
+	/** Returns the local height of a sample. */
+	FORCEINLINE double GetHeight(int32 X, int32 Y) const
+	{
+		return (HeightData->GetSample(X, Y) - HeightOffset) * GridScale.Z;
+	}
+
+	/** Writes the grid scale and the height data. */
+	bool Serialize(FArchive& Ar);
+
+	/**
+	 * Reads the heights from the first mip of a texture. 16-bit grayscale textures are read as is,
+	 * 8-bit textures (grayscale, or the red channel of color ones) are expanded to the 16-bit range.
+	 * Uses the source art in the editor, and the platform data at runtime (which must be uncompressed).
+	 */
+	static FKzHeightfield FromTexture(UTexture2D* Texture, const FVector& InGridScale);
+
+	virtual bool IsZeroExtent() const override
+	{
+		return !HasValidData() || GridScale.GetAbsMin() <= 0.0;
+	}
+
+	/** Tests a convex shape against the triangles of the cells under its bounds, with GJK. */
+	bool IntersectsShape(const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FVector& Center, const FQuat& Rotation) const;
+
+	/** Tests a world space triangle against the triangles of the cells under its bounds, with GJK. */
+	bool IntersectsTriangle(const FVector& V0, const FVector& V1, const FVector& V2, const FVector& Center, const FQuat& Rotation) const;
+
+	/**
+	 * Calls Func(V0, V1, V2) for both triangles of every cell whose height range overlaps a box, with the box
+	 * and the vertices in local space. Func returns false to stop.
+	 */
+	template <typename TFunc>
+	void ForEachTriangle(const FBox& LocalBounds, TFunc&& Func) const
+	{
+		if (IsZeroExtent())
+		{
+			return;
+		}
+
+		const FKzHeightfieldData& Data = *HeightData;
+
+		// Bounds in grid space, where cells are unit squares and Z is in height steps.
+		const FVector InvScale(1.0 / GridScale.X, 1.0 / GridScale.Y, 1.0 / GridScale.Z);
+		const FVector A = LocalBounds.Min * InvScale + FVector(0.0, 0.0, HeightOffset);
+		const FVector B = LocalBounds.Max * InvScale + FVector(0.0, 0.0, HeightOffset);
+		const FVector GridMin = A.ComponentMin(B);
+		const FVector GridMax = A.ComponentMax(B);
+
+		const int32 CellsX = Data.SizeX - 1;
+		const int32 CellsY = Data.SizeY - 1;
+		if (GridMax.X < 0.0 || GridMax.Y < 0.0 || GridMin.X > CellsX || GridMin.Y > CellsY)
+		{
+			return;
+		}
+
+		const int32 MinX = (int32)FMath::Clamp(FMath::FloorToDouble(GridMin.X), 0.0, CellsX - 1.0);
+		const int32 MinY = (int32)FMath::Clamp(FMath::FloorToDouble(GridMin.Y), 0.0, CellsY - 1.0);
+		const int32 MaxX = (int32)FMath::Clamp(FMath::FloorToDouble(GridMax.X), 0.0, CellsX - 1.0);
+		const int32 MaxY = (int32)FMath::Clamp(FMath::FloorToDouble(GridMax.Y), 0.0, CellsY - 1.0);
+
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				// Cells entirely above or below the box.
+				const int32 Block = Data.GetBlockIndex(0, X, Y);
+				if (Data.MipMax[Block] < GridMin.Z || Data.MipMin[Block] > GridMax.Z)
+				{
+					continue;
+				}
+
+				const FVector P00 = FVector(X, Y, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X, Y));
+				const FVector P10 = FVector(X + 1, Y, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X + 1, Y));
+				const FVector P01 = FVector(X, Y + 1, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X, Y + 1));
+				const FVector P11 = FVector(X + 1, Y + 1, 0.0) * GridScale + FVector(0.0, 0.0, GetHeight(X + 1, Y + 1));
+
+				if (!Func(P00, P10, P11) || !Func(P00, P11, P01))
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	virtual FBox GetBoundingBox(const FVector& Center, const FQuat& Rotation) const override;
+	virtual FVector GetClosestPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const override;
+	virtual bool IntersectsPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const override;
+	virtual FCollisionShape ToCollisionShape(float Inflation) const override;
+
+	FORCEINLINE FKzHeightfield operator*(float Scale) const
+	{
+		return FKzHeightfield(HeightData, GridScale * Scale);
+	}
+
+	FORCEINLINE FKzHeightfield& operator*=(float Scale)
+	{
+		this->Scale(Scale);
+		return *this;
+	}
+
+	FORCEINLINE FKzHeightfield operator*(const FVector& Scale) const
+	{
+		return FKzHeightfield(HeightData, GridScale * Scale);
+	}
+
+	FORCEINLINE FKzHeightfield& operator*=(const FVector& Scale)
+	{
+		this->Scale(Scale);
+		return *this;
+	}
+
+	/** Heightfields have no thickness to inflate. */
+	virtual void Inflate(float Inflation) override {}
+
+	/** Heightfields have no thickness to inflate. */
+	virtual void Inflate(const FVector& Inflation) override {}
+
+	virtual void Scale(float Scale) override
+	{
+		GridScale *= Scale;
+	}
+
+	virtual void Scale(const FVector& Scale) override
+	{
+		GridScale *= Scale;
+	}
+
+	virtual FVector GetSupportPoint(const FVector& Direction) const override;
+
+	virtual bool ImplementsRaycast() const override { return true; }
+	virtual bool Raycast(struct FKzHitResult& OutHit, const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const override;
+
+	virtual void DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines = false, float LifeTime = -1.f, uint8 DepthPriority = 0, float Thickness = 0.f) const override;
+	virtual void DrawSceneProxy(FPrimitiveDrawInterface* PDI, const FMatrix& LocalToWorld, const FLinearColor& Color, bool bDrawSolid, float Thickness, int32 ViewIndex, FMeshElementCollector& Collector) const override;
+
+private:
+	/** Local space bounds of a block of cells. */
+	FBox GetBlockBounds(int32 Level, int32 BlockX, int32 BlockY) const;
+};
+
+template<>
+struct TStructOpsTypeTraits<FKzHeightfield> : public TStructOpsTypeTraitsBase2<FKzHeightfield>
+{
+	enum
+	{
+		WithSerializer = true,
+	};
+};
+
+FORCEINLINE FKzHeightfield operator*(float Scale, const FKzHeightfield& Shape)
+{
+	return Shape.operator*(Scale);
+}
+
+FORCEINLINE FKzHeightfield operator*(const FVector& Scale, const FKzHeightfield& Shape)
+{
+	return Shape.operator*(Scale);
+}
\ No newline at end of file
@@ -0,0 +1,272 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Math/Geometry/KzShape.h"
+#include "Containers/ArrayView.h"
+#include "Templates/SharedPointer.h"
+#include "KzTriangleMesh.generated.h"
+
+struct FKzShapeInstance;
+
+/**
+ * Cooked triangle soup with a bounding volume hierarchy, shared by every FKzTriangleMesh built from it.
+ *
+ * Triangles are stored in BVH leaf order, packed as a vertex and two edges so ray tests (Möller–Trumbore)
+ * read them directly. Nodes are 32 bytes and siblings are adjacent, so a node only stores its first child.
+ * Data is in single precision, in mesh space.
+ */
+struct KZLIB_API FKzTriangleMeshData
+{
+	struct FNode
+	{
+		FVector3f Min;
+
+		/** First child for interior nodes (the second one follows it), first triangle for leaves. */
+		int32 Index;
+
+		FVector3f Max;
+
+		/** Number of triangles of a leaf, 0 for interior nodes. */
+		int32 Count;
+
+		bool IsLeaf() const { return Count > 0; }
+
+		friend FArchive& operator<<(FArchive& Ar, FNode& Node)
+		{
+			return Ar << Node.Min << Node.Index << Node.Max << Node.Count;
+		}
+	};
+
+	struct FTriangle
+	{
+		FVector3f V0;
+		FVector3f E1;
+		FVector3f E2;
+
+		FVector3f GetVertex(int32 Index) const { return Index == 0 ? V0 : (Index == 1 ? V0 + E1 : V0 + E2); }
+
+		friend FArchive& operator<<(FArchive& Ar, FTriangle& Triangle)
+		{
+			return Ar << Triangle.V0 << Triangle.E1 << Triangle.E2;
+		}
+	};
+
+	/** Maximum number of triangles per leaf. */
+	static constexpr int32 MaxLeafTriangles = 4;
+
+	TArray<FNode> Nodes;
+	TArray<FTriangle> Triangles;
+
+	/**
+	 * Cooks a triangle list.
+	 * @param Vertices  Mesh space vertex positions.
+	 * @param Indices   Three vertex indices per triangle. Degenerate triangles are dropped.
+	 */
+	static TSharedRef<const FKzTriangleMeshData> Build(TConstArrayView<FVector> Vertices, TConstArrayView<int32> Indices);
+
+	/** Serializes the cooked nodes and triangles, so loading does not need to rebuild the hierarchy. */
+	void Serialize(FArchive& Ar);
+
+	/** Returns the mesh space bounds of all triangles. */
+	FBox GetBounds() const;
+
+	/**
+	 * Finds the closest triangle hit by a mesh space ray. Triangles are two-sided.
+	 * Dir does not need to be normalized; distances are in units of Dir.
+	 *
+	 * @param InOutT  Ray length on input, distance of the hit on output.
+	 * @return Index of the hit triangle, or INDEX_NONE.
+	 */
+	int32 Raycast(const FVector3f& Origin, const FVector3f& Dir, float& InOutT) const;
+
+	/** Calls Func(TriangleIndex) for every triangle whose leaf overlaps a mesh space box. Func returns false to stop. */
+	template <typename TFunc>
+	void ForEachTriangle(const FBox& Box, TFunc&& Func) const
+	{
+		if (Nodes.Num() == 0)
+		{
+			return;
+		}
+
+		const FVector3f BoxMin(Box.Min);
+		const FVector3f BoxMax(Box.Max);
+
+		int32 Stack[64];
+		int32 StackSize = 0;
+		Stack[StackSize++] = 0;
+
+		while (StackSize > 0)
+		{
+			const FNode& Node = Nodes[Stack[--StackSize]];
+			if (Node.Min.X > BoxMax.X || Node.Max.X < BoxMin.X ||
+				Node.Min.Y > BoxMax.Y || Node.Max.Y < BoxMin.Y ||
+				Node.Min.Z > BoxMax.Z || Node.Max.Z < BoxMin.Z)
+			{
+				continue;
+			}
+
+			if (Node.IsLeaf())
+			{
+				for (int32 i = Node.Index; i < Node.Index + Node.Count; ++i)
+				{
+					if (!Func(i))
+					{
+						return;
+					}
+				}
+			}
+			else
+			{
+				check(StackSize + 2 <= UE_ARRAY_COUNT(Stack));
+				Stack[StackSize++] = Node.Index + 1;
+				Stack[StackSize++] = Node.Index;
+			}
+		}
+	}
+};
+
+/**
+ * Static triangle geometry, eg. level geometry for custom perception or physics pipelines.
+ *
+ * The cooked mesh data is shared: copies of the shape (and scaled copies) reference the same data.
+ * It is saved with the shape (see Serialize()); each loaded shape owns its own copy.
+ * A triangle mesh is a surface, not a solid: points are inside it only when they lie on a triangle.
+ * Overlaps run per triangle, against the convex shapes (see IntersectsShape()) as well as other meshes and
+ * heightfields (see IntersectsTriangle()), while the other support-based queries see the convex hull of the mesh.
+ */
+USTRUCT(BlueprintType, meta = (DisplayName = "Triangle Mesh"))
+struct KZLIB_API FKzTriangleMesh : public FKzShape
+{
+	GENERATED_BODY()
+
+	/** Scale applied to the mesh data. */
+	UPROPERTY(EditAnywhere, Category = "Kz")
+	FVector MeshScale = FVector::OneVector;
+
+	/** Cooked triangles. Not a property, written by Serialize(). */
+	TSharedPtr<const FKzTriangleMeshData> MeshData;
+
+	FKzTriangleMesh() = default;
+
+	explicit FKzTriangleMesh(const TSharedPtr<const FKzTriangleMeshData>& InMeshData, const FVector& InMeshScale = FVector::OneVector)
+		: MeshScale(InMeshScale), MeshData(InMeshData)
+	{
+	}
+
+	/** Cooks a new mesh from a triangle list. See FKzTriangleMeshData::Build(). */
+	explicit FKzTriangleMesh(TConstArrayView<FVector> Vertices, TConstArrayView<int32> Indices)
+		: MeshData(FKzTriangleMeshData::Build(Vertices, Indices))
+	{
+	}
+
+	/** Writes the scale and the cooked mesh data. */
+	bool Serialize(FArchive& Ar);
+
+	virtual bool IsZeroExtent() const override
+	{
+		return !MeshData.IsValid() || MeshData->Triangles.Num() == 0 || MeshScale.GetAbsMin() <= 0.0;
+	}
+
+	/**
+	 * Tests a convex shape against the triangles: the bounds of the shape select the candidate triangles
+	 * from the BVH, and GJK runs against each of them.
+	 */
+	bool IntersectsShape(const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FVector& Center, const FQuat& Rotation) const;
+
+	/** Tests a world space triangle against the triangles under its bounds, with GJK. */
+	bool IntersectsTriangle(const FVector& V0, const FVector& V1, const FVector& V2, const FVector& Center, const FQuat& Rotation) const;
+
+	/**
+	 * Calls Func(V0, V1, V2) for every triangle whose leaf overlaps a box, with the box and the vertices in
+	 * scaled mesh space. Func returns false to stop.
+	 */
+	template <typename TFunc>
+	void ForEachTriangle(const FBox& LocalBounds, TFunc&& Func) const
+	{
+		if (IsZeroExtent())
+		{
+			return;
+		}
+
+		const FVector InvScale(1.0 / MeshScale.X, 1.0 / MeshScale.Y, 1.0 / MeshScale.Z);
+		const FVector A = LocalBounds.Min * InvScale;
+		const FVector B = LocalBounds.Max * InvScale;
+
+		MeshData->ForEachTriangle(FBox(A.ComponentMin(B), A.ComponentMax(B)), [&](int32 TriangleIndex)
+		{
+			const FKzTriangleMeshData::FTriangle& Triangle = MeshData->Triangles[TriangleIndex];
+			return Func(FVector(Triangle.V0) * MeshScale, FVector(Triangle.V0 + Triangle.E1) * MeshScale, FVector(Triangle.V0 + Triangle.E2) * MeshScale);
+		});
+	}
+
+	virtual FBox GetBoundingBox(const FVector& Center, const FQuat& Rotation) const override;
+	virtual FVector GetClosestPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const override;
+	virtual bool IntersectsPoint(const FVector& Center, const FQuat& Rotation, const FVector& Point) const override;
+	virtual FCollisionShape ToCollisionShape(float Inflation) const override;
+
+	FORCEINLINE FKzTriangleMesh operator*(float Scale) const
+	{
+		return FKzTriangleMesh(MeshData, MeshScale * Scale);
+	}
+
+	FORCEINLINE FKzTriangleMesh& operator*=(float Scale)
+	{
+		this->Scale(Scale);
+		return *this;
+	}
+
+	FORCEINLINE FKzTriangleMesh operator*(const FVector& Scale) const
+	{
+		return FKzTriangleMesh(MeshData, MeshScale * Scale);
+	}
+
+	FORCEINLINE FKzTriangleMesh& operator*=(const FVector& Scale)
+	{
+		this->Scale(Scale);
+		return *this;
+	}
+
+	/** Triangle meshes have no thickness to inflate. */
+	virtual void Inflate(float Inflation) override {}
+
+	/** Triangle meshes have no thickness to inflate. */
+	virtual void Inflate(const FVector& Inflation) override {}
+
+	virtual void Scale(float Scale) override
+	{
+		MeshScale *= Scale;
+	}
+
+	virtual void Scale(const FVector& Scale) override
+	{
+		MeshScale *= Scale;
+	}
+
+	virtual FVector GetSupportPoint(const FVector& Direction) const override;
+
+	virtual bool ImplementsRaycast() const override { return true; }
+	virtual bool Raycast(struct FKzHitResult& OutHit, const FVector& Center, const FQuat& Rotation, const FVector& RayStart, const FVector& RayDir, float MaxDistance) const override;
+
+	virtual void DrawDebug(const UWorld* InWorld, FVector const& Center, const FQuat& Rotation, FColor const& Color, bool bPersistentLines = false, float LifeTime = -1.f, uint8 DepthPriority = 0, float Thickness = 0.f) const override;
+	virtual void DrawSceneProxy(FPrimitiveDrawInterface* PDI, const FMatrix& LocalToWorld, const FLinearColor& Color, bool bDrawSolid, float Thickness, int32 ViewIndex, FMeshElementCollector& Collector) const override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FKzTriangleMesh> : public TStructOpsTypeTraitsBase2<FKzTriangleMesh>
+{
+	enum
+	{
+		WithSerializer = true,
+	};
+};
+
+FORCEINLINE FKzTriangleMesh operator*(float Scale, const FKzTriangleMesh& Shape)
+{
+	return Shape.operator*(Scale);
+}
+
+FORCEINLINE FKzTriangleMesh operator*(const FVector& Scale, const FKzTriangleMesh& Shape)
+{
+	return Shape.operator*(Scale);
+}
\ No newline at end of file
@@ -0,0 +1,249 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Box.h"
+#include "Math/VectorRegister.h"
+
+#include <cmath>
+#include <type_traits>
+
+namespace Kz
+{
+	namespace Spatial
+	{
+		/** Converts to float rounding towards -inf, so float boxes built from it never shrink. */
+		FORCEINLINE float RoundDown(FVector::FReal Value)
+		{
+			const float F = (float)Value;
+			return (FVector::FReal)F > Value ? std::nextafter(F, -FLT_MAX) : F;
+		}
+
+		/** Converts to float rounding towards +inf, so float boxes built from it never shrink. */
+		FORCEINLINE float RoundUp(FVector::FReal Value)
+		{
+			const float F = (float)Value;
+			return (FVector::FReal)F < Value ? std::nextafter(F, FLT_MAX) : F;
+		}
+
+		/** Reciprocal that maps axis-parallel directions to a huge finite value, so the slab test never produces NaNs. */
+		FORCEINLINE float SafeInv(FVector::FReal Value)
+		{
+			return FMath::Abs(Value) < UE_SMALL_NUMBER ? (Value < 0.0f ? -1e30f : 1e30f) : (float)(1.0 / Value);
+		}
+	}
+
+	/**
+	 * Axis-aligned boxes stored as float SoA blocks, used to cull spatial index candidates with SIMD.
+	 *
+	 * Each block holds MinX[4], MinY[4], MinZ[4], MaxX[4], MaxY[4], MaxZ[4], so one VectorRegister4Float
+	 * tests the same axis of 4 boxes at once. Boxes are rounded outwards when converted to float, which
+	 * keeps the tests conservative: they never reject a box the double-precision test would accept.
+	 *
+	 * Visitor callables receive the box index. They may return bool, in which case returning false
+	 * stops the iteration.
+	 */
+	template <typename InAllocatorType = FDefaultAllocator>
+	class TBoundsSoA
+	{
+	public:
+		static constexpr int32 LaneCount = 4;
+		static constexpr int32 FloatsPerBlock = 6 * LaneCount;
+
+		int32 Num() const { return NumBoxes; }
+		bool IsEmpty() const { return NumBoxes == 0; }
+
+		/** Removes all boxes, keeping the allocated memory. */
+		void Reset()
+		{
+			Data.Reset();
+			NumBoxes = 0;
+		}
+
+		/** Removes all boxes and releases the allocated memory. */
+		void Empty()
+		{
+			Data.Empty();
+			NumBoxes = 0;
+		}
+
+		void Reserve(int32 Num) { Data.Reserve(FMath::DivideAndRoundUp(Num, LaneCount) * FloatsPerBlock); }
+		void Shrink() { Data.Shrink(); }
+		SIZE_T GetAllocatedSize() const { return Data.GetAllocatedSize(); }
+
+		/** Appends a box. */
+		void Add(const FBox& Box)
+		{
+			if (NumBoxes % LaneCount == 0)
+			{
+				Data.AddZeroed(FloatsPerBlock);
+			}
+
+			SetLane(NumBoxes++, Box);
+		}
+
+		/** Removes a box by moving the last one into its slot, mirroring TArray::RemoveAtSwap. */
+		void RemoveAtSwap(int32 Index)
+		{
+			check(Index >= 0 && Index < NumBoxes);
+
+			const int32 LastIndex = NumBoxes - 1;
+			if (Index != LastIndex)
+			{
+				for (int32 Component = 0; Component < 6; ++Component)
+				{
+					Data[GetOffset(Index, Component)] = Data[GetOffset(LastIndex, Component)];
+				}
+			}
+
+			--NumBoxes;
+
+			if (NumBoxes % LaneCount == 0)
+			{
+				Data.SetNum(Data.Num() - FloatsPerBlock, EAllowShrinking::No);
+			}
+		}
+
+		/** Returns the (float, conservatively rounded) box stored at Index. */
+		FBox GetBox(int32 Index) const
+		{
+			check(Index >= 0 && Index < NumBoxes);
+			return FBox(
+				FVector(Data[GetOffset(Index, 0)], Data[GetOffset(Index, 1)], Data[GetOffset(Index, 2)]),
+				FVector(Data[GetOffset(Index, 3)], Data[GetOffset(Index, 4)], Data[GetOffset(Index, 5)]));
+		}
+
+		/**
+		 * Calls Func(Index) for every box overlapping Query.
+		 * @return false if the visitor stopped the iteration.
+		 */
+		template <typename TFunc>
+		bool ForEachOverlap(const FBox& Query, TFunc&& Func) const
+		{
+			const VectorRegister4Float QMinX = VectorSetFloat1(Spatial::RoundDown(Query.Min.X));
+			const VectorRegister4Float QMinY = VectorSetFloat1(Spatial::RoundDown(Query.Min.Y));
+			const VectorRegister4Float QMinZ = VectorSetFloat1(Spatial::RoundDown(Query.Min.Z));
+			const VectorRegister4Float QMaxX = VectorSetFloat1(Spatial::RoundUp(Query.Max.X));
+			const VectorRegister4Float QMaxY = VectorSetFloat1(Spatial::RoundUp(Query.Max.Y));
+			const VectorRegister4Float QMaxZ = VectorSetFloat1(Spatial::RoundUp(Query.Max.Z));
+
+			const int32 NumBlocks = FMath::DivideAndRoundUp(NumBoxes, LaneCount);
+			for (int32 Block = 0; Block < NumBlocks; ++Block)
+			{
+				const float* B = Data.GetData() + Block * FloatsPerBlock;
+
+				VectorRegister4Float Mask = VectorBitwiseAnd(VectorCompareLE(VectorLoad(B + 0), QMaxX), VectorCompareGE(VectorLoad(B + 12), QMinX));
+				Mask = VectorBitwiseAnd(Mask, VectorBitwiseAnd(VectorCompareLE(VectorLoad(B + 4), QMaxY), VectorCompareGE(VectorLoad(B + 16), QMinY)));
+				Mask = VectorBitwiseAnd(Mask, VectorBitwiseAnd(VectorCompareLE(VectorLoad(B + 8), QMaxZ), VectorCompareGE(VectorLoad(B + 20), QMinZ)));
+
+				if (!VisitLanes(Block, VectorMaskBits(Mask), Func))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/**
+		 * Calls Func(Index) for every box crossed by the ray segment [0, MaxDistance].
+		 * MaxDistance is re-read before each block, so the visitor may shrink it to cull further boxes.
+		 * @return false if the visitor stopped the iteration.
+		 */
+		template <typename TFunc>
+		bool ForEachRayHit(const FVector& RayStart, const FVector& RayDir, const float& MaxDistance, TFunc&& Func) const
+		{
+			const VectorRegister4Float OX = VectorSetFloat1((float)RayStart.X);
+			const VectorRegister4Float OY = VectorSetFloat1((float)RayStart.Y);
+			const VectorRegister4Float OZ = VectorSetFloat1((float)RayStart.Z);
+			const VectorRegister4Float InvX = VectorSetFloat1(Spatial::SafeInv(RayDir.X));
+			const VectorRegister4Float InvY = VectorSetFloat1(Spatial::SafeInv(RayDir.Y));
+			const VectorRegister4Float InvZ = VectorSetFloat1(Spatial::SafeInv(RayDir.Z));
+			const VectorRegister4Float Zero = VectorZeroFloat();
+
+			// Absorbs the float rounding of the ray origin so grazing hits are not culled.
+			const VectorRegister4Float Tolerance = VectorSetFloat1(UE_KINDA_SMALL_NUMBER * (1.0f + RayStart.GetAbsMax()));
+
+			const int32 NumBlocks = FMath::DivideAndRoundUp(NumBoxes, LaneCount);
+			for (int32 Block = 0; Block < NumBlocks; ++Block)
+			{
+				const float* B = Data.GetData() + Block * FloatsPerBlock;
+
+				// Slab test on the 4 boxes of the block.
+				VectorRegister4Float T1 = VectorMultiply(VectorSubtract(VectorLoad(B + 0), OX), InvX);
+				VectorRegister4Float T2 = VectorMultiply(VectorSubtract(VectorLoad(B + 12), OX), InvX);
+				VectorRegister4Float TNear = VectorMin(T1, T2);
+				VectorRegister4Float TFar = VectorMax(T1, T2);
+
+				T1 = VectorMultiply(VectorSubtract(VectorLoad(B + 4), OY), InvY);
+				T2 = VectorMultiply(VectorSubtract(VectorLoad(B + 16), OY), InvY);
+				TNear = VectorMax(TNear, VectorMin(T1, T2));
+				TFar = VectorMin(TFar, VectorMax(T1, T2));
+
+				T1 = VectorMultiply(VectorSubtract(VectorLoad(B + 8), OZ), InvZ);
+				T2 = VectorMultiply(VectorSubtract(VectorLoad(B + 20), OZ), InvZ);
+				TNear = VectorMax(TNear, VectorMin(T1, T2));
+				TFar = VectorMin(TFar, VectorMax(T1, T2));
+
+				TNear = VectorMax(TNear, Zero);
+				TFar = VectorAdd(VectorMin(TFar, VectorSetFloat1(MaxDistance)), Tolerance);
+
+				if (!VisitLanes(Block, VectorMaskBits(VectorCompareLE(TNear, TFar)), Func))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+	private:
+		static FORCEINLINE int32 GetOffset(int32 Index, int32 Component)
+		{
+			return (Index / LaneCount) * FloatsPerBlock + Component * LaneCount + (Index % LaneCount);
+		}
+
+		void SetLane(int32 Index, const FBox& Box)
+		{
+			Data[GetOffset(Index, 0)] = Spatial::RoundDown(Box.Min.X);
+			Data[GetOffset(Index, 1)] = Spatial::RoundDown(Box.Min.Y);
+			Data[GetOffset(Index, 2)] = Spatial::RoundDown(Box.Min.Z);
+			Data[GetOffset(Index, 3)] = Spatial::RoundUp(Box.Max.X);
+			Data[GetOffset(Index, 4)] = Spatial::RoundUp(Box.Max.Y);
+			Data[GetOffset(Index, 5)] = Spatial::RoundUp(Box.Max.Z);
+		}
+
+		template <typename TFunc>
+		FORCEINLINE bool VisitLanes(int32 Block, int32 LaneMask, TFunc& Func) const
+		{
+			// Ignore the padding lanes of the last block.
+			const int32 NumValid = FMath::Min(LaneCount, NumBoxes - Block * LaneCount);
+			LaneMask &= (1 << NumValid) - 1;
+
+			while (LaneMask)
+			{
+				const int32 Lane = FMath::CountTrailingZeros((uint32)LaneMask);
+				LaneMask &= LaneMask - 1;
+
+				const int32 Index = Block * LaneCount + Lane;
+				if constexpr (std::is_same_v<decltype(Func(Index)), bool>)
+				{
+					if (!Func(Index))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					Func(Index);
+				}
+			}
+
+			return true;
+		}
+
+		TArray<float, InAllocatorType> Data;
+		int32 NumBoxes = 0;
+	};
+}
\ No newline at end of file
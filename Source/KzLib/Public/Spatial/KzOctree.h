@@ -3,11 +3,17 @@
 #pragma once
 
 #include "Containers/Array.h"
+#include "Containers/Map.h"
 #include "Math/Box.h"
 #include "Concepts/KzContainer.h"
+#include "Core/KzTypes.h"
+#include "Spatial/KzSpatialTypes.h"
+#include "Spatial/KzBoundsSoA.h"
+#include "Spatial/KzRayPacket.h"
 
 struct FKzHitResult;
 struct FKzShapeInstance;
+struct FKzShapeWorldCache;
 
 namespace Kz
 {
@@ -18,14 +24,34 @@ namespace Kz
 	 * When bAllowMultiNode = true (default), elements may reside in multiple child
 	 * nodes if their bounds cross cell boundaries, ensuring robust queries without
 	 * relying on large looseness values.
+	 *
+	 * Nodes are stored in a flat pool that survives Reset() and Build(), so rebuilding a tree
+	 * of similar shape every frame reuses the previous allocations. Call Trim() to give the
+	 * memory back. InAllocatorType is used for the node pool and the per-node element arrays,
+	 * and can be swapped for an arena, page or inline allocator.
+	 *
+	 * Leaves cache their element bounds at build time in SIMD-friendly SoA form, so queries
+	 * cull most candidates before calling into the Semantics shape or GJK.
+	 *
+	 * Semantics that keep world space shape data per element can expose it with a static
+	 * GetWorldCache(const ElementType&) returning a const FKzShapeWorldCache&. Narrow phase tests then
+	 * use the cached shape and placement instead of GetShape(), GetElementPosition() and GetElementRotation().
+	 * Batched and async queries call it from worker threads, so it must only read (see UKzShapeComponent::GetWorldCache()).
+	 * GetShape() may return an FKzShapeInstance or, for built-in shapes, an FKzShapeValue, which is tested
+	 * without heap allocations. Elements without GetShape() are tested as their bounding sphere.
+	 *
+	 * SplitAxes selects the axes nodes are subdivided along. Splitting on two axes turns the tree
+	 * into a quadtree for planar content (see TQuadtree); nodes then span the full extent of the
+	 * third axis.
 	 */
-	template <typename ElementType, typename OctreeSemantics, bool bAllowMultiNode = true>
+	template <typename ElementType, typename OctreeSemantics, bool bAllowMultiNode = true, typename InAllocatorType = FDefaultAllocator, EKzAxis3D SplitAxes = EKzAxis3D::X | EKzAxis3D::Y | EKzAxis3D::Z>
 	class TOctree
 	{
-		using ElementIdType = typename OctreeSemantics::ElementIdType;
 		using FDefaultValidator = decltype([](const ElementType&) { return true; });
 
 	public:
+		using ElementIdType = typename OctreeSemantics::ElementIdType;
+
 		/** Sets maximum subdivision depth. */
 		void SetMaxDepth(int32 InMaxDepth) { MaxDepth = FMath::Max(0, InMaxDepth); }
 
@@ -35,8 +61,14 @@ namespace Kz
 		/** Sets how "loose" each node’s AABB should be. Values >1 enlarge the boxes slightly to avoid precision gaps. */
 		void SetLooseness(float InLooseness) { Looseness = FMath::Max(1.0f, InLooseness); }
 
-		/** Resets the octree. */
-		void Reset() { Root = FNode{}; }
+		/** Resets the octree, keeping the allocated nodes and element storage for the next Build(). */
+		void Reset();
+
+		/** Releases the memory retained by previous builds that is not used by the current tree. Call after Reset() to free everything. */
+		void Trim();
+
+		/** Returns the amount of memory allocated by the octree, including retained memory. */
+		SIZE_T GetAllocatedSize() const;
 
 		/** Builds the octree from any iterable container (Array, THandleArray, etc.). */
 		void Build(const CKzContainer auto& Container);
@@ -58,6 +90,44 @@ namespace Kz
 		template<typename TValidator = FDefaultValidator>
 		bool Raycast(ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator = {}) const;
 
+		/**
+		 * Collects every element crossed by the ray, sorted by distance (eg. penetrating weapons or ray sensors).
+		 * When MaxHits > 0, only the MaxHits closest hits are kept and the traversal stops as soon as
+		 * no closer hit can be found.
+		 *
+		 * @param OutHits       Receives the hits, sorted by ascending distance. Use TSpatialRayHitArray to keep them inline.
+		 * @param RayStart      Ray world-space start position.
+		 * @param RayDir        Ray direction (does not need to be normalized).
+		 * @param RayLength     Ray length. <= 0 means infinite.
+		 * @param MaxHits       Maximum number of hits to keep. <= 0 means unlimited.
+		 * @param Validator     Optional callable: bool(const ElementType&)
+		 * @return Number of hits written.
+		 */
+		template<typename AllocatorType, typename TValidator = FDefaultValidator>
+		int32 RaycastMulti(TArray<TSpatialRayHit<ElementIdType>, AllocatorType>& OutHits, const FVector& RayStart, const FVector& RayDir, float RayLength, int32 MaxHits = 0, TValidator&& Validator = {}) const;
+
+		/**
+		 * Checks whether any element blocks the ray segment (eg. line-of-sight or shadow checks).
+		 * Stops at the first confirmed hit instead of searching for the closest one: children are
+		 * not sorted front-to-back and no hit details are computed.
+		 *
+		 * @param OutId         Receives the ID of a blocking element (not necessarily the closest).
+		 * @param RayStart      Ray world-space start position.
+		 * @param RayDir        Ray direction (does not need to be normalized).
+		 * @param RayLength     Ray length. <= 0 means infinite.
+		 * @param Validator     Optional callable: bool(const ElementType&)
+		 * @return true if any element was hit; false otherwise.
+		 */
+		template<typename TValidator = FDefaultValidator>
+		bool RaycastAny(ElementIdType& OutId, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator = {}) const;
+
+		/**
+		 * Returns true if no element blocks the segment between From and To.
+		 * Shorthand for RaycastAny() along the segment.
+		 */
+		template<typename TValidator = FDefaultValidator>
+		bool LineOfSight(const FVector& From, const FVector& To, TValidator&& Validator = {}) const;
+
 		/**
 		 * Performs an overlap query using a box.
 		 *
@@ -80,6 +150,79 @@ namespace Kz
 		template<typename TValidator = FDefaultValidator>
 		bool Query(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, TValidator&& Validator = {}) const;
 
+		/**
+		 * Performs an overlap query using a cached world space shape, whose cached bounds drive the broad phase.
+		 *
+		 * @param OutResults     Array receiving IDs of overlapping elements.
+		 * @param Shape          The placed shape to query with.
+		 * @param Validator      Optional callable: bool(const ElementType&).
+		 */
+		template<typename TValidator = FDefaultValidator>
+		bool Query(TArray<ElementIdType>& OutResults, const FKzShapeWorldCache& Shape, TValidator&& Validator = {}) const;
+
+		/**
+		 * Performs many box overlap queries in parallel.
+		 * Results are flattened per query and ordered by query index, regardless of the number of worker threads.
+		 *
+		 * The validator is invoked concurrently from worker threads and must be thread-safe.
+		 *
+		 * @param OutResults     Receives the IDs of overlapping elements for every query.
+		 * @param Bounds         The boxes to query with.
+		 * @param Validator      Optional callable: bool(const ElementType&).
+		 * @return Total number of IDs written.
+		 */
+		template<typename TValidator = FDefaultValidator>
+		int32 QueryBatch(TSpatialBatchResult<ElementIdType>& OutResults, TConstArrayView<FBox> Bounds, TValidator&& Validator = {}) const;
+
+		/**
+		 * Performs many shape overlap queries in parallel.
+		 * Results are flattened per query and ordered by query index, regardless of the number of worker threads.
+		 *
+		 * The validator is invoked concurrently from worker threads and must be thread-safe.
+		 *
+		 * @param OutResults      Receives the IDs of overlapping elements for every query.
+		 * @param Shapes          The geometric shape definitions to query with.
+		 * @param ShapePositions  World-space position of each shape.
+		 * @param ShapeRotations  World-space orientation of each shape.
+		 * @param Validator       Optional callable: bool(const ElementType&).
+		 * @return Total number of IDs written.
+		 */
+		template<typename TValidator = FDefaultValidator>
+		int32 QueryBatch(TSpatialBatchResult<ElementIdType>& OutResults, TConstArrayView<FKzShapeInstance> Shapes, TConstArrayView<FVector> ShapePositions, TConstArrayView<FQuat> ShapeRotations, TValidator&& Validator = {}) const;
+
+		/**
+		 * Performs many raycasts in parallel. Each ray writes to its own slot, so the output is deterministic.
+		 *
+		 * The validator is invoked concurrently from worker threads and must be thread-safe.
+		 *
+		 * @param OutIds        Receives, for each ray, the ID of the closest intersected element (default value on miss).
+		 * @param OutHits       Receives, for each ray, the hit information. Check bBlockingHit for misses.
+		 * @param RayStarts     World-space start position of each ray.
+		 * @param RayDirs       Direction of each ray (does not need to be normalized).
+		 * @param RayLength     Length shared by all rays. <= 0 means infinite.
+		 * @param Validator     Optional callable: bool(const ElementType&)
+		 * @return Number of rays that hit something.
+		 */
+		template<typename TValidator = FDefaultValidator>
+		int32 RaycastBatch(TArray<ElementIdType>& OutIds, TArray<FKzHitResult>& OutHits, TConstArrayView<FVector> RayStarts, TConstArrayView<FVector> RayDirs, float RayLength, TValidator&& Validator = {}) const;
+
+		/**
+		 * Traces coherent rays (eg. a sensor fan sharing one origin) in packets of PacketSize rays.
+		 * Each node is tested against all rays of a packet at once with SIMD and is skipped only when
+		 * every ray misses it, so coherent rays share most of the traversal cost.
+		 * Results match Raycast() called on every ray.
+		 *
+		 * @param OutIds        Receives, for each ray, the ID of the closest intersected element (default value on miss).
+		 * @param OutHits       Receives, for each ray, the hit information. Check bBlockingHit for misses.
+		 * @param RayStarts     World-space start position of each ray.
+		 * @param RayDirs       Direction of each ray (does not need to be normalized).
+		 * @param RayLength     Length shared by all rays. <= 0 means infinite.
+		 * @param Validator     Optional callable: bool(const ElementType&)
+		 * @return Number of rays that hit something.
+		 */
+		template<int32 PacketSize = 8, typename TValidator = FDefaultValidator>
+		int32 RaycastPacket(TArray<ElementIdType>& OutIds, TArray<FKzHitResult>& OutHits, TConstArrayView<FVector> RayStarts, TConstArrayView<FVector> RayDirs, float RayLength, TValidator&& Validator = {}) const;
+
 		/**
 		 * Draws a debug visualization.
 		 *
@@ -93,17 +236,34 @@ namespace Kz
 		void DebugDraw(const class UWorld* World, FColor const& Color, bool bPersistentLines = false, float LifeTime = -1.f, uint8 DepthPriority = 0, float Thickness = 0.f) const;
 
 	private:
+		static constexpr uint8 SplitMask = (uint8)SplitAxes;
+		static constexpr int32 NumChildren = 1 << (((SplitMask >> 0) & 1) + ((SplitMask >> 1) & 1) + ((SplitMask >> 2) & 1));
+		static_assert(NumChildren >= 4, "TOctree must split along at least two axes.");
+
 		struct FNode
 		{
 			FBox Bounds;
-			TArray<ElementType> Elements;
-			TArray<FNode> Children;
+			TArray<ElementType, InAllocatorType> Elements;
+			TBoundsSoA<InAllocatorType> ElementBounds; // Leaf only: bounds of Elements, cached at build time.
+			int32 FirstChild = INDEX_NONE; // Index of the first of NumChildren consecutive children in the pool.
 			int32 Depth = 0;
-			bool IsLeaf() const { return Children.Num() == 0; }
+			bool IsLeaf() const { return FirstChild == INDEX_NONE; }
 		};
 
+		/** Takes Count consecutive nodes from the pool, growing it only when needed. Returns the first index. */
+		int32 AllocateNodes(int32 Count);
+
 		/** Recursively subdivides a node and distributes elements by their bounds center. */
-		void BuildRecursive(FNode& N);
+		void BuildRecursive(int32 NodeIndex);
+
+		const FNode& GetRoot() const { return Nodes[0]; }
+		TConstArrayView<FNode> GetChildren(const FNode& N) const { return N.IsLeaf() ? TConstArrayView<FNode>() : TConstArrayView<FNode>(Nodes.GetData() + N.FirstChild, NumChildren); }
+
+		/** Returns true if nodes are subdivided along Axis (0 = X, 1 = Y, 2 = Z). */
+		static constexpr bool IsSplitAxis(int32 Axis) { return (SplitMask & (1 << Axis)) != 0; }
+
+		/** Returns the bit of a child index that selects the upper half along a split Axis. */
+		static constexpr int32 GetChildBit(int32 Axis) { return 1 << ((Axis > 0 && IsSplitAxis(0) ? 1 : 0) + (Axis > 1 && IsSplitAxis(1) ? 1 : 0)); }
 
 		/**
 		 * Recursive helper for Raycast().
@@ -112,6 +272,24 @@ namespace Kz
 		template<typename TValidator>
 		void RaycastRecursive(const FNode& N, ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator, TSet<ElementIdType>& Visited) const;
 
+		/**
+		 * Recursive helper for RaycastMulti().
+		 * CutoffDistance is the distance beyond which new hits are discarded; it shrinks once MaxHits hits are kept.
+		 */
+		template<typename AllocatorType, typename TValidator>
+		void RaycastMultiRecursive(const FNode& N, TArray<TSpatialRayHit<ElementIdType>, AllocatorType>& OutHits, const FVector& RayStart, const FVector& RayDir, float RayLength, int32 MaxHits, float& CutoffDistance, TValidator&& Validator, TSet<ElementIdType>& Visited) const;
+
+		/**
+		 * Recursive helper for RaycastPacket().
+		 * RayMask holds the rays of the packet known to cross N; OutIds and OutHits are indexed by ray.
+		 */
+		template<int32 PacketSize, typename TValidator>
+		void RaycastPacketRecursive(const FNode& N, TRayPacket<PacketSize>& Packet, uint32 RayMask, ElementIdType* OutIds, FKzHitResult* OutHits, TValidator& Validator, TMap<ElementIdType, uint32>& TestedRays) const;
+
+		/** Recursive helper for RaycastAny(). Returns true as soon as a blocking element is found. */
+		template<typename TValidator>
+		bool RaycastAnyRecursive(const FNode& N, ElementIdType& OutId, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator, TSet<ElementIdType>& Visited) const;
+
 		/** Recursive helper for Query(). */
 		template<typename TValidator>
 		void QueryRecursive(const FNode& N, TArray<ElementIdType>& OutResults, const FBox& Bounds, TValidator&& Validator, TSet<ElementIdType>& Visited) const;
@@ -120,10 +298,23 @@ namespace Kz
 		template<typename TValidator>
 		void QueryRecursive(const FNode& N, TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FBox& QueryAABB, TValidator&& Validator, TSet<ElementIdType>& Visited) const;
 
-		static FKzShapeInstance GetElementShape(const ElementType& E);
+		/** Returns the Semantics shape of an element (an instance or an FKzShapeValue), or its bounding sphere as a value. */
+		static decltype(auto) GetElementShape(const ElementType& E);
 		static FQuat GetElementRotation(const ElementType& E);
 
-		FNode Root;
+		/** Raycasts a single element, through its world cache when the Semantics provide one. */
+		static bool RaycastElement(FKzHitResult& OutHit, const ElementType& E, const FVector& RayStart, const FVector& RayDir, float RayLength);
+
+		/** Returns true if a ray touches a single element, without computing the hit data. */
+		static bool RaycastElementTest(const ElementType& E, const FVector& RayStart, const FVector& RayDir, float RayLength);
+
+		/** Tests a shape against a single element, through its world cache when the Semantics provide one. */
+		static bool IntersectElement(const ElementType& E, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation);
+
+		/** Node pool. Nodes[0] is the root; only the first NumNodes entries belong to the current tree. */
+		TArray<FNode, InAllocatorType> Nodes;
+		int32 NumNodes = 0;
+
 		int32 MaxDepth = 6;
 		int32 MinElementsPerNode = 4;
 		float Looseness = 1.0f;
@@ -5,15 +5,57 @@
 #include "Collision/KzHitResult.h"
 #include "Collision/KzRaycast.h"
 #include "Collision/KzGJK.h"
+#include "Collision/KzOverlap.h"
 #include "Math/Geometry/KzShapeInstance.h"
+#include "Math/Geometry/KzShapeValue.h"
+#include "Math/Geometry/KzShapeWorldCache.h"
 #include "Math/Geometry/Shapes/KzSphere.h"
 
 #include "DrawDebugHelpers.h"
+#include "Async/ParallelFor.h"
 
 namespace Kz
 {
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
-	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::Build(const CKzContainer auto& Container)
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::Reset()
+	{
+		// Keep the nodes and their element arrays around so the next Build() can reuse them.
+		for (int32 i = 0; i < NumNodes; ++i)
+		{
+			Nodes[i].Elements.Reset();
+			Nodes[i].ElementBounds.Reset();
+			Nodes[i].FirstChild = INDEX_NONE;
+		}
+
+		NumNodes = 0;
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::Trim()
+	{
+		// Drop pooled nodes not used by the current tree.
+		Nodes.SetNum(NumNodes, EAllowShrinking::Yes);
+
+		for (FNode& N : Nodes)
+		{
+			N.Elements.Shrink();
+			N.ElementBounds.Shrink();
+		}
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	SIZE_T TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::GetAllocatedSize() const
+	{
+		SIZE_T Size = Nodes.GetAllocatedSize();
+		for (const FNode& N : Nodes)
+		{
+			Size += N.Elements.GetAllocatedSize() + N.ElementBounds.GetAllocatedSize();
+		}
+		return Size;
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::Build(const CKzContainer auto& Container)
 	{
 		Reset();
 
@@ -28,10 +70,29 @@ namespace Kz
 			Global += OctreeSemantics::GetBoundingBox(E);
 		}
 
-		// Make cubic + small pad for robustness
+		// Make cubic (square on the split axes only) + small pad for robustness
 		const FVector Center = Global.GetCenter();
-		const FVector HalfSize(Global.GetExtent().GetMax());
+		const FVector Extent = Global.GetExtent();
+
+		FVector::FReal MaxSplitExtent = 0.0;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (IsSplitAxis(Axis))
+			{
+				MaxSplitExtent = FMath::Max(MaxSplitExtent, Extent[Axis]);
+			}
+		}
+
+		FVector HalfSize;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			HalfSize[Axis] = IsSplitAxis(Axis) ? MaxSplitExtent : Extent[Axis];
+		}
 		const FVector PadHalf = HalfSize * 1.02f;
+
+		const int32 RootIndex = AllocateNodes(1);
+
+		FNode& Root = Nodes[RootIndex];
 		Root.Bounds = FBox(Center - PadHalf, Center + PadHalf);
 		Root.Depth = 0;
 
@@ -43,20 +104,55 @@ namespace Kz
 		}
 
 		// Subdivide
-		BuildRecursive(Root);
+		BuildRecursive(RootIndex);
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	int32 TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::AllocateNodes(int32 Count)
+	{
+		const int32 FirstIndex = NumNodes;
+		NumNodes += Count;
+
+		// Only grow the pool when the previous builds did not leave enough nodes behind.
+		if (NumNodes > Nodes.Num())
+		{
+			Nodes.SetNum(NumNodes);
+		}
+
+		for (int32 i = FirstIndex; i < NumNodes; ++i)
+		{
+			Nodes[i].Elements.Reset();
+			Nodes[i].ElementBounds.Reset();
+			Nodes[i].FirstChild = INDEX_NONE;
+		}
+
+		return FirstIndex;
 	}
 
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
-	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::BuildRecursive(FNode& N)
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::BuildRecursive(int32 NodeIndex)
 	{
 		// Stop if reached limits
-		if (N.Depth >= MaxDepth || N.Elements.Num() <= MinElementsPerNode)
 		{
-			return; // Leaf
+			FNode& N = Nodes[NodeIndex];
+			if (N.Depth >= MaxDepth || N.Elements.Num() <= MinElementsPerNode)
+			{
+				// Leaf: cache the element bounds for SIMD culling during queries.
+				N.ElementBounds.Reserve(N.Elements.Num());
+				for (const ElementType& E : N.Elements)
+				{
+					N.ElementBounds.Add(OctreeSemantics::GetBoundingBox(E));
+				}
+				return;
+			}
 		}
 
-		// This node is not a leaf, so subdivide it into 8 children.
-		N.Children.SetNum(8);
+		// This node is not a leaf, so subdivide it into 8 children (4 for quadtrees).
+		// Allocating may grow the pool, so node references are only taken afterwards.
+		const int32 FirstChild = AllocateNodes(NumChildren);
+
+		FNode& N = Nodes[NodeIndex];
+		N.FirstChild = FirstChild;
 
 		const FVector ParentCenter = N.Bounds.GetCenter();
 
@@ -64,25 +160,38 @@ namespace Kz
 		const FVector ParentLooseExtent = N.Bounds.GetExtent();
 		const FVector ParentTightExtent = (N.Depth == 0) ? ParentLooseExtent : (ParentLooseExtent / Looseness);
 
-		const FVector ChildTightExtent = ParentTightExtent * 0.5f;
-		const FVector ChildLooseExtent = ChildTightExtent * Looseness;
+		FVector ChildTightExtent = ParentTightExtent * 0.5f;
+		FVector ChildLooseExtent = ChildTightExtent * Looseness;
+
+		// Children span the whole parent along the axes that are not split.
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (!IsSplitAxis(Axis))
+			{
+				ChildTightExtent[Axis] = ParentLooseExtent[Axis];
+				ChildLooseExtent[Axis] = ParentLooseExtent[Axis];
+			}
+		}
+
+		FNode* Children = &Nodes[FirstChild];
 
-		// Initialize all 8 children with loose bounds (octants)
-		for (int32 i = 0; i < 8; ++i)
+		// Initialize all children with loose bounds (octants or quadrants)
+		for (int32 i = 0; i < NumChildren; ++i)
 		{
 			FVector ChildCenter = ParentCenter;
-			ChildCenter.X += ((i & 1) ? 1.f : -1.f) * ChildTightExtent.X;
-			ChildCenter.Y += ((i & 2) ? 1.f : -1.f) * ChildTightExtent.Y;
-			ChildCenter.Z += ((i & 4) ? 1.f : -1.f) * ChildTightExtent.Z;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (IsSplitAxis(Axis))
+				{
+					ChildCenter[Axis] += ((i & GetChildBit(Axis)) ? 1.f : -1.f) * ChildTightExtent[Axis];
+				}
+			}
 
-			N.Children[i].Bounds = FBox(ChildCenter - ChildLooseExtent, ChildCenter + ChildLooseExtent);
-			N.Children[i].Depth = N.Depth + 1;
+			Children[i].Bounds = FBox(ChildCenter - ChildLooseExtent, ChildCenter + ChildLooseExtent);
+			Children[i].Depth = N.Depth + 1;
 		}
 
-		// Distribute elements by the center of their bounds
-		TArray<TArray<ElementType>> Buckets;
-		Buckets.SetNum(8);
-
+		// Distribute elements by the center of their bounds, straight into the (recycled) child arrays.
 		for (const ElementType& E : N.Elements)
 		{
 			const FBox ElemBounds = OctreeSemantics::GetBoundingBox(E);
@@ -90,11 +199,11 @@ namespace Kz
 			if constexpr (bAllowMultiNode)
 			{
 				// Insert into ALL child nodes that intersect the bounding box
-				for (int32 i = 0; i < 8; ++i)
+				for (int32 i = 0; i < NumChildren; ++i)
 				{
-					if (N.Children[i].Bounds.Intersect(ElemBounds))
+					if (Children[i].Bounds.Intersect(ElemBounds))
 					{
-						Buckets[i].Add(E);
+						Children[i].Elements.Add(E);
 					}
 				}
 			}
@@ -103,34 +212,30 @@ namespace Kz
 				// Insert based on center
 				const FVector ElemCenter = ElemBounds.GetCenter();
 				int32 Index = 0;
-				if (ElemCenter.X > ParentCenter.X) Index |= 1;
-				if (ElemCenter.Y > ParentCenter.Y) Index |= 2;
-				if (ElemCenter.Z > ParentCenter.Z) Index |= 4;
-				Buckets[Index].Add(E);
+				for (int32 Axis = 0; Axis < 3; ++Axis)
+				{
+					if (IsSplitAxis(Axis) && ElemCenter[Axis] > ParentCenter[Axis]) Index |= GetChildBit(Axis);
+				}
+				Children[Index].Elements.Add(E);
 			}
 		}
 
-		// Clear elements from this inner node
-		N.Elements.Empty();
+		// Clear elements from this inner node, keeping the allocation for later rebuilds.
+		N.Elements.Reset();
 
-		for (int32 i = 0; i < 8; ++i)
+		for (int32 i = 0; i < NumChildren; ++i)
 		{
-			if (Buckets[i].Num() > 0)
+			// Empty children remain empty leaf nodes.
+			if (Nodes[FirstChild + i].Elements.Num() > 0)
 			{
-				N.Children[i].Elements = MoveTemp(Buckets[i]);
-				BuildRecursive(N.Children[i]);
-			}
-			else
-			{
-				// If a child node is empty, it remains an empty leaf node.
-				N.Children[i].Children.Empty(); // Ensure it's a leaf
+				BuildRecursive(FirstChild + i);
 			}
 		}
 	}
 
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
 	template<typename TValidator>
-	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::Raycast(ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator) const
+	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::Raycast(ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator) const
 	{
 		const float SizeSq = RayDir.SizeSquared();
 		if (SizeSq < UE_SMALL_NUMBER)
@@ -154,16 +259,21 @@ namespace Kz
 		OutHit.bBlockingHit = false;
 		OutHit.Distance = RayLength;
 
+		if (NumNodes == 0)
+		{
+			return false;
+		}
+
 		TSet<ElementIdType> Visited;
 
 		// Begin the recursive traversal starting from the root node.
-		RaycastRecursive(Root, OutId, OutHit, RayStart, Dir, RayLength, Forward<TValidator>(Validator), Visited);
+		RaycastRecursive(GetRoot(), OutId, OutHit, RayStart, Dir, RayLength, Forward<TValidator>(Validator), Visited);
 		return OutHit.bBlockingHit;
 	}
 
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
 	template<typename TValidator>
-	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::RaycastRecursive(const FNode& N, ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator, TSet<ElementIdType>& Visited) const
+	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::RaycastRecursive(const FNode& N, ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator, TSet<ElementIdType>& Visited) const
 	{
 		// Broad-phase pruning
 		const float MaxDist = OutHit.bBlockingHit ? OutHit.Distance : RayLength;
@@ -175,9 +285,11 @@ namespace Kz
 
 		if (N.IsLeaf())
 		{
-			// Narrow phase: test all elements in this leaf node.
-			for (const ElementType& E : N.Elements)
+			// Narrow phase: only elements whose cached bounds are crossed by the ray reach GJK.
+			float CullDistance = MaxDist;
+			N.ElementBounds.ForEachRayHit(RayStart, RayDir, CullDistance, [&](int32 ElementIndex)
 			{
+				const ElementType& E = N.Elements[ElementIndex];
 				const ElementIdType Id = OctreeSemantics::GetElementId(E);
 
 				// Prevent duplication
@@ -185,7 +297,7 @@ namespace Kz
 				{
 					if (Visited.Contains(Id))
 					{
-						continue;
+						return;
 					}
 
 					Visited.Add(Id);
@@ -193,24 +305,21 @@ namespace Kz
 
 				if (!OctreeSemantics::IsValid(E) || !Validator(E))
 				{
-					continue;
+					return;
 				}
 
-				const FKzShapeInstance ElemShape = GetElementShape(E);
-				const FVector ElemPos = OctreeSemantics::GetElementPosition(E);
-				const FQuat ElemRot = GetElementRotation(E);
-
 				const float MaxCheckLength = OutHit.bBlockingHit ? OutHit.Distance : RayLength;
 
 				const float PrevDist = OutHit.Distance;
 
 				FKzHitResult HitCandidate = OutHit;
-				if (Kz::GJK::Raycast(HitCandidate, RayStart, RayDir, MaxCheckLength, ElemShape, ElemPos, ElemRot) && HitCandidate.Distance < PrevDist)
+				if (RaycastElement(HitCandidate, E, RayStart, RayDir, MaxCheckLength) && HitCandidate.Distance < PrevDist)
 				{
 					OutHit = HitCandidate;
 					OutId = Id;
+					CullDistance = OutHit.Distance;
 				}
-			}
+			});
 
 			return; // Nothing else below this leaf.
 		}
@@ -224,7 +333,7 @@ namespace Kz
 		FChildHit Candidates[8];
 		int32 NumCandidates = 0;
 
-		for (const FNode& Child : N.Children)
+		for (const FNode& Child : GetChildren(N))
 		{
 			const float CurrentMaxDist = OutHit.bBlockingHit ? OutHit.Distance : RayLength;
 			FKzHitResult ChildHitResult;
@@ -256,25 +365,251 @@ namespace Kz
 		}
 	}
 
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<typename AllocatorType, typename TValidator>
+	int32 TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::RaycastMulti(TArray<TSpatialRayHit<ElementIdType>, AllocatorType>& OutHits, const FVector& RayStart, const FVector& RayDir, float RayLength, int32 MaxHits, TValidator&& Validator) const
+	{
+		OutHits.Reset();
+
+		const float SizeSq = RayDir.SizeSquared();
+		if (SizeSq < UE_SMALL_NUMBER)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TOctree::RaycastMulti called with zero-length direction"));
+			return 0;
+		}
+
+		FVector Dir = RayDir;
+		if (!FMath::IsNearlyEqual(SizeSq, 1.0f))
+		{
+			Dir *= FMath::InvSqrt(SizeSq);
+		}
+
+		if (RayLength <= 0.0f)
+		{
+			RayLength = UE_BIG_NUMBER;
+		}
+
+		if (NumNodes == 0)
+		{
+			return 0;
+		}
+
+		TSet<ElementIdType> Visited;
+		float CutoffDistance = RayLength;
+
+		RaycastMultiRecursive(GetRoot(), OutHits, RayStart, Dir, RayLength, MaxHits, CutoffDistance, Forward<TValidator>(Validator), Visited);
+		return OutHits.Num();
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<typename AllocatorType, typename TValidator>
+	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::RaycastMultiRecursive(const FNode& N, TArray<TSpatialRayHit<ElementIdType>, AllocatorType>& OutHits, const FVector& RayStart, const FVector& RayDir, float RayLength, int32 MaxHits, float& CutoffDistance, TValidator&& Validator, TSet<ElementIdType>& Visited) const
+	{
+		// Broad-phase pruning
+		FKzHitResult BoundsHit;
+		if (!Kz::Raycast::Box(BoundsHit, N.Bounds.GetCenter(), N.Bounds.GetExtent(), RayStart, RayDir, CutoffDistance))
+		{
+			return;
+		}
+
+		if (N.IsLeaf())
+		{
+			N.ElementBounds.ForEachRayHit(RayStart, RayDir, CutoffDistance, [&](int32 ElementIndex)
+			{
+				const ElementType& E = N.Elements[ElementIndex];
+				const ElementIdType Id = OctreeSemantics::GetElementId(E);
+
+				// Prevent duplication
+				if constexpr (bAllowMultiNode)
+				{
+					if (Visited.Contains(Id))
+					{
+						return;
+					}
+
+					Visited.Add(Id);
+				}
+
+				if (!OctreeSemantics::IsValid(E) || !Validator(E))
+				{
+					return;
+				}
+
+				// Test against the full ray so Time stays relative to RayLength for every hit.
+				FKzHitResult Hit;
+				if (RaycastElement(Hit, E, RayStart, RayDir, RayLength) && Hit.Distance <= CutoffDistance)
+				{
+					CutoffDistance = Kz::Spatial::AddSortedHit(OutHits, Id, Hit, MaxHits, RayLength);
+				}
+			});
+
+			return;
+		}
+
+		struct FChildHit
+		{
+			const FNode* Node;
+			float EntryDist;
+		};
+		FChildHit Candidates[8];
+		int32 NumCandidates = 0;
+
+		for (const FNode& Child : GetChildren(N))
+		{
+			FKzHitResult ChildHitResult;
+			if (Kz::Raycast::Box(ChildHitResult, Child.Bounds.GetCenter(), Child.Bounds.GetExtent(), RayStart, RayDir, CutoffDistance))
+			{
+				Candidates[NumCandidates++] = { &Child, ChildHitResult.Distance };
+			}
+		}
+
+		// Front-to-back order lets a capped search stop as soon as the remaining children start past the farthest kept hit.
+		Algo::SortBy(MakeArrayView(Candidates, NumCandidates), &FChildHit::EntryDist);
+
+		for (int32 i = 0; i < NumCandidates; ++i)
+		{
+			if (Candidates[i].EntryDist > CutoffDistance)
+			{
+				break;
+			}
+
+			RaycastMultiRecursive(*Candidates[i].Node, OutHits, RayStart, RayDir, RayLength, MaxHits, CutoffDistance, Forward<TValidator>(Validator), Visited);
+		}
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<typename TValidator>
+	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::RaycastAny(ElementIdType& OutId, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator) const
+	{
+		const float SizeSq = RayDir.SizeSquared();
+		if (SizeSq < UE_SMALL_NUMBER)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TOctree::RaycastAny called with zero-length direction"));
+			return false;
+		}
+
+		FVector Dir = RayDir;
+		if (!FMath::IsNearlyEqual(SizeSq, 1.0f))
+		{
+			Dir *= FMath::InvSqrt(SizeSq);
+		}
+
+		if (RayLength <= 0.0f)
+		{
+			RayLength = UE_BIG_NUMBER;
+		}
+
+		if (NumNodes == 0)
+		{
+			return false;
+		}
+
+		TSet<ElementIdType> Visited;
+		return RaycastAnyRecursive(GetRoot(), OutId, RayStart, Dir, RayLength, Forward<TValidator>(Validator), Visited);
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<typename TValidator>
+	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::RaycastAnyRecursive(const FNode& N, ElementIdType& OutId, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator, TSet<ElementIdType>& Visited) const
+	{
+		// Broad-phase pruning
+		FKzHitResult BoundsHit;
+		if (!Kz::Raycast::Box(BoundsHit, N.Bounds.GetCenter(), N.Bounds.GetExtent(), RayStart, RayDir, RayLength))
+		{
+			return false;
+		}
+
+		if (N.IsLeaf())
+		{
+			bool bBlocked = false;
+
+			N.ElementBounds.ForEachRayHit(RayStart, RayDir, RayLength, [&](int32 ElementIndex)
+			{
+				const ElementType& E = N.Elements[ElementIndex];
+				const ElementIdType Id = OctreeSemantics::GetElementId(E);
+
+				// Prevent duplication
+				if constexpr (bAllowMultiNode)
+				{
+					if (Visited.Contains(Id))
+					{
+						return true;
+					}
+
+					Visited.Add(Id);
+				}
+
+				if (!OctreeSemantics::IsValid(E) || !Validator(E))
+				{
+					return true;
+				}
+
+				if (RaycastElementTest(E, RayStart, RayDir, RayLength))
+				{
+					OutId = Id;
+					bBlocked = true;
+					return false; // Any hit will do.
+				}
+
+				return true;
+			});
+
+			return bBlocked;
+		}
+
+		// Any blocking element ends the search, so children are visited in storage order.
+		for (const FNode& Child : GetChildren(N))
+		{
+			if (RaycastAnyRecursive(Child, OutId, RayStart, RayDir, RayLength, Forward<TValidator>(Validator), Visited))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
 	template<typename TValidator>
-	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::Query(TArray<ElementIdType>& OutResults, const FBox& Bounds, TValidator&& Validator) const
+	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::LineOfSight(const FVector& From, const FVector& To, TValidator&& Validator) const
 	{
+		const FVector Delta = To - From;
+		const float Length = Delta.Size();
+		if (Length < UE_KINDA_SMALL_NUMBER)
+		{
+			return true;
+		}
+
+		ElementIdType BlockingId;
+		return !RaycastAny(BlockingId, From, Delta / Length, Length, Forward<TValidator>(Validator));
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<typename TValidator>
+	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::Query(TArray<ElementIdType>& OutResults, const FBox& Bounds, TValidator&& Validator) const
+	{
+		if (NumNodes == 0)
+		{
+			return false;
+		}
+
 		TSet<ElementIdType> Visited;
-		QueryRecursive(Root, OutResults, Bounds, Forward<TValidator>(Validator), Visited);
+		QueryRecursive(GetRoot(), OutResults, Bounds, Forward<TValidator>(Validator), Visited);
 		return !OutResults.IsEmpty();
 	}
 
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
 	template<typename TValidator>
-	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::QueryRecursive(const FNode& N, TArray<ElementIdType>& OutResults, const FBox& Bounds, TValidator&& Validator, TSet<ElementIdType>& Visited) const
+	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::QueryRecursive(const FNode& N, TArray<ElementIdType>& OutResults, const FBox& Bounds, TValidator&& Validator, TSet<ElementIdType>& Visited) const
 	{
 		if (!N.Bounds.Intersect(Bounds)) return;
 
 		if (N.IsLeaf())
 		{
-			for (const ElementType& E : N.Elements)
+			// Cached float bounds are conservative, survivors are confirmed against the exact bounds.
+			N.ElementBounds.ForEachOverlap(Bounds, [&](int32 ElementIndex)
 			{
+				const ElementType& E = N.Elements[ElementIndex];
 				const ElementIdType Id = OctreeSemantics::GetElementId(E);
 
 				// Prevent duplication
@@ -282,7 +617,7 @@ namespace Kz
 				{
 					if (Visited.Contains(Id))
 					{
-						continue;
+						return;
 					}
 
 					Visited.Add(Id);
@@ -290,42 +625,56 @@ namespace Kz
 
 				if (!OctreeSemantics::IsValid(E) || !Validator(E))
 				{
-					continue;
+					return;
 				}
 
 				if (Bounds.Intersect(OctreeSemantics::GetBoundingBox(E)))
 				{
-					OutResults.Add(OctreeSemantics::GetElementId(E));
+					OutResults.Add(Id);
 				}
-			}
+			});
 		}
 		else
 		{
-			for (const FNode& Child : N.Children)
+			for (const FNode& Child : GetChildren(N))
 			{
 				QueryRecursive(Child, OutResults, Bounds, Forward<TValidator>(Validator), Visited);
 			}
 		}
 	}
 
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
 	template<typename TValidator>
-	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::Query(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, TValidator&& Validator) const
+	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::Query(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, TValidator&& Validator) const
 	{
 		const FBox QueryAABB = Shape.GetBoundingBox(ShapePosition, ShapeRotation);
-		if (!QueryAABB.IsValid)
+		if (!QueryAABB.IsValid || NumNodes == 0)
+		{
+			return false;
+		}
+
+		TSet<ElementIdType> Visited;
+		QueryRecursive(GetRoot(), OutResults, Shape, ShapePosition, ShapeRotation, QueryAABB, Forward<TValidator>(Validator), Visited);
+		return !OutResults.IsEmpty();
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<typename TValidator>
+	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::Query(TArray<ElementIdType>& OutResults, const FKzShapeWorldCache& Shape, TValidator&& Validator) const
+	{
+		if (!Shape.IsValid() || NumNodes == 0)
 		{
 			return false;
 		}
 
 		TSet<ElementIdType> Visited;
-		QueryRecursive(Root, OutResults, Shape, ShapePosition, ShapeRotation, QueryAABB, Forward<TValidator>(Validator), Visited);
+		QueryRecursive(GetRoot(), OutResults, Shape.Shape, Shape.Position, Shape.Rotation, Shape.Bounds, Forward<TValidator>(Validator), Visited);
 		return !OutResults.IsEmpty();
 	}
 
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
 	template<typename TValidator>
-	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::QueryRecursive(const FNode& N, TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FBox& QueryAABB, TValidator&& Validator, TSet<ElementIdType>& Visited) const
+	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::QueryRecursive(const FNode& N, TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FBox& QueryAABB, TValidator&& Validator, TSet<ElementIdType>& Visited) const
 	{
 		// Broad-phase: skip node if its bounds don't intersect the query AABB.
 		if (!N.Bounds.Intersect(QueryAABB))
@@ -335,8 +684,10 @@ namespace Kz
 
 		if (N.IsLeaf())
 		{
-			for (const ElementType& E : N.Elements)
+			// Only elements whose cached bounds overlap the query AABB reach GJK.
+			N.ElementBounds.ForEachOverlap(QueryAABB, [&](int32 ElementIndex)
 			{
+				const ElementType& E = N.Elements[ElementIndex];
 				const ElementIdType Id = OctreeSemantics::GetElementId(E);
 
 				// Prevent duplication
@@ -344,59 +695,303 @@ namespace Kz
 				{
 					if (Visited.Contains(Id))
 					{
-						continue;
+						return;
 					}
 
 					Visited.Add(Id);
 				}
 
 				if (!OctreeSemantics::IsValid(E) || !Validator(E))
+				{
+					return;
+				}
+
+				if (IntersectElement(E, Shape, ShapePosition, ShapeRotation))
+				{
+					OutResults.Add(Id);
+				}
+			});
+		}
+		else
+		{
+			for (const FNode& Child : GetChildren(N))
+			{
+				QueryRecursive(Child, OutResults, Shape, ShapePosition, ShapeRotation, QueryAABB, Forward<TValidator>(Validator), Visited);
+			}
+		}
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<typename TValidator>
+	int32 TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::QueryBatch(TSpatialBatchResult<ElementIdType>& OutResults, TConstArrayView<FBox> Bounds, TValidator&& Validator) const
+	{
+		Spatial::ParallelQueryBatch(OutResults, NumNodes > 0 ? Bounds.Num() : 0, [&](int32 QueryIndex, TArray<ElementIdType>& OutIds, TSet<ElementIdType>& Visited)
+		{
+			QueryRecursive(GetRoot(), OutIds, Bounds[QueryIndex], Validator, Visited);
+		});
+
+		return OutResults.Ids.Num();
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<typename TValidator>
+	int32 TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::QueryBatch(TSpatialBatchResult<ElementIdType>& OutResults, TConstArrayView<FKzShapeInstance> Shapes, TConstArrayView<FVector> ShapePositions, TConstArrayView<FQuat> ShapeRotations, TValidator&& Validator) const
+	{
+		check(Shapes.Num() == ShapePositions.Num() && Shapes.Num() == ShapeRotations.Num());
+
+		Spatial::ParallelQueryBatch(OutResults, NumNodes > 0 ? Shapes.Num() : 0, [&](int32 QueryIndex, TArray<ElementIdType>& OutIds, TSet<ElementIdType>& Visited)
+		{
+			const FKzShapeInstance& Shape = Shapes[QueryIndex];
+			const FVector& ShapePosition = ShapePositions[QueryIndex];
+			const FQuat& ShapeRotation = ShapeRotations[QueryIndex];
+
+			const FBox QueryAABB = Shape.GetBoundingBox(ShapePosition, ShapeRotation);
+			if (QueryAABB.IsValid)
+			{
+				QueryRecursive(GetRoot(), OutIds, Shape, ShapePosition, ShapeRotation, QueryAABB, Validator, Visited);
+			}
+		});
+
+		return OutResults.Ids.Num();
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<typename TValidator>
+	int32 TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::RaycastBatch(TArray<ElementIdType>& OutIds, TArray<FKzHitResult>& OutHits, TConstArrayView<FVector> RayStarts, TConstArrayView<FVector> RayDirs, float RayLength, TValidator&& Validator) const
+	{
+		check(RayStarts.Num() == RayDirs.Num());
+
+		const int32 NumRays = RayStarts.Num();
+		OutIds.Reset();
+		OutIds.SetNum(NumRays);
+		OutHits.Reset();
+		OutHits.SetNum(NumRays);
+
+		ParallelFor(NumRays, [&](int32 RayIndex)
+		{
+			Raycast(OutIds[RayIndex], OutHits[RayIndex], RayStarts[RayIndex], RayDirs[RayIndex], RayLength, Validator);
+		});
+
+		int32 NumHits = 0;
+		for (const FKzHitResult& Hit : OutHits)
+		{
+			NumHits += Hit.bBlockingHit ? 1 : 0;
+		}
+		return NumHits;
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<int32 PacketSize, typename TValidator>
+	int32 TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::RaycastPacket(TArray<ElementIdType>& OutIds, TArray<FKzHitResult>& OutHits, TConstArrayView<FVector> RayStarts, TConstArrayView<FVector> RayDirs, float RayLength, TValidator&& Validator) const
+	{
+		check(RayStarts.Num() == RayDirs.Num());
+
+		const int32 NumRays = RayStarts.Num();
+		OutIds.Reset();
+		OutIds.SetNum(NumRays);
+		OutHits.Reset();
+		OutHits.SetNum(NumRays);
+
+		if (RayLength <= 0.0f)
+		{
+			RayLength = UE_BIG_NUMBER;
+		}
+
+		TRayPacket<PacketSize> Packet;
+		TMap<ElementIdType, uint32> TestedRays;
+		int32 NumHits = 0;
+
+		for (int32 FirstRay = 0; FirstRay < NumRays; FirstRay += PacketSize)
+		{
+			const int32 Count = FMath::Min(PacketSize, NumRays - FirstRay);
+
+			Packet.Reset();
+			uint32 RayMask = 0;
+
+			for (int32 i = 0; i < Count; ++i)
+			{
+				const FVector& RayStart = RayStarts[FirstRay + i];
+				const float SizeSq = RayDirs[FirstRay + i].SizeSquared();
+				const FVector Dir = (SizeSq < UE_SMALL_NUMBER) ? FVector::ZeroVector : RayDirs[FirstRay + i] * FMath::InvSqrt(SizeSq);
+
+				FKzHitResult& Hit = OutHits[FirstRay + i];
+				Hit.Init(RayStart, RayStart + Dir * RayLength);
+				Hit.bBlockingHit = false;
+				Hit.Distance = RayLength;
+
+				// Zero-length directions never hit, as in Raycast().
+				if (SizeSq >= UE_SMALL_NUMBER)
+				{
+					Packet.SetRay(i, RayStart, Dir, RayLength);
+					RayMask |= 1u << i;
+				}
+			}
+
+			if (NumNodes == 0 || RayMask == 0)
+			{
+				continue;
+			}
+
+			// Broad-phase pruning of the root
+			float RootEntry;
+			RayMask = Packet.IntersectBox(GetRoot().Bounds, RayMask, RootEntry);
+			if (RayMask == 0)
+			{
+				continue;
+			}
+
+			TestedRays.Reset();
+			RaycastPacketRecursive(GetRoot(), Packet, RayMask, &OutIds[FirstRay], &OutHits[FirstRay], Validator, TestedRays);
+		}
+
+		for (const FKzHitResult& Hit : OutHits)
+		{
+			NumHits += Hit.bBlockingHit ? 1 : 0;
+		}
+		return NumHits;
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	template<int32 PacketSize, typename TValidator>
+	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::RaycastPacketRecursive(const FNode& N, TRayPacket<PacketSize>& Packet, uint32 RayMask, ElementIdType* OutIds, FKzHitResult* OutHits, TValidator& Validator, TMap<ElementIdType, uint32>& TestedRays) const
+	{
+		if (N.IsLeaf())
+		{
+			for (int32 ElementIndex = 0; ElementIndex < N.Elements.Num(); ++ElementIndex)
+			{
+				// Cull against the cached element bounds, for all rays at once.
+				float Entry;
+				uint32 ElementRays = Packet.IntersectBox(N.ElementBounds.GetBox(ElementIndex), RayMask, Entry);
+				if (ElementRays == 0)
 				{
 					continue;
 				}
 
-				const FKzShapeInstance ElemShape = GetElementShape(E);
-				const FVector ElemPos = OctreeSemantics::GetElementPosition(E);
-				const FQuat ElemRot = GetElementRotation(E);
+				const ElementType& E = N.Elements[ElementIndex];
+				const ElementIdType Id = OctreeSemantics::GetElementId(E);
 
-				if (Kz::GJK::Intersect(Shape, ShapePosition, ShapeRotation, ElemShape, ElemPos, ElemRot))
+				// Prevent duplication: each ray tests an element only once, even if it spans several leaves.
+				if constexpr (bAllowMultiNode)
 				{
-					OutResults.Add(OctreeSemantics::GetElementId(E));
+					uint32& Tested = TestedRays.FindOrAdd(Id, 0);
+					ElementRays &= ~Tested;
+					Tested |= ElementRays;
+
+					if (ElementRays == 0)
+					{
+						continue;
+					}
+				}
+
+				if (!OctreeSemantics::IsValid(E) || !Validator(E))
+				{
+					continue;
 				}
+
+				// Fetch the element shape once for all the rays of the packet.
+				auto RaycastShape = [&E]()
+				{
+					if constexpr (requires { OctreeSemantics::GetWorldCache(E); })
+					{
+						return [&Cache = OctreeSemantics::GetWorldCache(E)](FKzHitResult& Hit, const FVector& Origin, const FVector& Dir, float MaxDistance)
+						{
+							return Kz::GJK::Raycast(Hit, Origin, Dir, MaxDistance, Cache);
+						};
+					}
+					else
+					{
+						return [ElemShape = GetElementShape(E), ElemPos = OctreeSemantics::GetElementPosition(E), ElemRot = GetElementRotation(E)](FKzHitResult& Hit, const FVector& Origin, const FVector& Dir, float MaxDistance)
+						{
+							return Kz::GJK::Raycast(Hit, Origin, Dir, MaxDistance, ElemShape, ElemPos, ElemRot);
+						};
+					}
+				}();
+
+				TRayPacket<PacketSize>::ForEachRay(ElementRays, [&](int32 RayIndex)
+				{
+					FKzHitResult& OutHit = OutHits[RayIndex];
+					const float PrevDist = OutHit.Distance;
+
+					FKzHitResult HitCandidate = OutHit;
+					if (RaycastShape(HitCandidate, Packet.GetOrigin(RayIndex), Packet.GetDir(RayIndex), Packet.GetMaxDistance(RayIndex)) && HitCandidate.Distance < PrevDist)
+					{
+						OutHit = HitCandidate;
+						OutIds[RayIndex] = Id;
+						Packet.SetMaxDistance(RayIndex, OutHit.Distance);
+					}
+				});
 			}
+
+			return;
 		}
-		else
+
+		// --- Internal node: collect children crossed by at least one ray ---
+		struct FChildHit
 		{
-			for (const FNode& Child : N.Children)
+			const FNode* Node;
+			uint32 RayMask;
+			float EntryDist;
+		};
+		FChildHit Candidates[8];
+		int32 NumCandidates = 0;
+
+		for (const FNode& Child : GetChildren(N))
+		{
+			float EntryDist;
+			const uint32 ChildRays = Packet.IntersectBox(Child.Bounds, RayMask, EntryDist);
+			if (ChildRays != 0)
 			{
-				QueryRecursive(Child, OutResults, Shape, ShapePosition, ShapeRotation, QueryAABB, Forward<TValidator>(Validator), Visited);
+				Candidates[NumCandidates++] = { &Child, ChildRays, EntryDist };
+			}
+		}
+
+		// Sort by the closest entry distance of any ray, so hits found early shorten the rays for the rest.
+		Algo::SortBy(MakeArrayView(Candidates, NumCandidates), &FChildHit::EntryDist);
+
+		for (int32 i = 0; i < NumCandidates; ++i)
+		{
+			const FChildHit& ChildHit = Candidates[i];
+
+			// Rays may have found closer hits since the child was tested; drop the ones that no longer reach it.
+			float EntryDist;
+			const uint32 ChildRays = (i == 0) ? ChildHit.RayMask : Packet.IntersectBox(ChildHit.Node->Bounds, ChildHit.RayMask, EntryDist);
+			if (ChildRays != 0)
+			{
+				RaycastPacketRecursive(*ChildHit.Node, Packet, ChildRays, OutIds, OutHits, Validator, TestedRays);
 			}
 		}
 	}
 
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
-	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::DebugDraw(const UWorld* World, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	void TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::DebugDraw(const UWorld* World, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
 	{
-		if (!World)
+		if (!World || NumNodes == 0)
 		{
 			return;
 		}
 
 		TArray<const FNode*> Stack;
-		Stack.Push(&Root);
+		Stack.Push(&GetRoot());
 
 		while (Stack.Num() > 0)
 		{
 			const FNode& N = *Stack.Pop(EAllowShrinking::No);
 
-			// Compute extent, compensating for looseness only below the root
-			const FVector Extent = N.Bounds.GetExtent() / (N.Depth == 0 ? 1.0f : Looseness);
+			// Compute extent, compensating for looseness only below the root and on split axes
+			FVector Extent = N.Bounds.GetExtent();
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (IsSplitAxis(Axis) && N.Depth > 0)
+				{
+					Extent[Axis] /= Looseness;
+				}
+			}
 
 			// Draw the node AABB
 			DrawDebugBox(World, N.Bounds.GetCenter(), Extent, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
 
 			// Continue traversing children
-			for (const FNode& Child : N.Children)
+			for (const FNode& Child : GetChildren(N))
 			{
 				Stack.Push(&Child);
 			}
@@ -404,8 +999,8 @@ namespace Kz
 	}
 
 	// Helpers
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
-	FKzShapeInstance TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::GetElementShape(const ElementType& E)
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	decltype(auto) TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::GetElementShape(const ElementType& E)
 	{
 		if constexpr (requires { OctreeSemantics::GetShape(E); })
 		{
@@ -417,12 +1012,12 @@ namespace Kz
 			// Fallback: use bounding sphere derived from bounding box.
 			const FBox B = OctreeSemantics::GetBoundingBox(E);
 			const float Radius = B.GetExtent().GetAbsMax();
-			return FKzShapeInstance::Make<FKzSphere>(Radius);
+			return FKzShapeValue(FKzSphere(Radius));
 		}
 	}
 
-	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode>
-	FQuat TOctree<ElementType, OctreeSemantics, bAllowMultiNode>::GetElementRotation(const ElementType& E)
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	FQuat TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::GetElementRotation(const ElementType& E)
 	{
 		if constexpr (requires { OctreeSemantics::GetElementRotation(E); })
 		{
@@ -433,4 +1028,44 @@ namespace Kz
 			return FQuat::Identity;
 		}
 	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::RaycastElement(FKzHitResult& OutHit, const ElementType& E, const FVector& RayStart, const FVector& RayDir, float RayLength)
+	{
+		if constexpr (requires { OctreeSemantics::GetWorldCache(E); })
+		{
+			return Kz::GJK::Raycast(OutHit, RayStart, RayDir, RayLength, OctreeSemantics::GetWorldCache(E));
+		}
+		else
+		{
+			return Kz::GJK::Raycast(OutHit, RayStart, RayDir, RayLength, GetElementShape(E), OctreeSemantics::GetElementPosition(E), GetElementRotation(E));
+		}
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::RaycastElementTest(const ElementType& E, const FVector& RayStart, const FVector& RayDir, float RayLength)
+	{
+		if constexpr (requires { OctreeSemantics::GetWorldCache(E); })
+		{
+			return Kz::GJK::RaycastTest(RayStart, RayDir, RayLength, OctreeSemantics::GetWorldCache(E));
+		}
+		else
+		{
+			return Kz::GJK::RaycastTest(RayStart, RayDir, RayLength, GetElementShape(E), OctreeSemantics::GetElementPosition(E), GetElementRotation(E));
+		}
+	}
+
+	template<typename ElementType, typename OctreeSemantics, bool bAllowMultiNode, typename InAllocatorType, EKzAxis3D SplitAxes>
+	bool TOctree<ElementType, OctreeSemantics, bAllowMultiNode, InAllocatorType, SplitAxes>::IntersectElement(const ElementType& E, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation)
+	{
+		if constexpr (requires { OctreeSemantics::GetWorldCache(E); })
+		{
+			const FKzShapeWorldCache& Cache = OctreeSemantics::GetWorldCache(E);
+			return Kz::Overlap::Intersect(Shape, ShapePosition, ShapeRotation, Cache.Shape, Cache.Position, Cache.Rotation);
+		}
+		else
+		{
+			return Kz::Overlap::Intersect(Shape, ShapePosition, ShapeRotation, GetElementShape(E), OctreeSemantics::GetElementPosition(E), GetElementRotation(E));
+		}
+	}
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/HandleArray.h"
+#include "Handles/SimpleHandle.h"
+#include "Math/Box.h"
+#include "Templates/SharedPointer.h"
+#include "Spatial/KzSpatialTypes.h"
+
+struct FKzHitResult;
+struct FKzShapeInstance;
+struct FKzShapeWorldCache;
+
+namespace Kz
+{
+	/**
+	 * Spatial index split into independent partitions, typically one per streamed world region.
+	 *
+	 * Each partition is a complete sub-index (eg. TOctree or TSpatialHashGrid) built offline or when
+	 * its region loads, plus the world bounds it covers. Attaching or detaching a partition is O(1)
+	 * and never touches the other partitions. Queries only fan out to the partitions whose bounds
+	 * they overlap, and raycasts visit them front-to-back.
+	 *
+	 * Every element is expected to live in exactly one partition, and partition bounds must enclose
+	 * the bounds of all their elements. Results are not deduplicated across partitions.
+	 *
+	 * IndexType must provide the usual spatial index API: Raycast, RaycastAny, RaycastMulti and Query.
+	 */
+	template <typename IndexType>
+	class TPartitionedSpatialIndex
+	{
+		using FDefaultValidator = decltype([](const auto&) { return true; });
+
+	public:
+		using ElementIdType = typename IndexType::ElementIdType;
+		using FPartitionHandle = FSimpleHandle;
+
+		/**
+		 * Attaches a built sub-index (O(1)).
+		 *
+		 * @param Index   The sub-index. Shared, so it can be built on a worker thread or kept cached while detached.
+		 * @param Bounds  World bounds of the region, enclosing all its elements.
+		 * @return Handle used to detach the partition.
+		 */
+		FPartitionHandle Attach(const TSharedRef<IndexType>& Index, const FBox& Bounds);
+
+		/** Detaches a partition (O(1)). Returns false if the handle is no longer valid. */
+		bool Detach(const FPartitionHandle& Handle);
+
+		/** Detaches all partitions. */
+		void Reset() { Partitions.Reset(); }
+
+		/** Returns the number of attached partitions. */
+		int32 NumPartitions() const { return Partitions.Num(); }
+
+		/** Returns the sub-index of a partition, or nullptr if the handle is no longer valid. */
+		IndexType* FindPartition(const FPartitionHandle& Handle) const;
+
+		/**
+		 * Performs a raycast through the partitions crossed by the ray, closest first.
+		 * See TOctree::Raycast() for the parameters.
+		 */
+		template <typename TValidator = FDefaultValidator>
+		bool Raycast(ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator = {}) const;
+
+		/**
+		 * Checks whether any element of the partitions crossed by the ray blocks it.
+		 * See TOctree::RaycastAny() for the parameters.
+		 */
+		template <typename TValidator = FDefaultValidator>
+		bool RaycastAny(ElementIdType& OutId, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator = {}) const;
+
+		/** Returns true if no element blocks the segment between From and To. */
+		template <typename TValidator = FDefaultValidator>
+		bool LineOfSight(const FVector& From, const FVector& To, TValidator&& Validator = {}) const;
+
+		/**
+		 * Collects every element crossed by the ray across partitions, sorted by distance.
+		 * See TOctree::RaycastMulti() for the parameters.
+		 */
+		template <typename AllocatorType, typename TValidator = FDefaultValidator>
+		int32 RaycastMulti(TArray<TSpatialRayHit<ElementIdType>, AllocatorType>& OutHits, const FVector& RayStart, const FVector& RayDir, float RayLength, int32 MaxHits = 0, TValidator&& Validator = {}) const;
+
+		/**
+		 * Performs a box overlap query on the partitions overlapping Bounds.
+		 * See TOctree::Query() for the parameters.
+		 */
+		template <typename TValidator = FDefaultValidator>
+		bool Query(TArray<ElementIdType>& OutResults, const FBox& Bounds, TValidator&& Validator = {}) const;
+
+		/**
+		 * Performs a shape overlap query on the partitions overlapping the shape bounds.
+		 * See TOctree::Query() for the parameters.
+		 */
+		template <typename TValidator = FDefaultValidator>
+		bool Query(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, TValidator&& Validator = {}) const;
+
+		/**
+		 * Performs a cached shape overlap query on the partitions overlapping the cached bounds.
+		 * See TOctree::Query() for the parameters.
+		 */
+		template <typename TValidator = FDefaultValidator>
+		bool Query(TArray<ElementIdType>& OutResults, const FKzShapeWorldCache& Shape, TValidator&& Validator = {}) const;
+
+		/**
+		 * Draws the partition bounds and every sub-index.
+		 * See TOctree::DebugDraw() for the parameters.
+		 */
+		void DebugDraw(const class UWorld* World, FColor const& Color, bool bPersistentLines = false, float LifeTime = -1.f, uint8 DepthPriority = 0, float Thickness = 0.f) const;
+
+	private:
+		struct FPartition
+		{
+			FBox Bounds;
+			TSharedPtr<IndexType> Index;
+		};
+
+		struct FPartitionHit
+		{
+			const FPartition* Partition;
+			float EntryDist;
+		};
+
+		/** Collects the partitions crossed by a (normalized) ray within MaxDistance, sorted by entry distance. */
+		void GatherPartitions(TArray<FPartitionHit, TInlineAllocator<16>>& OutPartitions, const FVector& RayStart, const FVector& Dir, float MaxDistance) const;
+
+		THandleArray<FPartition, FPartitionHandle> Partitions;
+	};
+}
+
+#include "Spatial/KzPartitionedSpatialIndex.inl"
\ No newline at end of file
@@ -0,0 +1,260 @@
+// Copyright 2026 kirzo
+
+#include "KzPartitionedSpatialIndex.h"
+
+#include "Collision/KzHitResult.h"
+#include "Collision/KzRaycast.h"
+#include "Math/Geometry/KzShapeInstance.h"
+#include "Math/Geometry/KzShapeWorldCache.h"
+
+#include "DrawDebugHelpers.h"
+
+namespace Kz
+{
+	template <typename IndexType>
+	typename TPartitionedSpatialIndex<IndexType>::FPartitionHandle TPartitionedSpatialIndex<IndexType>::Attach(const TSharedRef<IndexType>& Index, const FBox& Bounds)
+	{
+		return Partitions.Add(FPartition{ Bounds, Index });
+	}
+
+	template <typename IndexType>
+	bool TPartitionedSpatialIndex<IndexType>::Detach(const FPartitionHandle& Handle)
+	{
+		return Partitions.Remove(Handle);
+	}
+
+	template <typename IndexType>
+	IndexType* TPartitionedSpatialIndex<IndexType>::FindPartition(const FPartitionHandle& Handle) const
+	{
+		const FPartition* Partition = Partitions.Find(Handle);
+		return Partition ? Partition->Index.Get() : nullptr;
+	}
+
+	template <typename IndexType>
+	void TPartitionedSpatialIndex<IndexType>::GatherPartitions(TArray<FPartitionHit, TInlineAllocator<16>>& OutPartitions, const FVector& RayStart, const FVector& Dir, float MaxDistance) const
+	{
+		OutPartitions.Reset();
+
+		for (int32 i = 0; i < Partitions.Num(); ++i)
+		{
+			const FPartition& Partition = Partitions[i];
+
+			FKzHitResult BoundsHit;
+			if (Kz::Raycast::Box(BoundsHit, Partition.Bounds.GetCenter(), Partition.Bounds.GetExtent(), RayStart, Dir, MaxDistance))
+			{
+				OutPartitions.Add({ &Partition, BoundsHit.Distance });
+			}
+		}
+
+		Algo::SortBy(OutPartitions, &FPartitionHit::EntryDist);
+	}
+
+	template <typename IndexType>
+	template <typename TValidator>
+	bool TPartitionedSpatialIndex<IndexType>::Raycast(ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator) const
+	{
+		const float SizeSq = RayDir.SizeSquared();
+		if (SizeSq < UE_SMALL_NUMBER)
+			return false;
+
+		FVector Dir = RayDir;
+		if (!FMath::IsNearlyEqual(SizeSq, 1.0f))
+		{
+			Dir *= FMath::InvSqrt(SizeSq);
+		}
+
+		if (RayLength <= 0.0f)
+			RayLength = UE_BIG_NUMBER;
+
+		OutHit.Init(RayStart, RayStart + Dir * RayLength);
+		OutHit.bBlockingHit = false;
+		OutHit.Distance = RayLength;
+
+		TArray<FPartitionHit, TInlineAllocator<16>> Crossed;
+		GatherPartitions(Crossed, RayStart, Dir, RayLength);
+
+		for (const FPartitionHit& PartitionHit : Crossed)
+		{
+			// Partitions are sorted front-to-back, so none of the remaining ones can hold a closer hit.
+			if (OutHit.bBlockingHit && PartitionHit.EntryDist > OutHit.Distance)
+				break;
+
+			ElementIdType Id;
+			FKzHitResult Hit;
+			if (PartitionHit.Partition->Index->Raycast(Id, Hit, RayStart, Dir, OutHit.Distance, Validator) && Hit.Distance < OutHit.Distance)
+			{
+				OutHit = Hit;
+				OutId = Id;
+			}
+		}
+
+		if (OutHit.bBlockingHit)
+		{
+			// Sub-indices only traced up to the closest hit so far; report the trace as requested.
+			OutHit.TraceEnd = RayStart + Dir * RayLength;
+			OutHit.Time = OutHit.Distance / RayLength;
+		}
+
+		return OutHit.bBlockingHit;
+	}
+
+	template <typename IndexType>
+	template <typename TValidator>
+	bool TPartitionedSpatialIndex<IndexType>::RaycastAny(ElementIdType& OutId, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator) const
+	{
+		const float SizeSq = RayDir.SizeSquared();
+		if (SizeSq < UE_SMALL_NUMBER)
+			return false;
+
+		FVector Dir = RayDir;
+		if (!FMath::IsNearlyEqual(SizeSq, 1.0f))
+		{
+			Dir *= FMath::InvSqrt(SizeSq);
+		}
+
+		if (RayLength <= 0.0f)
+			RayLength = UE_BIG_NUMBER;
+
+		for (int32 i = 0; i < Partitions.Num(); ++i)
+		{
+			const FPartition& Partition = Partitions[i];
+
+			FKzHitResult BoundsHit;
+			if (Kz::Raycast::Box(BoundsHit, Partition.Bounds.GetCenter(), Partition.Bounds.GetExtent(), RayStart, Dir, RayLength)
+				&& Partition.Index->RaycastAny(OutId, RayStart, Dir, RayLength, Validator))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <typename IndexType>
+	template <typename TValidator>
+	bool TPartitionedSpatialIndex<IndexType>::LineOfSight(const FVector& From, const FVector& To, TValidator&& Validator) const
+	{
+		const FVector Delta = To - From;
+		const float Length = Delta.Size();
+		if (Length < UE_KINDA_SMALL_NUMBER)
+			return true;
+
+		ElementIdType BlockingId;
+		return !RaycastAny(BlockingId, From, Delta / Length, Length, Forward<TValidator>(Validator));
+	}
+
+	template <typename IndexType>
+	template <typename AllocatorType, typename TValidator>
+	int32 TPartitionedSpatialIndex<IndexType>::RaycastMulti(TArray<TSpatialRayHit<ElementIdType>, AllocatorType>& OutHits, const FVector& RayStart, const FVector& RayDir, float RayLength, int32 MaxHits, TValidator&& Validator) const
+	{
+		OutHits.Reset();
+
+		const float SizeSq = RayDir.SizeSquared();
+		if (SizeSq < UE_SMALL_NUMBER)
+			return 0;
+
+		FVector Dir = RayDir;
+		if (!FMath::IsNearlyEqual(SizeSq, 1.0f))
+		{
+			Dir *= FMath::InvSqrt(SizeSq);
+		}
+
+		if (RayLength <= 0.0f)
+			RayLength = UE_BIG_NUMBER;
+
+		TArray<FPartitionHit, TInlineAllocator<16>> Crossed;
+		GatherPartitions(Crossed, RayStart, Dir, RayLength);
+
+		TSpatialRayHitArray<ElementIdType> PartitionHits;
+		float CutoffDistance = RayLength;
+
+		for (const FPartitionHit& PartitionHit : Crossed)
+		{
+			if (PartitionHit.EntryDist > CutoffDistance)
+				break;
+
+			PartitionHit.Partition->Index->RaycastMulti(PartitionHits, RayStart, Dir, CutoffDistance, MaxHits, Validator);
+
+			for (TSpatialRayHit<ElementIdType>& RayHit : PartitionHits)
+			{
+				// Keep Time relative to the requested ray, not to the cutoff the partition was traced with.
+				RayHit.Hit.TraceEnd = RayStart + Dir * RayLength;
+				RayHit.Hit.Time = RayHit.Hit.Distance / RayLength;
+
+				CutoffDistance = Kz::Spatial::AddSortedHit(OutHits, RayHit.Id, RayHit.Hit, MaxHits, RayLength);
+			}
+		}
+
+		return OutHits.Num();
+	}
+
+	template <typename IndexType>
+	template <typename TValidator>
+	bool TPartitionedSpatialIndex<IndexType>::Query(TArray<ElementIdType>& OutResults, const FBox& Bounds, TValidator&& Validator) const
+	{
+		for (int32 i = 0; i < Partitions.Num(); ++i)
+		{
+			const FPartition& Partition = Partitions[i];
+			if (Partition.Bounds.Intersect(Bounds))
+			{
+				Partition.Index->Query(OutResults, Bounds, Validator);
+			}
+		}
+
+		return !OutResults.IsEmpty();
+	}
+
+	template <typename IndexType>
+	template <typename TValidator>
+	bool TPartitionedSpatialIndex<IndexType>::Query(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, TValidator&& Validator) const
+	{
+		if (!Shape.IsValid())
+			return false;
+
+		const FBox QueryAABB = Shape.GetBoundingBox(ShapePosition, ShapeRotation);
+
+		for (int32 i = 0; i < Partitions.Num(); ++i)
+		{
+			const FPartition& Partition = Partitions[i];
+			if (Partition.Bounds.Intersect(QueryAABB))
+			{
+				Partition.Index->Query(OutResults, Shape, ShapePosition, ShapeRotation, Validator);
+			}
+		}
+
+		return !OutResults.IsEmpty();
+	}
+
+	template <typename IndexType>
+	template <typename TValidator>
+	bool TPartitionedSpatialIndex<IndexType>::Query(TArray<ElementIdType>& OutResults, const FKzShapeWorldCache& Shape, TValidator&& Validator) const
+	{
+		if (!Shape.IsValid())
+			return false;
+
+		for (int32 i = 0; i < Partitions.Num(); ++i)
+		{
+			const FPartition& Partition = Partitions[i];
+			if (Partition.Bounds.Intersect(Shape.Bounds))
+			{
+				Partition.Index->Query(OutResults, Shape, Validator);
+			}
+		}
+
+		return !OutResults.IsEmpty();
+	}
+
+	template <typename IndexType>
+	void TPartitionedSpatialIndex<IndexType>::DebugDraw(const UWorld* World, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
+	{
+		if (!World)
+			return;
+
+		for (int32 i = 0; i < Partitions.Num(); ++i)
+		{
+			const FPartition& Partition = Partitions[i];
+			DrawDebugBox(World, Partition.Bounds.GetCenter(), Partition.Bounds.GetExtent(), Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+			Partition.Index->DebugDraw(World, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Spatial/KzOctree.h"
+
+namespace Kz
+{
+	/**
+	 * Loose quadtree for planar content (top-down, RTS...), subdividing only the PlaneAxes pair.
+	 * A TOctree that splits along two axes: same Semantics concept and API, so both can be
+	 * swapped with a typedef. Nodes span the full extent of the remaining axis.
+	 */
+	template <typename ElementType, typename QuadtreeSemantics, EKzAxis3D PlaneAxes = EKzAxis3D::X | EKzAxis3D::Y, bool bAllowMultiNode = true, typename InAllocatorType = FDefaultAllocator>
+	using TQuadtree = TOctree<ElementType, QuadtreeSemantics, bAllowMultiNode, InAllocatorType, PlaneAxes>;
+}
\ No newline at end of file
@@ -0,0 +1,178 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Math/Box.h"
+#include "Math/VectorRegister.h"
+#include "Spatial/KzBoundsSoA.h"
+
+namespace Kz
+{
+	/**
+	 * A packet of 4, 8 or 16 coherent rays (eg. a sensor fan) traversed together through a spatial index.
+	 *
+	 * Ray origins, inverse directions and current max distances are stored as float SoA, so a single box
+	 * is tested against 4 rays per VectorRegister4Float. Ray subsets are passed around as bit masks
+	 * (bit i = ray i). The full-precision origins and directions are kept for the narrow phase.
+	 */
+	template <int32 NumRays>
+	class TRayPacket
+	{
+		static_assert(NumRays == 4 || NumRays == 8 || NumRays == 16, "Ray packets hold 4, 8 or 16 rays.");
+
+	public:
+		static constexpr int32 LaneCount = 4;
+		static constexpr int32 NumGroups = NumRays / LaneCount;
+
+		TRayPacket() { Reset(); }
+
+		/** Clears all rays. Empty slots never hit anything. */
+		void Reset()
+		{
+			for (int32 i = 0; i < NumRays; ++i)
+			{
+				OriginX[i] = OriginY[i] = OriginZ[i] = 0.0f;
+				InvDirX[i] = InvDirY[i] = InvDirZ[i] = 1.0f;
+				MaxDistance[i] = -1.0f;
+				Origins[i] = FVector::ZeroVector;
+				Dirs[i] = FVector::ZeroVector;
+			}
+			Tolerance = UE_KINDA_SMALL_NUMBER;
+		}
+
+		/**
+		 * Sets the ray stored at Index.
+		 * @param Dir          Normalized ray direction.
+		 * @param InMaxDistance Ray length.
+		 */
+		void SetRay(int32 Index, const FVector& Start, const FVector& Dir, float InMaxDistance)
+		{
+			check(Index >= 0 && Index < NumRays);
+
+			Origins[Index] = Start;
+			Dirs[Index] = Dir;
+
+			OriginX[Index] = (float)Start.X;
+			OriginY[Index] = (float)Start.Y;
+			OriginZ[Index] = (float)Start.Z;
+			InvDirX[Index] = Spatial::SafeInv(Dir.X);
+			InvDirY[Index] = Spatial::SafeInv(Dir.Y);
+			InvDirZ[Index] = Spatial::SafeInv(Dir.Z);
+			MaxDistance[Index] = InMaxDistance;
+
+			// Absorbs the float rounding of the ray origins so grazing hits are not culled.
+			Tolerance = FMath::Max(Tolerance, UE_KINDA_SMALL_NUMBER * (1.0f + (float)Start.GetAbsMax()));
+		}
+
+		const FVector& GetOrigin(int32 Index) const { return Origins[Index]; }
+		const FVector& GetDir(int32 Index) const { return Dirs[Index]; }
+
+		float GetMaxDistance(int32 Index) const { return MaxDistance[Index]; }
+
+		/** Shortens a ray, eg. after a closer hit was found, so further boxes are culled for it. */
+		void SetMaxDistance(int32 Index, float InMaxDistance) { MaxDistance[Index] = InMaxDistance; }
+
+		/**
+		 * Slab-tests a box against the rays in RayMask.
+		 *
+		 * @param Box           The box to test.
+		 * @param RayMask       Rays to test.
+		 * @param OutMinEntry   Receives the closest entry distance among the rays that hit.
+		 * @return Mask of the rays in RayMask that cross the box within their max distance.
+		 */
+		uint32 IntersectBox(const FBox& Box, uint32 RayMask, float& OutMinEntry) const
+		{
+			const VectorRegister4Float MinX = VectorSetFloat1(Spatial::RoundDown(Box.Min.X));
+			const VectorRegister4Float MinY = VectorSetFloat1(Spatial::RoundDown(Box.Min.Y));
+			const VectorRegister4Float MinZ = VectorSetFloat1(Spatial::RoundDown(Box.Min.Z));
+			const VectorRegister4Float MaxX = VectorSetFloat1(Spatial::RoundUp(Box.Max.X));
+			const VectorRegister4Float MaxY = VectorSetFloat1(Spatial::RoundUp(Box.Max.Y));
+			const VectorRegister4Float MaxZ = VectorSetFloat1(Spatial::RoundUp(Box.Max.Z));
+			const VectorRegister4Float Zero = VectorZeroFloat();
+			const VectorRegister4Float Tol = VectorSetFloat1(Tolerance);
+
+			uint32 HitMask = 0;
+			OutMinEntry = UE_BIG_NUMBER;
+
+			for (int32 Group = 0; Group < NumGroups; ++Group)
+			{
+				const int32 Shift = Group * LaneCount;
+				if (((RayMask >> Shift) & 0xF) == 0)
+				{
+					continue;
+				}
+
+				const VectorRegister4Float OX = VectorLoadAligned(OriginX + Shift);
+				const VectorRegister4Float OY = VectorLoadAligned(OriginY + Shift);
+				const VectorRegister4Float OZ = VectorLoadAligned(OriginZ + Shift);
+				const VectorRegister4Float IX = VectorLoadAligned(InvDirX + Shift);
+				const VectorRegister4Float IY = VectorLoadAligned(InvDirY + Shift);
+				const VectorRegister4Float IZ = VectorLoadAligned(InvDirZ + Shift);
+
+				VectorRegister4Float T1 = VectorMultiply(VectorSubtract(MinX, OX), IX);
+				VectorRegister4Float T2 = VectorMultiply(VectorSubtract(MaxX, OX), IX);
+				VectorRegister4Float TNear = VectorMin(T1, T2);
+				VectorRegister4Float TFar = VectorMax(T1, T2);
+
+				T1 = VectorMultiply(VectorSubtract(MinY, OY), IY);
+				T2 = VectorMultiply(VectorSubtract(MaxY, OY), IY);
+				TNear = VectorMax(TNear, VectorMin(T1, T2));
+				TFar = VectorMin(TFar, VectorMax(T1, T2));
+
+				T1 = VectorMultiply(VectorSubtract(MinZ, OZ), IZ);
+				T2 = VectorMultiply(VectorSubtract(MaxZ, OZ), IZ);
+				TNear = VectorMax(TNear, VectorMin(T1, T2));
+				TFar = VectorMin(TFar, VectorMax(T1, T2));
+
+				TNear = VectorMax(TNear, Zero);
+				TFar = VectorAdd(VectorMin(TFar, VectorLoadAligned(MaxDistance + Shift)), Tol);
+
+				const uint32 GroupMask = (uint32)VectorMaskBits(VectorCompareLE(TNear, TFar)) & ((RayMask >> Shift) & 0xF);
+				if (GroupMask == 0)
+				{
+					continue;
+				}
+
+				HitMask |= GroupMask << Shift;
+
+				alignas(16) float Entry[LaneCount];
+				VectorStoreAligned(TNear, Entry);
+				for (int32 Lane = 0; Lane < LaneCount; ++Lane)
+				{
+					if (GroupMask & (1u << Lane))
+					{
+						OutMinEntry = FMath::Min(OutMinEntry, Entry[Lane]);
+					}
+				}
+			}
+
+			return HitMask;
+		}
+
+		/** Calls Func(RayIndex) for every ray in RayMask. */
+		template <typename TFunc>
+		static void ForEachRay(uint32 RayMask, TFunc&& Func)
+		{
+			while (RayMask)
+			{
+				const int32 Index = FMath::CountTrailingZeros(RayMask);
+				RayMask &= RayMask - 1;
+				Func(Index);
+			}
+		}
+
+	private:
+		alignas(16) float OriginX[NumRays];
+		alignas(16) float OriginY[NumRays];
+		alignas(16) float OriginZ[NumRays];
+		alignas(16) float InvDirX[NumRays];
+		alignas(16) float InvDirY[NumRays];
+		alignas(16) float InvDirZ[NumRays];
+		alignas(16) float MaxDistance[NumRays];
+
+		FVector Origins[NumRays];
+		FVector Dirs[NumRays];
+
+		float Tolerance;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Box.h"
+#include "Tasks/Task.h"
+#include "Templates/SharedPointer.h"
+#include "Collision/KzHitResult.h"
+#include "Math/Geometry/KzShapeInstance.h"
+
+#include <atomic>
+
+namespace Kz
+{
+	/** Result of an async raycast. */
+	template <typename IdType>
+	struct TSpatialRaycastResult
+	{
+		/** True if any element was hit. */
+		bool bHit = false;
+
+		/** ID of the closest intersected element. Only meaningful when bHit is true. */
+		IdType Id{};
+
+		/** Geometric hit information (distance, location, normal...). */
+		FKzHitResult Hit;
+	};
+
+	/**
+	 * Handle to a spatial query running on a worker thread.
+	 *
+	 * Poll IsReady() (eg. late in the frame) and read the result in place with GetResult(), which blocks
+	 * if the query is still running. The result lives in the task, so it is never copied on delivery.
+	 * Cancel() stops the query from doing further narrow-phase work; a cancelled query returns the
+	 * results found so far, which may be incomplete.
+	 */
+	template <typename ResultType>
+	class TSpatialAsyncHandle
+	{
+	public:
+		TSpatialAsyncHandle() = default;
+
+		TSpatialAsyncHandle(UE::Tasks::TTask<ResultType>&& InTask, const TSharedRef<std::atomic<bool>>& InCancelFlag)
+			: Task(MoveTemp(InTask))
+			, CancelFlag(InCancelFlag)
+		{
+		}
+
+		/** Returns true if the handle refers to a launched query. */
+		bool IsValid() const { return Task.IsValid(); }
+
+		/** Returns true once the query finished (or was cancelled) and its result can be read without blocking. */
+		bool IsReady() const { return Task.IsCompleted(); }
+
+		/** Requests cancellation. The query stops testing elements as soon as it notices. */
+		void Cancel()
+		{
+			if (CancelFlag.IsValid())
+			{
+				CancelFlag->store(true, std::memory_order_relaxed);
+			}
+		}
+
+		/** Returns true if Cancel() was called. */
+		bool IsCancelled() const { return CancelFlag.IsValid() && CancelFlag->load(std::memory_order_relaxed); }
+
+		/** Returns the result, waiting for the query to finish if needed. */
+		ResultType& GetResult() { return Task.GetResult(); }
+
+		/** Returns the underlying task, eg. to use it as a prerequisite of other tasks. */
+		const UE::Tasks::TTask<ResultType>& GetTask() const { return Task; }
+
+	private:
+		UE::Tasks::TTask<ResultType> Task;
+		TSharedPtr<std::atomic<bool>> CancelFlag;
+	};
+
+	namespace Spatial
+	{
+		/**
+		 * Runs a query on a worker thread and returns a handle to poll or wait for its result.
+		 * QueryFunc(Index, bCancelled) runs on the worker and returns the result.
+		 */
+		template <typename ResultType, typename IndexType, typename TQueryFunc>
+		TSpatialAsyncHandle<ResultType> LaunchAsync(const TSharedRef<const IndexType>& Snapshot, TQueryFunc&& QueryFunc)
+		{
+			TSharedRef<std::atomic<bool>> CancelFlag = MakeShared<std::atomic<bool>>(false);
+
+			UE::Tasks::TTask<ResultType> Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+				[Snapshot, CancelFlag, QueryFunc = Forward<TQueryFunc>(QueryFunc)]() mutable
+				{
+					if (CancelFlag->load(std::memory_order_relaxed))
+					{
+						return ResultType();
+					}
+					return QueryFunc(*Snapshot, *CancelFlag);
+				});
+
+			return TSpatialAsyncHandle<ResultType>(MoveTemp(Task), CancelFlag);
+		}
+
+		/** Wraps a validator so cancelled queries reject every remaining element and skip their narrow phase. */
+		template <typename TValidator>
+		auto MakeCancellableValidator(TValidator& Validator, const std::atomic<bool>& bCancelled)
+		{
+			return [&Validator, &bCancelled](const auto& E)
+			{
+				return !bCancelled.load(std::memory_order_relaxed) && Validator(E);
+			};
+		}
+
+		/**
+		 * Performs a box overlap query on a worker thread.
+		 *
+		 * The query runs against Snapshot, which must not be modified until the query completes: build the next
+		 * index into another instance and swap the shared references (eg. double-buffer per frame).
+		 * The validator is invoked from a worker thread and must be thread-safe.
+		 *
+		 * @param Snapshot   Read-only index to query (TOctree, TSpatialHashGrid, TPartitionedSpatialIndex...).
+		 * @param Bounds     The box to query with.
+		 * @param Validator  Optional callable: bool(const ElementType&).
+		 */
+		template <typename IndexType, typename TValidator = decltype([](const auto&) { return true; })>
+		TSpatialAsyncHandle<TArray<typename IndexType::ElementIdType>> QueryAsync(const TSharedRef<const IndexType>& Snapshot, const FBox& Bounds, TValidator Validator = {})
+		{
+			using ResultType = TArray<typename IndexType::ElementIdType>;
+			return LaunchAsync<ResultType>(Snapshot, [Bounds, Validator](const IndexType& Index, const std::atomic<bool>& bCancelled) mutable
+			{
+				ResultType Results;
+				Index.Query(Results, Bounds, MakeCancellableValidator(Validator, bCancelled));
+				return Results;
+			});
+		}
+
+		/**
+		 * Performs a shape overlap query on a worker thread.
+		 * See QueryAsync(Snapshot, Bounds, Validator) for the threading rules.
+		 */
+		template <typename IndexType, typename TValidator = decltype([](const auto&) { return true; })>
+		TSpatialAsyncHandle<TArray<typename IndexType::ElementIdType>> QueryAsync(const TSharedRef<const IndexType>& Snapshot, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, TValidator Validator = {})
+		{
+			using ResultType = TArray<typename IndexType::ElementIdType>;
+			return LaunchAsync<ResultType>(Snapshot, [Shape, ShapePosition, ShapeRotation, Validator](const IndexType& Index, const std::atomic<bool>& bCancelled) mutable
+			{
+				ResultType Results;
+				Index.Query(Results, Shape, ShapePosition, ShapeRotation, MakeCancellableValidator(Validator, bCancelled));
+				return Results;
+			});
+		}
+
+		/**
+		 * Performs a raycast on a worker thread.
+		 * See QueryAsync(Snapshot, Bounds, Validator) for the threading rules, and TOctree::Raycast() for the parameters.
+		 */
+		template <typename IndexType, typename TValidator = decltype([](const auto&) { return true; })>
+		TSpatialAsyncHandle<TSpatialRaycastResult<typename IndexType::ElementIdType>> RaycastAsync(const TSharedRef<const IndexType>& Snapshot, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator Validator = {})
+		{
+			using ResultType = TSpatialRaycastResult<typename IndexType::ElementIdType>;
+			return LaunchAsync<ResultType>(Snapshot, [RayStart, RayDir, RayLength, Validator](const IndexType& Index, const std::atomic<bool>& bCancelled) mutable
+			{
+				ResultType Result;
+				Result.bHit = Index.Raycast(Result.Id, Result.Hit, RayStart, RayDir, RayLength, MakeCancellableValidator(Validator, bCancelled));
+				return Result;
+			});
+		}
+	}
+}
\ No newline at end of file
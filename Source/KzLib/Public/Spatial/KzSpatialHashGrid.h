@@ -4,11 +4,18 @@
 
 #include "Containers/Array.h"
 #include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "Containers/HandleArray.h"
+#include "Handles/SimpleHandle.h"
 #include "Math/Box.h"
+#include "Math/Geometry/KzShapeInstance.h"
 #include "Concepts/KzContainer.h"
+#include "Core/KzTypes.h"
+#include "Spatial/KzSpatialTypes.h"
+#include "Spatial/KzBoundsSoA.h"
 
 struct FKzHitResult;
-struct FKzShapeInstance;
+struct FKzShapeWorldCache;
 
 namespace Kz
 {
@@ -16,26 +23,74 @@ namespace Kz
 	 * Sparse spatial hash grid for broad-phase spatial queries.
 	 * Uses a TMap to store partial infinite grid cells.
 	 * Excellent for unbounded worlds or when objects are sparsely distributed.
+	 *
+	 * Cells emptied by Reset() are kept with their allocations, so rebuilding over the same
+	 * area does not hit the allocator; cells a rebuild leaves empty are erased by the next
+	 * Reset(). Cells emptied by Remove() or Update() are erased right away, trading a
+	 * reallocation when an element comes back for a map that does not grow as elements
+	 * travel. Call Trim() to release the retained memory. InAllocatorType is used for the
+	 * per-cell element arrays.
+	 *
+	 * Each cell caches the bounds of its elements at insertion time in SIMD-friendly SoA form,
+	 * so queries cull most candidates before calling into the Semantics shape or GJK.
+	 * Semantics can also expose per-element world space shape data with a static GetWorldCache()
+	 * (see TOctree).
+	 *
+	 * Large-world safe: cells are keyed by tile plus local cell (see FSpatialCellKey) and the cached
+	 * float bounds are stored relative to the tile origin, so culling keeps its precision far away
+	 * from the world origin.
+	 *
+	 * GridAxes selects the axes cells are hashed on. Hashing only two axes turns the grid into a 2D
+	 * grid for planar content (see TSpatialHashGrid2D); cells then span the whole third axis.
+	 *
+	 * Standing queries keep the set of elements overlapping a registered shape up to date as elements
+	 * are inserted, updated or removed, and report only the elements that entered or exited.
 	 */
-	template <typename ElementType, typename GridSemantics>
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType = FDefaultAllocator, EKzAxis3D GridAxes = EKzAxis3D::X | EKzAxis3D::Y | EKzAxis3D::Z>
 	class TSpatialHashGrid
 	{
-		using ElementIdType = typename GridSemantics::ElementIdType;
+		static_assert(GridAxes != EKzAxis3D::None, "TSpatialHashGrid must hash at least one axis.");
+
 		using FDefaultValidator = decltype([](const ElementType&) { return true; });
 
 	public:
+		using ElementIdType = typename GridSemantics::ElementIdType;
+		using FStandingQueryHandle = FSimpleHandle;
+
 		/** Sets the cell size of the grid. Larger cells mean broader broad-phase but more narrow-phase checks. */
 		void SetCellSize(float InCellSize) { CellSize = FMath::Max(1.0f, InCellSize); }
 
-		/** Resets the grid. */
+		/**
+		 * Resets the grid, keeping the allocated cells for the next Build(). Cells left empty by the previous
+		 * Build() are erased, so only the cells of the last build are retained. Standing queries report all
+		 * their elements as exited.
+		 */
 		void Reset()
 		{
-			for (auto& Pair : GridCells)
+			for (auto It = GridCells.CreateIterator(); It; ++It)
 			{
-				Pair.Value.Reset();
+				if (It.Value().IsEmpty())
+				{
+					It.RemoveCurrent();
+				}
+				else
+				{
+					It.Value().Reset();
+				}
+			}
+
+			for (int32 i = 0; i < StandingQueries.Num(); ++i)
+			{
+				StandingQueries[i].ExitAll();
 			}
 		}
 
+		/** Removes empty cells and releases the slack memory of the remaining ones. */
+		void Trim();
+
+		/** Returns the amount of memory allocated by the grid, including retained empty cells. */
+		SIZE_T GetAllocatedSize() const;
+
 		/** Builds the octree from any iterable container (Array, THandleArray, etc.). */
 		void Build(const CKzContainer auto& Container);
 
@@ -55,6 +110,38 @@ namespace Kz
 		 */
 		void Remove(const ElementType& Element, const FBox& PreviousBounds);
 
+		/** Moves a single element: removes it from the cells covered by PreviousBounds and inserts it again. */
+		void Update(const ElementType& Element, const FBox& PreviousBounds);
+
+		/**
+		 * Registers a standing query. The set of elements overlapping the shape is computed once and then
+		 * kept up to date as elements are inserted, updated or removed, or as the query moves, so the cost
+		 * scales with the number of changes instead of re-running the query every tick.
+		 *
+		 * @param Shape          The geometric shape definition to query with.
+		 * @param ShapePosition  World-space position of the shape.
+		 * @param ShapeRotation  World-space orientation of the shape.
+		 * @return Handle identifying the query. The initial overlaps are reported as entered.
+		 */
+		FStandingQueryHandle AddStandingQuery(const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation);
+
+		/** Unregisters a standing query. Returns false if the handle is no longer valid. */
+		bool RemoveStandingQuery(const FStandingQueryHandle& Handle);
+
+		/** Moves a standing query, updating its overlaps. */
+		void MoveStandingQuery(const FStandingQueryHandle& Handle, const FVector& ShapePosition, const FQuat& ShapeRotation);
+
+		/** Returns the elements currently overlapping a standing query, or nullptr if the handle is no longer valid. */
+		const TSet<ElementIdType>* GetStandingQueryResults(const FStandingQueryHandle& Handle) const;
+
+		/**
+		 * Retrieves the elements that entered and exited a standing query since the last call, and clears them.
+		 * Elements that exit and enter again in between (eg. moved with Update() or rebuilt) are not reported.
+		 *
+		 * @return true if anything entered or exited.
+		 */
+		bool ConsumeStandingQueryChanges(const FStandingQueryHandle& Handle, TArray<ElementIdType>& OutEntered, TArray<ElementIdType>& OutExited);
+
 		/**
 		 * Performs a raycast through the grid using fast voxel traversal (DDA).
 		 * 
@@ -71,6 +158,43 @@ namespace Kz
 		template <typename TValidator = FDefaultValidator>
 		bool Raycast(ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator = {}) const;
 
+		/**
+		 * Collects every element crossed by the ray, sorted by distance (eg. penetrating weapons or ray sensors).
+		 * When MaxHits > 0, only the MaxHits closest hits are kept and the traversal stops as soon as
+		 * no closer hit can be found.
+		 *
+		 * @param OutHits       Receives the hits, sorted by ascending distance. Use TSpatialRayHitArray to keep them inline.
+		 * @param RayStart      Ray world-space start position.
+		 * @param RayDir        Ray direction (does not need to be normalized).
+		 * @param RayLength     Ray length. <= 0 means infinite.
+		 * @param MaxHits       Maximum number of hits to keep. <= 0 means unlimited.
+		 * @param Validator     Optional callable: bool(const ElementType&)
+		 * @return Number of hits written.
+		 */
+		template <typename AllocatorType, typename TValidator = FDefaultValidator>
+		int32 RaycastMulti(TArray<TSpatialRayHit<ElementIdType>, AllocatorType>& OutHits, const FVector& RayStart, const FVector& RayDir, float RayLength, int32 MaxHits = 0, TValidator&& Validator = {}) const;
+
+		/**
+		 * Checks whether any element blocks the ray segment (eg. line-of-sight or shadow checks).
+		 * Stops at the first confirmed hit instead of searching for the closest one, and computes no hit details.
+		 *
+		 * @param OutId         Receives the ID of a blocking element (not necessarily the closest).
+		 * @param RayStart      Ray world-space start position.
+		 * @param RayDir        Ray direction (does not need to be normalized).
+		 * @param RayLength     Ray length. <= 0 means infinite.
+		 * @param Validator     Optional callable: bool(const ElementType&)
+		 * @return true if any element was hit; false otherwise.
+		 */
+		template <typename TValidator = FDefaultValidator>
+		bool RaycastAny(ElementIdType& OutId, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator = {}) const;
+
+		/**
+		 * Returns true if no element blocks the segment between From and To.
+		 * Shorthand for RaycastAny() along the segment.
+		 */
+		template <typename TValidator = FDefaultValidator>
+		bool LineOfSight(const FVector& From, const FVector& To, TValidator&& Validator = {}) const;
+
 		/**
 		 * Performs an overlap query using a box.
 		 *
@@ -93,6 +217,16 @@ namespace Kz
 		template <typename TValidator = FDefaultValidator>
 		bool Query(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, TValidator&& Validator = {}) const;
 
+		/**
+		 * Performs an overlap query using a cached world space shape, whose cached bounds select the cells.
+		 *
+		 * @param OutResults     Array receiving IDs of overlapping elements.
+		 * @param Shape          The placed shape to query with.
+		 * @param Validator      Optional callable: bool(const ElementType&).
+		 */
+		template <typename TValidator = FDefaultValidator>
+		bool Query(TArray<ElementIdType>& OutResults, const FKzShapeWorldCache& Shape, TValidator&& Validator = {}) const;
+
 		/**
 		 * Draws a debug visualization.
 		 *
@@ -106,15 +240,138 @@ namespace Kz
 		void DebugDraw(const class UWorld* World, FColor const& Color, bool bPersistentLines = false, float LifeTime = -1.f, uint8 DepthPriority = 0, float Thickness = 0.f) const;
 
 	private:
-		static uint64 GetCellKey(int64 X, int64 Y, int64 Z);
+		/**
+		 * Walks the cells crossed by a ray front-to-back (DDA) and calls VisitCell(const FCell&) on every existing cell.
+		 * Stops when VisitCell returns false or the next cell starts beyond MaxDistance, which is re-read after each cell.
+		 */
+		template <typename TFunc>
+		void TraverseRay(const FVector& RayStart, const FVector& Dir, const float& MaxDistance, TFunc&& VisitCell) const;
+
+		/** Returns true if cells are hashed along Axis (0 = X, 1 = Y, 2 = Z). */
+		static constexpr bool IsGridAxis(int32 Axis) { return ((uint8)GridAxes & (1 << Axis)) != 0; }
+
+		static FSpatialCellKey GetCellKey(int64 X, int64 Y, int64 Z);
 		static FInt64Vector GetCellCoord(const FVector& Pos, float CellSize);
 
-		static FKzShapeInstance GetElementShape(const ElementType& E);
+		/** Shape query over the cells overlapping QueryAABB, the world bounds of the shape. */
+		template <typename TValidator>
+		bool QueryShape(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FBox& QueryAABB, TValidator&& Validator) const;
+
+		/** Returns the Semantics shape of an element (an instance or an FKzShapeValue), or its bounding sphere as a value. */
+		static decltype(auto) GetElementShape(const ElementType& E);
 		static FQuat GetElementRotation(const ElementType& E);
 
-		TMap<uint64, TArray<ElementType>> GridCells;
+		/** Raycasts a single element, through its world cache when the Semantics provide one. */
+		static bool RaycastElement(FKzHitResult& OutHit, const ElementType& E, const FVector& RayStart, const FVector& RayDir, float RayLength);
+
+		/** Returns true if a ray touches a single element, without computing the hit data. */
+		static bool RaycastElementTest(const ElementType& E, const FVector& RayStart, const FVector& RayDir, float RayLength);
+
+		/** Tests a shape against a single element, through its world cache when the Semantics provide one. */
+		static bool IntersectElement(const ElementType& E, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation);
+
+		/** A grid cell: its elements plus their bounds, cached at insertion time for SIMD culling. */
+		struct FCell
+		{
+			TArray<ElementType, InAllocatorType> Elements;
+			TBoundsSoA<InAllocatorType> Bounds; // Relative to Origin.
+			FVector Origin = FVector::ZeroVector; // Origin of the tile containing the cell.
+
+			int32 Num() const { return Elements.Num(); }
+			bool IsEmpty() const { return Elements.IsEmpty(); }
+
+			void Add(const ElementType& E, const FBox& ElemBounds)
+			{
+				Elements.Add(E);
+				Bounds.Add(ElemBounds.ShiftBy(-Origin));
+			}
+
+			void RemoveAtSwap(int32 Index)
+			{
+				Elements.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+				Bounds.RemoveAtSwap(Index);
+			}
+
+			void Reset()
+			{
+				Elements.Reset();
+				Bounds.Reset();
+			}
+
+			void Shrink()
+			{
+				Elements.Shrink();
+				Bounds.Shrink();
+			}
+
+			SIZE_T GetAllocatedSize() const { return Elements.GetAllocatedSize() + Bounds.GetAllocatedSize(); }
+		};
+
+		/** A registered standing query: its shape, current overlaps and pending changes. */
+		struct FStandingQuery
+		{
+			FKzShapeInstance Shape;
+			FVector Position = FVector::ZeroVector;
+			FQuat Rotation = FQuat::Identity;
+			FBox Bounds = FBox(ForceInitToZero);
+
+			TSet<ElementIdType> Results;
+			TSet<ElementIdType> Entered;
+			TSet<ElementIdType> Exited;
+
+			void Enter(const ElementIdType& Id)
+			{
+				bool bAlreadyIn = false;
+				Results.Add(Id, &bAlreadyIn);
+
+				// Entering again after a pending exit cancels both.
+				if (!bAlreadyIn && Exited.Remove(Id) == 0)
+				{
+					Entered.Add(Id);
+				}
+			}
+
+			void Exit(const ElementIdType& Id)
+			{
+				if (Results.Remove(Id) > 0 && Entered.Remove(Id) == 0)
+				{
+					Exited.Add(Id);
+				}
+			}
+
+			void ExitAll()
+			{
+				for (const ElementIdType& Id : Results)
+				{
+					if (Entered.Remove(Id) == 0)
+					{
+						Exited.Add(Id);
+					}
+				}
+				Results.Reset();
+			}
+		};
+
+		/** Tests a newly inserted element against the standing queries. */
+		void NotifyInserted(const ElementType& E, const FBox& Bounds);
+
+		/** Removes an element from the results of the standing queries. */
+		void NotifyRemoved(const ElementIdType& Id);
+
+		TMap<FSpatialCellKey, FCell> GridCells;
+		THandleArray<FStandingQuery, FStandingQueryHandle> StandingQueries;
 		float CellSize = 100.0f;
 	};
 }
 
-#include "Spatial/KzSpatialHashGrid.inl"
\ No newline at end of file
+#include "Spatial/KzSpatialHashGrid.inl"
+
+namespace Kz
+{
+	/**
+	 * Sparse 2D hash grid for planar content (top-down, RTS...), hashing only the PlaneAxes pair.
+	 * Same API as TSpatialHashGrid, so both can be swapped with a typedef.
+	 */
+	template <typename ElementType, typename GridSemantics, EKzAxis3D PlaneAxes = EKzAxis3D::X | EKzAxis3D::Y, typename InAllocatorType = FDefaultAllocator>
+	using TSpatialHashGrid2D = TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, PlaneAxes>;
+}
\ No newline at end of file
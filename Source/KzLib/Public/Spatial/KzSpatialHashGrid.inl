@@ -5,15 +5,18 @@
 #include "Collision/KzHitResult.h"
 #include "Collision/KzRaycast.h"
 #include "Collision/KzGJK.h"
+#include "Collision/KzOverlap.h"
 #include "Math/Geometry/KzShapeInstance.h"
+#include "Math/Geometry/KzShapeValue.h"
+#include "Math/Geometry/KzShapeWorldCache.h"
 #include "Math/Geometry/Shapes/KzSphere.h"
 
 #include "DrawDebugHelpers.h"
 
 namespace Kz
 {
-	template <typename ElementType, typename GridSemantics>
-	void TSpatialHashGrid<ElementType, GridSemantics>::Build(const CKzContainer auto& Container)
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::Build(const CKzContainer auto& Container)
 	{
 		Reset();
 
@@ -27,8 +30,38 @@ namespace Kz
 		}
 	}
 
-	template <typename ElementType, typename GridSemantics>
-	void TSpatialHashGrid<ElementType, GridSemantics>::Insert(const ElementType& E)
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::Trim()
+	{
+		for (auto It = GridCells.CreateIterator(); It; ++It)
+		{
+			if (It.Value().IsEmpty())
+			{
+				It.RemoveCurrent();
+			}
+			else
+			{
+				It.Value().Shrink();
+			}
+		}
+
+		GridCells.Compact();
+		GridCells.Shrink();
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	SIZE_T TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::GetAllocatedSize() const
+	{
+		SIZE_T Size = GridCells.GetAllocatedSize();
+		for (const auto& Pair : GridCells)
+		{
+			Size += Pair.Value.GetAllocatedSize();
+		}
+		return Size;
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::Insert(const ElementType& E)
 	{
 		const FBox Bounds = GridSemantics::GetBoundingBox(E);
 		const FInt64Vector Min = GetCellCoord(Bounds.Min, CellSize);
@@ -40,15 +73,22 @@ namespace Kz
 			{
 				for (int64 z = Min.Z; z <= Max.Z; ++z)
 				{
-					uint64 Key = GetCellKey(x, y, z);
-					GridCells.FindOrAdd(Key).Add(E);
+					const FSpatialCellKey Key = GetCellKey(x, y, z);
+					FCell& Cell = GridCells.FindOrAdd(Key);
+					if (Cell.IsEmpty())
+					{
+						Cell.Origin = Key.GetTileOrigin(CellSize);
+					}
+					Cell.Add(E, Bounds);
 				}
 			}
 		}
+
+		NotifyInserted(E, Bounds);
 	}
 
-	template <typename ElementType, typename GridSemantics>
-	void TSpatialHashGrid<ElementType, GridSemantics>::Remove(const ElementType& E)
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::Remove(const ElementType& E)
 	{
 		if (!GridSemantics::IsValid(E)) return;
 
@@ -57,20 +97,25 @@ namespace Kz
 		// Brute force iteration over all map buckets
 		for (auto It = GridCells.CreateIterator(); It; ++It)
 		{
-			TArray<ElementType>& Cell = It.Value();
+			FCell& Cell = It.Value();
+			if (Cell.IsEmpty())
+			{
+				continue; // Retained by Reset() for the next Build().
+			}
+
 			bool bFoundInCell = false;
 
 			for (int32 i = 0; i < Cell.Num(); ++i)
 			{
-				if (GridSemantics::GetElementId(Cell[i]) == IdToRemove)
+				if (GridSemantics::GetElementId(Cell.Elements[i]) == IdToRemove)
 				{
-					Cell.RemoveAtSwap(i, 1, false);
+					Cell.RemoveAtSwap(i);
 					bFoundInCell = true;
 					break; // Found in this cell, move to next
 				}
 			}
 
-			// Clean up empty buckets to keep map size manageable
+			// Erase emptied cells, so elements moving across the world do not grow the map.
 			if (Cell.IsEmpty())
 			{
 				It.RemoveCurrent();
@@ -79,10 +124,12 @@ namespace Kz
 			// Note: We DO NOT break the outer loop (It) because the object 
 			// likely exists in multiple cells. We must check them all.
 		}
+
+		NotifyRemoved(IdToRemove);
 	}
 
-	template <typename ElementType, typename GridSemantics>
-	void TSpatialHashGrid<ElementType, GridSemantics>::Remove(const ElementType& E, const FBox& PreviousBounds)
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::Remove(const ElementType& E, const FBox& PreviousBounds)
 	{
 		// To remove efficiently, we look only in the cells covered by the Old Bounds.
 		const FInt64Vector Min = GetCellCoord(PreviousBounds.Min, CellSize);
@@ -96,20 +143,19 @@ namespace Kz
 			{
 				for (int64 z = Min.Z; z <= Max.Z; ++z)
 				{
-					uint64 Key = GetCellKey(x, y, z);
-					if (TArray<ElementType>* Cell = GridCells.Find(Key))
+					const FSpatialCellKey Key = GetCellKey(x, y, z);
+					if (FCell* Cell = GridCells.Find(Key); Cell && !Cell->IsEmpty())
 					{
 						// Find element by ID in this cell and remove it
 						for (int32 i = 0; i < Cell->Num(); ++i)
 						{
-							if (GridSemantics::GetElementId((*Cell)[i]) == IdToRemove)
+							if (GridSemantics::GetElementId(Cell->Elements[i]) == IdToRemove)
 							{
-								Cell->RemoveAtSwap(i, 1, EAllowShrinking::No);
+								Cell->RemoveAtSwap(i);
 								break; // Assuming object is only once per cell
 							}
 						}
 
-						// Clean up empty cells to save memory
 						if (Cell->IsEmpty())
 						{
 							GridCells.Remove(Key);
@@ -118,11 +164,121 @@ namespace Kz
 				}
 			}
 		}
+
+		NotifyRemoved(IdToRemove);
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::Update(const ElementType& E, const FBox& PreviousBounds)
+	{
+		Remove(E, PreviousBounds);
+		Insert(E);
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	typename TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::FStandingQueryHandle TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::AddStandingQuery(const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation)
+	{
+		FStandingQuery NewQuery;
+		NewQuery.Shape = Shape;
+
+		const FStandingQueryHandle Handle = StandingQueries.Add(NewQuery);
+		MoveStandingQuery(Handle, ShapePosition, ShapeRotation);
+		return Handle;
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::RemoveStandingQuery(const FStandingQueryHandle& Handle)
+	{
+		return StandingQueries.Remove(Handle);
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::MoveStandingQuery(const FStandingQueryHandle& Handle, const FVector& ShapePosition, const FQuat& ShapeRotation)
+	{
+		FStandingQuery* StandingQuery = StandingQueries.Find(Handle);
+		if (!StandingQuery)
+			return;
+
+		StandingQuery->Position = ShapePosition;
+		StandingQuery->Rotation = ShapeRotation;
+		StandingQuery->Bounds = StandingQuery->Shape.GetBoundingBox(ShapePosition, ShapeRotation);
+
+		TArray<ElementIdType> Overlaps;
+		if (StandingQuery->Shape.IsValid())
+		{
+			Query(Overlaps, StandingQuery->Shape, ShapePosition, ShapeRotation);
+		}
+
+		// Diff the new overlaps against the previous ones.
+		const TSet<ElementIdType> NewResults(Overlaps);
+		for (const ElementIdType& Id : StandingQuery->Results.Difference(NewResults))
+		{
+			StandingQuery->Exit(Id);
+		}
+		for (const ElementIdType& Id : Overlaps)
+		{
+			StandingQuery->Enter(Id);
+		}
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	const TSet<typename TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::ElementIdType>* TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::GetStandingQueryResults(const FStandingQueryHandle& Handle) const
+	{
+		const FStandingQuery* StandingQuery = StandingQueries.Find(Handle);
+		return StandingQuery ? &StandingQuery->Results : nullptr;
 	}
 
-	template <typename ElementType, typename GridSemantics>
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::ConsumeStandingQueryChanges(const FStandingQueryHandle& Handle, TArray<ElementIdType>& OutEntered, TArray<ElementIdType>& OutExited)
+	{
+		OutEntered.Reset();
+		OutExited.Reset();
+
+		FStandingQuery* StandingQuery = StandingQueries.Find(Handle);
+		if (!StandingQuery)
+			return false;
+
+		OutEntered = StandingQuery->Entered.Array();
+		OutExited = StandingQuery->Exited.Array();
+		StandingQuery->Entered.Reset();
+		StandingQuery->Exited.Reset();
+
+		return !OutEntered.IsEmpty() || !OutExited.IsEmpty();
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::NotifyInserted(const ElementType& E, const FBox& Bounds)
+	{
+		if (StandingQueries.Num() == 0 || !GridSemantics::IsValid(E))
+			return;
+
+		const ElementIdType Id = GridSemantics::GetElementId(E);
+
+		for (int32 i = 0; i < StandingQueries.Num(); ++i)
+		{
+			FStandingQuery& StandingQuery = StandingQueries[i];
+			if (!StandingQuery.Shape.IsValid() || !StandingQuery.Bounds.Intersect(Bounds))
+				continue;
+
+			if (IntersectElement(E, StandingQuery.Shape, StandingQuery.Position, StandingQuery.Rotation))
+			{
+				StandingQuery.Enter(Id);
+			}
+		}
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::NotifyRemoved(const ElementIdType& Id)
+	{
+		for (int32 i = 0; i < StandingQueries.Num(); ++i)
+		{
+			StandingQueries[i].Exit(Id);
+		}
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
 	template <typename TValidator>
-	bool TSpatialHashGrid<ElementType, GridSemantics>::Raycast(ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator) const
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::Raycast(ElementIdType& OutId, FKzHitResult& OutHit, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator) const
 	{
 		const float SizeSq = RayDir.SizeSquared();
 		if (SizeSq < UE_SMALL_NUMBER)
@@ -143,6 +299,157 @@ namespace Kz
 
 		TSet<ElementIdType> Visited;
 
+		// Cells are visited front-to-back until the next one starts beyond the closest hit.
+		float MaxDistance = RayLength;
+		TraverseRay(RayStart, Dir, MaxDistance, [&](const FCell& Cell)
+		{
+			// Only elements whose cached bounds are crossed by the ray reach GJK.
+			Cell.Bounds.ForEachRayHit(RayStart - Cell.Origin, Dir, MaxDistance, [&](int32 ElementIndex)
+			{
+				const ElementType& E = Cell.Elements[ElementIndex];
+				const ElementIdType Id = GridSemantics::GetElementId(E);
+				if (Visited.Contains(Id))
+					return;
+				Visited.Add(Id);
+
+				if (!GridSemantics::IsValid(E) || !Validator(E))
+					return;
+
+				const float MaxCheckLength = OutHit.bBlockingHit ? OutHit.Distance : RayLength;
+				const float PrevDist = OutHit.Distance;
+
+				FKzHitResult HitCandidate = OutHit;
+				if (RaycastElement(HitCandidate, E, RayStart, Dir, MaxCheckLength) && HitCandidate.Distance < PrevDist)
+				{
+					OutHit = HitCandidate;
+					OutId = Id;
+					MaxDistance = OutHit.Distance;
+				}
+			});
+
+			return true;
+		});
+
+		return OutHit.bBlockingHit;
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	template <typename AllocatorType, typename TValidator>
+	int32 TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::RaycastMulti(TArray<TSpatialRayHit<ElementIdType>, AllocatorType>& OutHits, const FVector& RayStart, const FVector& RayDir, float RayLength, int32 MaxHits, TValidator&& Validator) const
+	{
+		OutHits.Reset();
+
+		const float SizeSq = RayDir.SizeSquared();
+		if (SizeSq < UE_SMALL_NUMBER)
+			return 0;
+
+		FVector Dir = RayDir;
+		if (!FMath::IsNearlyEqual(SizeSq, 1.0f))
+		{
+			Dir *= FMath::InvSqrt(SizeSq);
+		}
+
+		if (RayLength <= 0.0f)
+			RayLength = UE_BIG_NUMBER;
+
+		TSet<ElementIdType> Visited;
+
+		// Shrinks to the farthest kept hit once MaxHits hits are found, which ends the traversal early.
+		float CutoffDistance = RayLength;
+		TraverseRay(RayStart, Dir, CutoffDistance, [&](const FCell& Cell)
+		{
+			Cell.Bounds.ForEachRayHit(RayStart - Cell.Origin, Dir, CutoffDistance, [&](int32 ElementIndex)
+			{
+				const ElementType& E = Cell.Elements[ElementIndex];
+				const ElementIdType Id = GridSemantics::GetElementId(E);
+				if (Visited.Contains(Id))
+					return;
+				Visited.Add(Id);
+
+				if (!GridSemantics::IsValid(E) || !Validator(E))
+					return;
+
+				// Test against the full ray so Time stays relative to RayLength for every hit.
+				FKzHitResult Hit;
+				if (RaycastElement(Hit, E, RayStart, Dir, RayLength) && Hit.Distance <= CutoffDistance)
+				{
+					CutoffDistance = Kz::Spatial::AddSortedHit(OutHits, Id, Hit, MaxHits, RayLength);
+				}
+			});
+
+			return true;
+		});
+
+		return OutHits.Num();
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	template <typename TValidator>
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::RaycastAny(ElementIdType& OutId, const FVector& RayStart, const FVector& RayDir, float RayLength, TValidator&& Validator) const
+	{
+		const float SizeSq = RayDir.SizeSquared();
+		if (SizeSq < UE_SMALL_NUMBER)
+			return false;
+
+		FVector Dir = RayDir;
+		if (!FMath::IsNearlyEqual(SizeSq, 1.0f))
+		{
+			Dir *= FMath::InvSqrt(SizeSq);
+		}
+
+		if (RayLength <= 0.0f)
+			RayLength = UE_BIG_NUMBER;
+
+		TSet<ElementIdType> Visited;
+		bool bBlocked = false;
+
+		TraverseRay(RayStart, Dir, RayLength, [&](const FCell& Cell)
+		{
+			// First confirmed hit ends both the cell and the grid traversal.
+			Cell.Bounds.ForEachRayHit(RayStart - Cell.Origin, Dir, RayLength, [&](int32 ElementIndex)
+			{
+				const ElementType& E = Cell.Elements[ElementIndex];
+				const ElementIdType Id = GridSemantics::GetElementId(E);
+				if (Visited.Contains(Id))
+					return true;
+				Visited.Add(Id);
+
+				if (!GridSemantics::IsValid(E) || !Validator(E))
+					return true;
+
+				if (RaycastElementTest(E, RayStart, Dir, RayLength))
+				{
+					OutId = Id;
+					bBlocked = true;
+					return false;
+				}
+
+				return true;
+			});
+
+			return !bBlocked;
+		});
+
+		return bBlocked;
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	template <typename TValidator>
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::LineOfSight(const FVector& From, const FVector& To, TValidator&& Validator) const
+	{
+		const FVector Delta = To - From;
+		const float Length = Delta.Size();
+		if (Length < UE_KINDA_SMALL_NUMBER)
+			return true;
+
+		ElementIdType BlockingId;
+		return !RaycastAny(BlockingId, From, Delta / Length, Length, Forward<TValidator>(Validator));
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	template <typename TFunc>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::TraverseRay(const FVector& RayStart, const FVector& Dir, const float& MaxDistance, TFunc&& VisitCell) const
+	{
 		// DDA / Grid Traversal
 		FInt64Vector Current = GetCellCoord(RayStart, CellSize);
 
@@ -151,16 +458,25 @@ namespace Kz
 		int64 StepY = (Dir.Y >= 0) ? 1 : -1;
 		int64 StepZ = (Dir.Z >= 0) ? 1 : -1;
 
-		float tMaxX = (Dir.X != 0) ? ((Current.X + (StepX > 0 ? 1 : 0)) * CellSize - RayStart.X) / Dir.X : UE_BIG_NUMBER;
-		float tMaxY = (Dir.Y != 0) ? ((Current.Y + (StepY > 0 ? 1 : 0)) * CellSize - RayStart.Y) / Dir.Y : UE_BIG_NUMBER;
-		float tMaxZ = (Dir.Z != 0) ? ((Current.Z + (StepZ > 0 ? 1 : 0)) * CellSize - RayStart.Z) / Dir.Z : UE_BIG_NUMBER;
+		// Axes that are not hashed (2D grids) never change cell.
+		if (!IsGridAxis(0)) { StepX = 0; }
+		if (!IsGridAxis(1)) { StepY = 0; }
+		if (!IsGridAxis(2)) { StepZ = 0; }
+
+		// Cell boundaries are computed in double so they stay exact far from the origin; only ray distances are float.
+		float tMaxX = (StepX != 0 && Dir.X != 0) ? ((double)(Current.X + (StepX > 0 ? 1 : 0)) * CellSize - RayStart.X) / Dir.X : UE_BIG_NUMBER;
+		float tMaxY = (StepY != 0 && Dir.Y != 0) ? ((double)(Current.Y + (StepY > 0 ? 1 : 0)) * CellSize - RayStart.Y) / Dir.Y : UE_BIG_NUMBER;
+		float tMaxZ = (StepZ != 0 && Dir.Z != 0) ? ((double)(Current.Z + (StepZ > 0 ? 1 : 0)) * CellSize - RayStart.Z) / Dir.Z : UE_BIG_NUMBER;
 
 		// Correct tDelta calculation: it's distance along ray to cross one CellSize in that dimension
-		float tDeltaX = (Dir.X != 0) ? CellSize / FMath::Abs(Dir.X) : UE_BIG_NUMBER;
-		float tDeltaY = (Dir.Y != 0) ? CellSize / FMath::Abs(Dir.Y) : UE_BIG_NUMBER;
-		float tDeltaZ = (Dir.Z != 0) ? CellSize / FMath::Abs(Dir.Z) : UE_BIG_NUMBER;
+		float tDeltaX = (StepX != 0 && Dir.X != 0) ? CellSize / FMath::Abs(Dir.X) : UE_BIG_NUMBER;
+		float tDeltaY = (StepY != 0 && Dir.Y != 0) ? CellSize / FMath::Abs(Dir.Y) : UE_BIG_NUMBER;
+		float tDeltaZ = (StepZ != 0 && Dir.Z != 0) ? CellSize / FMath::Abs(Dir.Z) : UE_BIG_NUMBER;
+
+		// Rays along a non-hashed axis (eg. vertical rays in an XY grid) stay in their starting cell.
+		const bool bCanStep = tMaxX < UE_BIG_NUMBER || tMaxY < UE_BIG_NUMBER || tMaxZ < UE_BIG_NUMBER;
 
-		const float LimitDist = RayLength;
+		const float LimitDist = MaxDistance;
 		float CurrentDist = 0.0f;
 
 		// Limit iterations to prevent infinite loops in bad cases
@@ -168,37 +484,20 @@ namespace Kz
 
 		while (CurrentDist <= LimitDist && MaxSteps-- > 0)
 		{
-			uint64 Key = GetCellKey(Current.X, Current.Y, Current.Z);
-			const TArray<ElementType>* Cell = GridCells.Find(Key);
-
-			if (Cell)
+			const FSpatialCellKey Key = GetCellKey(Current.X, Current.Y, Current.Z);
+			if (const FCell* Cell = GridCells.Find(Key))
 			{
-				for (const ElementType& E : *Cell)
+				if (!VisitCell(*Cell))
 				{
-					const ElementIdType Id = GridSemantics::GetElementId(E);
-					if (Visited.Contains(Id))
-						continue;
-					Visited.Add(Id);
-
-					if (!GridSemantics::IsValid(E) || !Validator(E))
-						continue;
-
-					const FKzShapeInstance ElemShape = GetElementShape(E);
-					const FVector ElemPos = GridSemantics::GetElementPosition(E);
-					const FQuat ElemRot = GetElementRotation(E);
-
-					const float MaxCheckLength = OutHit.bBlockingHit ? OutHit.Distance : RayLength;
-					const float PrevDist = OutHit.Distance;
-
-					FKzHitResult HitCandidate = OutHit;
-					if (Kz::GJK::Raycast(HitCandidate, RayStart, Dir, MaxCheckLength, ElemShape, ElemPos, ElemRot) && HitCandidate.Distance < PrevDist)
-					{
-						OutHit = HitCandidate;
-						OutId = Id;
-					}
+					break;
 				}
 			}
 
+			if (!bCanStep)
+			{
+				break;
+			}
+
 			// If we found a hit, check if we can stop.
 			// Ideally we stop if CurrentDist > OutHit.Distance.
 			// But since objects are larger than cells, we might find a hit in Cell A
@@ -208,11 +507,11 @@ namespace Kz
 			// (overlaps bound). But we insert objects into ALL cells they overlap. So
 			// if geometry is in Cell B, the object IS in Cell B. So if we find a hit,
 			// we must ensure we process all cells up to the hit distance.
-			if (OutHit.bBlockingHit && OutHit.Distance < CurrentDist)
+			if (MaxDistance < CurrentDist)
 			{
 				break;
 			}
-			float const NewLimit = OutHit.bBlockingHit ? OutHit.Distance : RayLength;
+			float const NewLimit = MaxDistance;
 
 			// Advance to next voxel
 			if (tMaxX < tMaxY)
@@ -254,13 +553,11 @@ namespace Kz
 				}
 			}
 		}
-
-		return OutHit.bBlockingHit;
 	}
 
-	template <typename ElementType, typename GridSemantics>
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
 	template <typename TValidator>
-	bool TSpatialHashGrid<ElementType, GridSemantics>::Query(TArray<ElementIdType>& OutResults, const FBox& Bounds, TValidator&& Validator) const
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::Query(TArray<ElementIdType>& OutResults, const FBox& Bounds, TValidator&& Validator) const
 	{
 		TSet<ElementIdType> Visited;
 
@@ -273,26 +570,28 @@ namespace Kz
 			{
 				for (int64 z = Min.Z; z <= Max.Z; ++z)
 				{
-					uint64 Key = GetCellKey(x, y, z);
-					const TArray<ElementType>* Cell = GridCells.Find(Key);
+					const FSpatialCellKey Key = GetCellKey(x, y, z);
+					const FCell* Cell = GridCells.Find(Key);
 					if (!Cell)
 						continue;
 
-					for (const ElementType& E : *Cell)
+					// Cached float bounds are conservative, survivors are confirmed against the exact bounds.
+					Cell->Bounds.ForEachOverlap(Bounds.ShiftBy(-Cell->Origin), [&](int32 ElementIndex)
 					{
+						const ElementType& E = Cell->Elements[ElementIndex];
 						const ElementIdType Id = GridSemantics::GetElementId(E);
 						if (Visited.Contains(Id))
-							continue;
+							return;
 						Visited.Add(Id);
 
 						if (!GridSemantics::IsValid(E) || !Validator(E))
-							continue;
+							return;
 
 						if (Bounds.Intersect(GridSemantics::GetBoundingBox(E)))
 						{
 							OutResults.Add(Id);
 						}
-					}
+					});
 				}
 			}
 		}
@@ -300,14 +599,31 @@ namespace Kz
 		return !OutResults.IsEmpty();
 	}
 
-	template <typename ElementType, typename GridSemantics>
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
 	template <typename TValidator>
-	bool TSpatialHashGrid<ElementType, GridSemantics>::Query(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, TValidator&& Validator) const
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::Query(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, TValidator&& Validator) const
 	{
 		const FBox QueryAABB = Shape.GetBoundingBox(ShapePosition, ShapeRotation);
 		if (!QueryAABB.IsValid)
 			return false;
 
+		return QueryShape(OutResults, Shape, ShapePosition, ShapeRotation, QueryAABB, Forward<TValidator>(Validator));
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	template <typename TValidator>
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::Query(TArray<ElementIdType>& OutResults, const FKzShapeWorldCache& Shape, TValidator&& Validator) const
+	{
+		if (!Shape.IsValid())
+			return false;
+
+		return QueryShape(OutResults, Shape.Shape, Shape.Position, Shape.Rotation, Shape.Bounds, Forward<TValidator>(Validator));
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	template <typename TValidator>
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::QueryShape(TArray<ElementIdType>& OutResults, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation, const FBox& QueryAABB, TValidator&& Validator) const
+	{
 		TSet<ElementIdType> Visited;
 		const FInt64Vector Min = GetCellCoord(QueryAABB.Min, CellSize);
 		const FInt64Vector Max = GetCellCoord(QueryAABB.Max, CellSize);
@@ -318,32 +634,28 @@ namespace Kz
 			{
 				for (int64 z = Min.Z; z <= Max.Z; ++z)
 				{
-					uint64 Key = GetCellKey(x, y, z);
-					const TArray<ElementType>* Cell = GridCells.Find(Key);
+					const FSpatialCellKey Key = GetCellKey(x, y, z);
+					const FCell* Cell = GridCells.Find(Key);
 					if (!Cell)
 						continue;
 
-					for (const ElementType& E : *Cell)
+					// Only elements whose cached bounds overlap the query AABB reach GJK.
+					Cell->Bounds.ForEachOverlap(QueryAABB.ShiftBy(-Cell->Origin), [&](int32 ElementIndex)
 					{
+						const ElementType& E = Cell->Elements[ElementIndex];
 						const ElementIdType Id = GridSemantics::GetElementId(E);
 						if (Visited.Contains(Id))
-							continue;
+							return;
 						Visited.Add(Id);
 
 						if (!GridSemantics::IsValid(E) || !Validator(E))
-							continue;
-						if (!QueryAABB.Intersect(GridSemantics::GetBoundingBox(E)))
-							continue;
+							return;
 
-						const FKzShapeInstance ElemShape = GetElementShape(E);
-						const FVector ElemPos = GridSemantics::GetElementPosition(E);
-						const FQuat ElemRot = GetElementRotation(E);
-
-						if (Kz::GJK::Intersect(Shape, ShapePosition, ShapeRotation, ElemShape, ElemPos, ElemRot))
+						if (IntersectElement(E, Shape, ShapePosition, ShapeRotation))
 						{
 							OutResults.Add(Id);
 						}
-					}
+					});
 				}
 			}
 		}
@@ -351,66 +663,56 @@ namespace Kz
 		return !OutResults.IsEmpty();
 	}
 
-	template <typename ElementType, typename GridSemantics>
-	void TSpatialHashGrid<ElementType, GridSemantics>::DebugDraw(const UWorld* World, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	void TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::DebugDraw(const UWorld* World, FColor const& Color, bool bPersistentLines, float LifeTime, uint8 DepthPriority, float Thickness) const
 	{
 		if (!World)
 			return;
 
-		for (const auto& [Key, Elements] : GridCells)
+		for (const auto& [Key, Cell] : GridCells)
 		{
-			if (Elements.IsEmpty())
+			if (Cell.IsEmpty())
 				continue;
 
-			// Decode Key
-			// 21 bits per component.
-			// Need to handle sign extension since we packed int64 into uint64 bits.
-			// Logic: We packed as (Value + Offset) to be positive, OR we just mask bits
-			// and treat as signed 21-bit int.
-			int64 x = (Key) & 0x1FFFFF;
-			int64 y = (Key >> 21) & 0x1FFFFF;
-			int64 z = (Key >> 42) & 0x1FFFFF;
-
-			// Restore sign (21st bit is sign bit equivalent in 2's complement if we just masked, effectively)
-			if (x & 0x100000) x |= 0xFFFFFFFFFFE00000;
-			if (y & 0x100000) y |= 0xFFFFFFFFFFE00000;
-			if (z & 0x100000) z |= 0xFFFFFFFFFFE00000;
-
-			FVector Center((float)x * CellSize + CellSize * 0.5f,
-										 (float)y * CellSize + CellSize * 0.5f,
-										 (float)z * CellSize + CellSize * 0.5f);
+			const FInt64Vector Coord = Key.GetCellCoord();
+
+			FVector Center((double)Coord.X * CellSize + CellSize * 0.5f,
+										 (double)Coord.Y * CellSize + CellSize * 0.5f,
+										 (double)Coord.Z * CellSize + CellSize * 0.5f);
 			FVector Extent(CellSize * 0.5f);
 
+			// 2D grids: draw flat cells on the plane through the origin.
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (!IsGridAxis(Axis))
+				{
+					Center[Axis] = 0.0;
+					Extent[Axis] = 0.0;
+				}
+			}
+
 			DrawDebugBox(World, Center, Extent, Color, bPersistentLines, LifeTime, DepthPriority, Thickness);
 		}
 	}
 
 	// Helpers
-	template <typename ElementType, typename GridSemantics>
-	uint64 TSpatialHashGrid<ElementType, GridSemantics>::GetCellKey(int64 X, int64 Y, int64 Z)
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	FSpatialCellKey TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::GetCellKey(int64 X, int64 Y, int64 Z)
 	{
-		// Packed Key for reversibility (21 bits per axis)
-		// Mask to 21 bits: 0x1FFFFF
-		// Support range approx +/- 1 million cells.
-		// If CellSize=100cm (1m), cover +/- 1000km. Sufficient.
-
-		uint64 kX = (uint64)(X & 0x1FFFFF);
-		uint64 kY = (uint64)(Y & 0x1FFFFF);
-		uint64 kZ = (uint64)(Z & 0x1FFFFF);
-
-		return kX | (kY << 21) | (kZ << 42);
+		return FSpatialCellKey(FInt64Vector(X, Y, Z));
 	}
 
-	template <typename ElementType, typename GridSemantics>
-	FInt64Vector TSpatialHashGrid<ElementType, GridSemantics>::GetCellCoord(const FVector& Pos, float CellSize)
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	FInt64Vector TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::GetCellCoord(const FVector& Pos, float CellSize)
 	{
-		return FInt64Vector{ (int64)FMath::FloorToInt(Pos.X / CellSize),
-												 (int64)FMath::FloorToInt(Pos.Y / CellSize),
-												 (int64)FMath::FloorToInt(Pos.Z / CellSize) };
+		// Axes that are not hashed (2D grids) always map to cell 0.
+		return FInt64Vector{ IsGridAxis(0) ? FMath::FloorToInt64(Pos.X / CellSize) : 0,
+												 IsGridAxis(1) ? FMath::FloorToInt64(Pos.Y / CellSize) : 0,
+												 IsGridAxis(2) ? FMath::FloorToInt64(Pos.Z / CellSize) : 0 };
 	}
 
-	template <typename ElementType, typename GridSemantics>
-	FKzShapeInstance TSpatialHashGrid<ElementType, GridSemantics>::GetElementShape(const ElementType& E)
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	decltype(auto) TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::GetElementShape(const ElementType& E)
 	{
 		if constexpr (requires { GridSemantics::GetShape(E); })
 		{
@@ -420,12 +722,12 @@ namespace Kz
 		{
 			// Fallback: use bounding sphere derived from bounding box.
 			const FBox B = GridSemantics::GetBoundingBox(E);
-			return FKzShapeInstance::Make<FKzSphere>(B.GetExtent().GetAbsMax());
+			return FKzShapeValue(FKzSphere(B.GetExtent().GetAbsMax()));
 		}
 	}
 
-	template <typename ElementType, typename GridSemantics>
-	FQuat TSpatialHashGrid<ElementType, GridSemantics>::GetElementRotation(const ElementType& E)
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	FQuat TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::GetElementRotation(const ElementType& E)
 	{
 		if constexpr (requires { GridSemantics::GetElementRotation(E); })
 		{
@@ -436,4 +738,44 @@ namespace Kz
 			return FQuat::Identity;
 		}
 	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::RaycastElement(FKzHitResult& OutHit, const ElementType& E, const FVector& RayStart, const FVector& RayDir, float RayLength)
+	{
+		if constexpr (requires { GridSemantics::GetWorldCache(E); })
+		{
+			return Kz::GJK::Raycast(OutHit, RayStart, RayDir, RayLength, GridSemantics::GetWorldCache(E));
+		}
+		else
+		{
+			return Kz::GJK::Raycast(OutHit, RayStart, RayDir, RayLength, GetElementShape(E), GridSemantics::GetElementPosition(E), GetElementRotation(E));
+		}
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::RaycastElementTest(const ElementType& E, const FVector& RayStart, const FVector& RayDir, float RayLength)
+	{
+		if constexpr (requires { GridSemantics::GetWorldCache(E); })
+		{
+			return Kz::GJK::RaycastTest(RayStart, RayDir, RayLength, GridSemantics::GetWorldCache(E));
+		}
+		else
+		{
+			return Kz::GJK::RaycastTest(RayStart, RayDir, RayLength, GetElementShape(E), GridSemantics::GetElementPosition(E), GetElementRotation(E));
+		}
+	}
+
+	template <typename ElementType, typename GridSemantics, typename InAllocatorType, EKzAxis3D GridAxes>
+	bool TSpatialHashGrid<ElementType, GridSemantics, InAllocatorType, GridAxes>::IntersectElement(const ElementType& E, const FKzShapeInstance& Shape, const FVector& ShapePosition, const FQuat& ShapeRotation)
+	{
+		if constexpr (requires { GridSemantics::GetWorldCache(E); })
+		{
+			const FKzShapeWorldCache& Cache = GridSemantics::GetWorldCache(E);
+			return Kz::Overlap::Intersect(Shape, ShapePosition, ShapeRotation, Cache.Shape, Cache.Position, Cache.Rotation);
+		}
+		else
+		{
+			return Kz::Overlap::Intersect(Shape, ShapePosition, ShapeRotation, GetElementShape(E), GridSemantics::GetElementPosition(E), GetElementRotation(E));
+		}
+	}
 }
\ No newline at end of file
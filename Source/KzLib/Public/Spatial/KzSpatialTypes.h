@@ -0,0 +1,221 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Set.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Math/IntVector.h"
+#include "Collision/KzHitResult.h"
+
+namespace Kz
+{
+	/**
+	 * Flattened results of a batched spatial query.
+	 * The IDs found by query i are stored in Ids[Offsets[i], Offsets[i + 1]).
+	 */
+	template <typename IdType>
+	struct TSpatialBatchResult
+	{
+		/** Start index into Ids for every query, followed by a trailing end offset. */
+		TArray<int32> Offsets;
+
+		/** IDs found by all queries, concatenated in query order. */
+		TArray<IdType> Ids;
+
+		/** Returns the number of queries stored in this result. */
+		int32 NumQueries() const { return FMath::Max(0, Offsets.Num() - 1); }
+
+		/** Returns the IDs found by the given query. */
+		TConstArrayView<IdType> GetResults(int32 QueryIndex) const
+		{
+			const int32 Start = Offsets[QueryIndex];
+			return TConstArrayView<IdType>(Ids.GetData() + Start, Offsets[QueryIndex + 1] - Start);
+		}
+
+		/** Clears the results while keeping the allocated memory. */
+		void Reset()
+		{
+			Offsets.Reset();
+			Ids.Reset();
+		}
+	};
+
+	/**
+	 * Key of a sparse grid cell, split into the tile containing the cell and the cell's coordinate inside that tile.
+	 *
+	 * Tiles are CellsPerTile^3 cells. The tile is stored as 32 bits per axis and the local cell as 8 bits per axis,
+	 * so keys are unique over +/- 2^39 cells per axis, past the large world bounds even with 1 unit cells, instead
+	 * of aliasing past ~1 million cells like a single 64-bit packed cell coordinate. Cells beyond that range are
+	 * clamped into the border tiles rather than wrapped, so they only share keys with other far out cells.
+	 */
+	struct FSpatialCellKey
+	{
+		static constexpr int32 TileBits = 8;
+		static constexpr int64 CellsPerTile = int64(1) << TileBits;
+		static constexpr int64 MaxTileCoord = MAX_int32;
+
+		FIntVector Tile = FIntVector::ZeroValue;
+		uint32 LocalCell = 0;
+
+		FSpatialCellKey() = default;
+
+		explicit FSpatialCellKey(const FInt64Vector& Cell)
+		{
+			auto ClampTile = [](int64 Coord) { return int32(FMath::Clamp<int64>(Coord >> TileBits, -MaxTileCoord, MaxTileCoord)); };
+			Tile = FIntVector(ClampTile(Cell.X), ClampTile(Cell.Y), ClampTile(Cell.Z));
+
+			const int64 LocalMask = CellsPerTile - 1;
+			LocalCell = uint32(Cell.X & LocalMask) | (uint32(Cell.Y & LocalMask) << TileBits) | (uint32(Cell.Z & LocalMask) << (2 * TileBits));
+		}
+
+		/** Returns the coordinate of the tile, in tiles. */
+		FInt64Vector GetTileCoord() const
+		{
+			return FInt64Vector(Tile.X, Tile.Y, Tile.Z);
+		}
+
+		/** Returns the coordinate of the cell, in cells. */
+		FInt64Vector GetCellCoord() const
+		{
+			const int64 LocalMask = CellsPerTile - 1;
+			return FInt64Vector(
+				int64(Tile.X) * CellsPerTile + (LocalCell & LocalMask),
+				int64(Tile.Y) * CellsPerTile + ((LocalCell >> TileBits) & LocalMask),
+				int64(Tile.Z) * CellsPerTile + ((LocalCell >> (2 * TileBits)) & LocalMask));
+		}
+
+		/** Returns the world position of the tile's minimum corner. */
+		FVector GetTileOrigin(double CellSize) const
+		{
+			const double TileSize = CellsPerTile * CellSize;
+			return FVector(Tile.X * TileSize, Tile.Y * TileSize, Tile.Z * TileSize);
+		}
+
+		bool operator==(const FSpatialCellKey& Other) const { return Tile == Other.Tile && LocalCell == Other.LocalCell; }
+		bool operator!=(const FSpatialCellKey& Other) const { return !(*this == Other); }
+
+		friend uint32 GetTypeHash(const FSpatialCellKey& Key)
+		{
+			return HashCombineFast(::GetTypeHash(Key.Tile), ::GetTypeHash(Key.LocalCell));
+		}
+	};
+
+	/** A single element hit by a multi-hit raycast. */
+	template <typename IdType>
+	struct TSpatialRayHit
+	{
+		/** ID of the intersected element. */
+		IdType Id;
+
+		/** Geometric hit information (distance, location, normal...). */
+		FKzHitResult Hit;
+	};
+
+	/** Distance-sorted hits of a multi-hit raycast. The first NumInline hits are stored without heap allocations. */
+	template <typename IdType, int32 NumInline = 8>
+	using TSpatialRayHitArray = TArray<TSpatialRayHit<IdType>, TInlineAllocator<NumInline>>;
+
+	namespace Spatial
+	{
+		/**
+		 * Inserts a hit into a list kept sorted by distance.
+		 * When MaxHits > 0 the list is capped and the farthest hit is dropped.
+		 *
+		 * @return Distance beyond which new hits can no longer enter the list:
+		 *         the farthest kept hit once the list is full, RayLength otherwise.
+		 */
+		template <typename IdType, typename AllocatorType>
+		float AddSortedHit(TArray<TSpatialRayHit<IdType>, AllocatorType>& Hits, const IdType& Id, const FKzHitResult& Hit, int32 MaxHits, float RayLength)
+		{
+			const bool bFull = MaxHits > 0 && Hits.Num() >= MaxHits;
+			if (!bFull || Hit.Distance < Hits.Last().Hit.Distance)
+			{
+				// Upper bound keeps hits at equal distance in discovery order.
+				const int32 Index = Algo::UpperBoundBy(Hits, Hit.Distance, [](const TSpatialRayHit<IdType>& H) { return H.Hit.Distance; });
+				Hits.Insert(TSpatialRayHit<IdType>{ Id, Hit }, Index);
+
+				if (MaxHits > 0 && Hits.Num() > MaxHits)
+				{
+					Hits.Pop(EAllowShrinking::No);
+				}
+			}
+
+			return (MaxHits > 0 && Hits.Num() >= MaxHits) ? Hits.Last().Hit.Distance : RayLength;
+		}
+
+		/**
+		 * Number of queries processed by each batch task.
+		 * Fixed so the output layout never depends on the number of worker threads.
+		 */
+		inline constexpr int32 BatchChunkSize = 32;
+
+		/**
+		 * Runs NumQueries independent queries across worker threads and flattens their results.
+		 *
+		 * QueryFunc is called as QueryFunc(QueryIndex, OutIds, Visited) and must append the IDs found
+		 * by that query to OutIds. Visited is an empty scratch set it may use for deduplication.
+		 * Queries are grouped in fixed-size chunks and concatenated in query order, so the output is
+		 * deterministic regardless of scheduling.
+		 */
+		template <typename IdType, typename TQueryFunc>
+		void ParallelQueryBatch(TSpatialBatchResult<IdType>& OutResults, int32 NumQueries, TQueryFunc&& QueryFunc)
+		{
+			OutResults.Reset();
+			OutResults.Offsets.SetNumUninitialized(NumQueries + 1);
+			OutResults.Offsets[0] = 0;
+
+			if (NumQueries <= 0)
+			{
+				return;
+			}
+
+			const int32 NumChunks = FMath::DivideAndRoundUp(NumQueries, BatchChunkSize);
+
+			TArray<TArray<IdType>> ChunkIds;
+			ChunkIds.SetNum(NumChunks);
+
+			ParallelFor(NumChunks, [&](int32 ChunkIndex)
+			{
+				TArray<IdType>& Ids = ChunkIds[ChunkIndex];
+				TSet<IdType> Visited;
+
+				const int32 First = ChunkIndex * BatchChunkSize;
+				const int32 Last = FMath::Min(First + BatchChunkSize, NumQueries);
+
+				for (int32 QueryIndex = First; QueryIndex < Last; ++QueryIndex)
+				{
+					Visited.Reset();
+					QueryFunc(QueryIndex, Ids, Visited);
+
+					// Chunk-relative end offset, rebased below.
+					OutResults.Offsets[QueryIndex + 1] = Ids.Num();
+				}
+			});
+
+			int32 TotalIds = 0;
+			for (const TArray<IdType>& Ids : ChunkIds)
+			{
+				TotalIds += Ids.Num();
+			}
+			OutResults.Ids.Reserve(TotalIds);
+
+			// Concatenate chunks in order and turn chunk-relative offsets into global ones.
+			for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+			{
+				const int32 Base = OutResults.Ids.Num();
+				const int32 First = ChunkIndex * BatchChunkSize;
+				const int32 Last = FMath::Min(First + BatchChunkSize, NumQueries);
+
+				for (int32 QueryIndex = First; QueryIndex < Last; ++QueryIndex)
+				{
+					OutResults.Offsets[QueryIndex + 1] += Base;
+				}
+
+				OutResults.Ids.Append(ChunkIds[ChunkIndex]);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+// Copyright 2026 kirzo
+
+using UnrealBuildTool;
+
+public class KzLibLandscape : ModuleRules
+{
+	public KzLibLandscape(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"KzLib"
+			}
+			);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"CoreUObject",
+				"Engine",
+				"Landscape"
+			}
+			);
+	}
+}
\ No newline at end of file
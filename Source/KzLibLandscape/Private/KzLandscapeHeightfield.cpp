@@ -0,0 +1,35 @@
+// Copyright 2026 kirzo
+
+#include "KzLandscapeHeightfield.h"
+#include "LandscapeProxy.h"
+#include "LandscapeDataAccess.h"
+
+namespace Kz::Landscape
+{
+	FKzHeightfield MakeHeightfield(const ALandscapeProxy& Landscape, FTransform& OutTransform)
+	{
+		const FTransform LandscapeTransform = Landscape.GetActorTransform();
+		const FIntRect Rect = Landscape.GetBoundingRect();
+
+		const int32 NumX = Rect.Width() + 1;
+		const int32 NumY = Rect.Height() + 1;
+
+		// Sample the collision heights at every landscape vertex, and encode them back the way the landscape does.
+		TArray<uint16> Heights;
+		Heights.SetNumUninitialized(NumX * NumY);
+		for (int32 Y = 0; Y < NumY; ++Y)
+		{
+			for (int32 X = 0; X < NumX; ++X)
+			{
+				const FVector Sample = LandscapeTransform.TransformPosition(FVector(Rect.Min.X + X, Rect.Min.Y + Y, 0.0));
+				const TOptional<float> Height = Landscape.GetHeightAtLocation(Sample);
+
+				const double LocalZ = Height.IsSet() ? LandscapeTransform.InverseTransformPosition(FVector(Sample.X, Sample.Y, Height.GetValue())).Z : 0.0;
+				Heights[Y * NumX + X] = (uint16)FMath::Clamp(FMath::RoundToInt32(LocalZ * LANDSCAPE_INV_ZSCALE) + FKzHeightfield::HeightOffset, 0, MAX_uint16);
+			}
+		}
+
+		OutTransform = FTransform(LandscapeTransform.GetRotation(), LandscapeTransform.TransformPosition(FVector(Rect.Min.X, Rect.Min.Y, 0.0)));
+		return FKzHeightfield(NumX, NumY, MoveTemp(Heights), LandscapeTransform.GetScale3D() * FVector(1.0, 1.0, LANDSCAPE_ZSCALE));
+	}
+}
\ No newline at end of file
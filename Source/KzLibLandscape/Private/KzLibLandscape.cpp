@@ -0,0 +1,17 @@
+// Copyright 2026 kirzo
+
+#include "KzLibLandscape.h"
+
+#define LOCTEXT_NAMESPACE "FKzLibLandscapeModule"
+
+void FKzLibLandscapeModule::StartupModule()
+{
+}
+
+void FKzLibLandscapeModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+	
+IMPLEMENT_MODULE(FKzLibLandscapeModule, KzLibLandscape)
\ No newline at end of file
@@ -0,0 +1,16 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Math/Geometry/Shapes/KzHeightfield.h"
+
+class ALandscapeProxy;
+
+namespace Kz::Landscape
+{
+	/**
+	 * Samples the heights of a landscape, at its collision resolution.
+	 * @param OutTransform  Where to place the heightfield to match the landscape. Scale is folded into GridScale.
+	 */
+	KZLIBLANDSCAPE_API FKzHeightfield MakeHeightfield(const ALandscapeProxy& Landscape, FTransform& OutTransform);
+}
\ No newline at end of file
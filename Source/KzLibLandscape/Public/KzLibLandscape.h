@@ -0,0 +1,15 @@
+// Copyright 2026 kirzo
+
+#pragma once
+
+#include "Modules/ModuleManager.h"
+
+/** Landscape importers for KzLib shapes, kept out of KzLib so it does not depend on the Landscape module. */
+class FKzLibLandscapeModule : public IModuleInterface
+{
+public:
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};
\ No newline at end of file